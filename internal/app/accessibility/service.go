@@ -1,8 +1,11 @@
 package accessibility
 
 import (
+	"context"
 	"fmt"
 	"image"
+	"sync"
+	"time"
 
 	"github.com/y3owk1n/neru/internal/config"
 	"github.com/y3owk1n/neru/internal/domain"
@@ -74,24 +77,96 @@ func (s *Service) IsFocusedAppExcluded() bool {
 	return false
 }
 
-// CollectElements collects UI elements based on the current mode.
-func (s *Service) CollectElements() []*infra.TreeNode {
-	// Pre-allocate with estimated capacity (typical screen has 50-200 elements)
-	elements := make([]*infra.TreeNode, 0, 128)
+// IsFocusedAppQuarantined reports whether the focused application timed out so often
+// recently that it is only scanned shallowly.
+func (s *Service) IsFocusedAppQuarantined() bool {
+	app := infra.GetFocusedApplication()
+	if app == nil {
+		return false
+	}
+	defer app.Release()
+	return infra.IsQuarantined(app.GetPID())
+}
 
-	// Check if Mission Control is active - affects what we can scan
-	missionControlActive := infra.IsMissionControlActive()
+// BeginActivation opens the ownership scope for the accessibility elements of one mode
+// activation. Elements collected afterwards stay valid until EndActivation.
+func (s *Service) BeginActivation() {
+	infra.BeginScope()
+}
 
-	clickableElements := s.collectClickableElements(missionControlActive)
-	if len(clickableElements) > 0 {
-		elements = append(elements, clickableElements...)
-	}
+// EndActivation releases every accessibility element collected since BeginActivation.
+func (s *Service) EndActivation() {
+	infra.EndScope()
+}
 
-	elements = s.addSupplementaryElements(elements, missionControlActive)
+// Prefetch walks the focused application's frontmost window in the background with its
+// clickable roles, so the next activation can skip the walk.
+func (s *Service) Prefetch(ctx context.Context) {
+	s.UpdateRolesForCurrentApp()
 
+	start := time.Now()
+	err := infra.PrefetchClickableElements(ctx)
+	if err != nil {
+		s.logger.Debug("Prefetch skipped", zap.Error(err))
+		return
+	}
+	s.logger.Debug("Prefetch done", zap.Duration("duration", time.Since(start)))
+}
+
+// CollectElements collects UI elements based on the current mode.
+// It waits for every source; use StreamElements to receive elements as they are found.
+func (s *Service) CollectElements() []*infra.TreeNode {
+	elements := make([]*infra.TreeNode, 0, collectCapacity)
+	for element := range s.StreamElements(context.Background()) {
+		elements = append(elements, element)
+	}
 	return elements
 }
 
+// StreamElements collects UI elements based on the current mode and sends them as they are
+// found. Independent sources (frontmost window, menubar, Dock, Notification Center) live in
+// different processes, so they are queried in parallel; the frontmost window is walked
+// progressively, the other sources are sent once complete. Element order across sources is
+// not fixed. The channel is closed when every source is done or ctx is cancelled.
+func (s *Service) StreamElements(ctx context.Context) <-chan *infra.TreeNode {
+	out := make(chan *infra.TreeNode, streamBufferSize)
+
+	// Check if Mission Control is active - affects what we can scan
+	missionControlActive := infra.IsMissionControlActive()
+	sources := s.elementSources(missionControlActive)
+
+	go func() {
+		defer close(out)
+
+		var waitGroup sync.WaitGroup
+		for _, source := range sources {
+			waitGroup.Add(1)
+			go func() {
+				defer waitGroup.Done()
+
+				start := time.Now()
+				count := source.collect(ctx, out)
+				s.logger.Debug("Collected element source",
+					zap.String("source", source.name),
+					zap.Int("count", count),
+					zap.Duration("duration", time.Since(start)),
+					zap.Bool("cancelled", ctx.Err() != nil))
+			}()
+		}
+		waitGroup.Wait()
+
+		cacheStats := infra.GetCacheStats()
+		s.logger.Debug("Element info cache stats",
+			zap.Uint64("hits", cacheStats.Hits),
+			zap.Uint64("misses", cacheStats.Misses),
+			zap.Float64("hit_rate", cacheStats.HitRate()),
+			zap.Int("entries", cacheStats.Entries),
+			zap.Int("partitions", cacheStats.Partitions))
+	}()
+
+	return out
+}
+
 // PerformActionAtPoint executes the specified action at the given point.
 func (s *Service) PerformActionAtPoint(action string, pt image.Point) error {
 	actionName := domain.ActionName(action)
@@ -111,122 +186,128 @@ func (s *Service) PerformActionAtPoint(action string, pt image.Point) error {
 	}
 }
 
-// collectClickableElements collects clickable elements from the frontmost window.
-func (s *Service) collectClickableElements(missionControlActive bool) []*infra.TreeNode {
-	if missionControlActive {
-		s.logger.Info("Mission Control is active, skipping frontmost window clickable elements")
-		return nil
-	}
-
-	s.logger.Info("Scanning for clickable elements")
-	roles := infra.GetClickableRoles()
-	s.logger.Debug("Clickable roles", zap.Strings("roles", roles))
-
-	clickableElements, err := infra.GetClickableElements()
-	if err != nil {
-		s.logger.Error("Failed to get clickable elements", zap.Error(err))
-		return nil
-	}
+const (
+	// collectCapacity is the initial capacity for collected elements.
+	collectCapacity = 256
+	// streamBufferSize lets sources run ahead of a consumer that renders in batches.
+	streamBufferSize = 256
+)
 
-	s.logger.Info("Found clickable elements", zap.Int("count", len(clickableElements)))
-	return clickableElements
+// elementSource is one independently queried origin of hint elements.
+// collect sends the source's elements to out and returns how many it sent.
+type elementSource struct {
+	name    string
+	collect func(ctx context.Context, out chan<- *infra.TreeNode) int
 }
 
-// addSupplementaryElements adds menubar, dock, and notification center elements.
-func (s *Service) addSupplementaryElements(
-	elements []*infra.TreeNode,
-	missionControlActive bool,
-) []*infra.TreeNode {
-	if !missionControlActive {
-		elements = s.addMenubarElements(elements)
-	} else {
-		s.logger.Info("Mission Control is active, skipping menubar elements")
+// completeSource adapts a source that returns all of its elements at once.
+func completeSource(name string, collect func() []*infra.TreeNode) elementSource {
+	return elementSource{
+		name: name,
+		collect: func(ctx context.Context, out chan<- *infra.TreeNode) int {
+			elements := collect()
+			for index, element := range elements {
+				select {
+				case out <- element:
+				case <-ctx.Done():
+					return index
+				}
+			}
+			return len(elements)
+		},
 	}
+}
 
-	elements = s.addDockElements(elements)
+// elementSources lists the sources to query for the current state, in merge order.
+func (s *Service) elementSources(missionControlActive bool) []elementSource {
+	sources := make([]elementSource, 0, 4+len(s.config.Hints.AdditionalMenubarHintsTargets))
 
-	// Notification Center elements (only when Mission Control is active)
 	if missionControlActive {
-		elements = s.addNotificationCenterElements(elements)
+		s.logger.Info("Mission Control is active, skipping frontmost window clickable elements")
+	} else {
+		sources = append(sources, elementSource{
+			name:    "frontmost_window",
+			collect: s.streamClickableElements,
+		})
 	}
 
-	return elements
-}
-
-// addMenubarElements adds menubar clickable elements.
-func (s *Service) addMenubarElements(elements []*infra.TreeNode) []*infra.TreeNode {
-	if !s.config.Hints.IncludeMenubarHints {
-		return elements
+	if s.config.Hints.IncludeMenubarHints {
+		if missionControlActive {
+			s.logger.Info("Mission Control is active, skipping menubar elements")
+		} else {
+			s.logger.Info("Adding menubar elements")
+			sources = append(sources, completeSource("menubar", s.collectMenubarElements))
+			for _, bundleID := range s.config.Hints.AdditionalMenubarHintsTargets {
+				sources = append(sources, completeSource(bundleID, func() []*infra.TreeNode {
+					return s.collectBundleElements(bundleID, "additional menubar")
+				}))
+			}
+		}
 	}
 
-	s.logger.Info("Adding menubar elements")
-
-	var mbElems []*infra.TreeNode
-	var err error
-	mbElems, err = infra.GetMenuBarClickableElements()
-	if err == nil {
-		elements = append(elements, mbElems...)
-		s.logger.Debug("Included menubar elements", zap.Int("count", len(mbElems)))
-	} else {
-		s.logger.Warn("Failed to get menubar elements", zap.Error(err))
+	if s.config.Hints.IncludeDockHints {
+		sources = append(sources, completeSource(domain.BundleIDDock, func() []*infra.TreeNode {
+			return s.collectBundleElements(domain.BundleIDDock, "dock")
+		}))
 	}
-	for _, bundleID := range s.config.Hints.AdditionalMenubarHintsTargets {
-		var additionalElems []*infra.TreeNode
-		var err error
-		additionalElems, err = infra.GetClickableElementsFromBundleID(bundleID)
-		if err == nil {
-			elements = append(elements, additionalElems...)
-			s.logger.Debug("Included additional menubar elements",
-				zap.String("bundle_id", bundleID),
-				zap.Int("count", len(additionalElems)))
-		} else {
-			s.logger.Warn("Failed to get additional menubar elements",
-				zap.String("bundle_id", bundleID),
-				zap.Error(err))
-		}
+
+	// Notification Center elements (only when Mission Control is active)
+	if missionControlActive && s.config.Hints.IncludeNCHints {
+		s.logger.Info("Adding notification center elements")
+		sources = append(sources, completeSource(
+			domain.BundleIDNotificationCenter,
+			func() []*infra.TreeNode {
+				return s.collectBundleElements(
+					domain.BundleIDNotificationCenter,
+					"notification center",
+				)
+			},
+		))
 	}
 
-	return elements
+	return sources
 }
 
-// addDockElements adds dock clickable elements.
-func (s *Service) addDockElements(elements []*infra.TreeNode) []*infra.TreeNode {
-	if !s.config.Hints.IncludeDockHints {
-		return elements
-	}
+// streamClickableElements streams clickable elements from the frontmost window.
+func (s *Service) streamClickableElements(ctx context.Context, out chan<- *infra.TreeNode) int {
+	s.logger.Info("Scanning for clickable elements")
+	roles := infra.GetClickableRoles()
+	s.logger.Debug("Clickable roles", zap.Strings("roles", roles))
 
-	var dockElems []*infra.TreeNode
-	var err error
-	dockElems, err = infra.GetClickableElementsFromBundleID(domain.BundleIDDock)
-	if err == nil {
-		elements = append(elements, dockElems...)
-		s.logger.Debug("Included dock elements", zap.Int("count", len(dockElems)))
-	} else {
-		s.logger.Warn("Failed to get dock elements", zap.Error(err))
+	count, err := infra.StreamClickableElements(ctx, out)
+	if err != nil && ctx.Err() == nil {
+		s.logger.Error("Failed to get clickable elements", zap.Error(err))
+		return count
 	}
 
-	return elements
+	s.logger.Info("Found clickable elements", zap.Int("count", count))
+	return count
 }
 
-// addNotificationCenterElements adds notification center clickable elements.
-func (s *Service) addNotificationCenterElements(
-	elements []*infra.TreeNode,
-) []*infra.TreeNode {
-	if !s.config.Hints.IncludeNCHints {
-		return elements
+// collectMenubarElements collects clickable elements from the focused app's menubar.
+func (s *Service) collectMenubarElements() []*infra.TreeNode {
+	mbElems, err := infra.GetMenuBarClickableElements()
+	if err != nil {
+		s.logger.Warn("Failed to get menubar elements", zap.Error(err))
+		return nil
 	}
 
-	s.logger.Info("Adding notification center elements")
+	s.logger.Debug("Included menubar elements", zap.Int("count", len(mbElems)))
+	return mbElems
+}
 
-	var ncElems []*infra.TreeNode
-	var err error
-	ncElems, err = infra.GetClickableElementsFromBundleID(domain.BundleIDNotificationCenter)
-	if err == nil {
-		elements = append(elements, ncElems...)
-		s.logger.Debug("Included notification center elements", zap.Int("count", len(ncElems)))
-	} else {
-		s.logger.Warn("Failed to get notification center elements", zap.Error(err))
+// collectBundleElements collects clickable elements from the application with the given bundle ID.
+func (s *Service) collectBundleElements(bundleID, kind string) []*infra.TreeNode {
+	elems, err := infra.GetClickableElementsFromBundleID(bundleID)
+	if err != nil {
+		s.logger.Warn("Failed to get "+kind+" elements",
+			zap.String("bundle_id", bundleID),
+			zap.Error(err))
+		return nil
 	}
 
-	return elements
+	s.logger.Debug("Included "+kind+" elements",
+		zap.String("bundle_id", bundleID),
+		zap.Int("count", len(elems)))
+	return elems
 }
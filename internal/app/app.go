@@ -2,6 +2,7 @@ package app
 
 import (
 	"fmt"
+	"sync/atomic"
 
 	"github.com/y3owk1n/neru/internal/app/accessibility"
 	"github.com/y3owk1n/neru/internal/app/components"
@@ -62,6 +63,9 @@ type App struct {
 
 	// Command handlers
 	cmdHandlers map[string]func(ipc.Command) ipc.Response
+
+	// prefetchGeneration counts app activations, so a delayed prefetch can tell it is stale
+	prefetchGeneration atomic.Uint64
 }
 
 // New creates a new App instance.
@@ -221,6 +225,11 @@ func (a *App) ReloadConfig(configPath string) error {
 			zap.Int("count", len(result.Config.Hints.ClickableRoles)))
 		infra.SetClickableRoles(result.Config.Hints.ClickableRoles)
 	}
+	infra.SetIncrementalTree(result.Config.Hints.Enabled && result.Config.Hints.IncrementalTree)
+	infra.SetSubtreePruning(result.Config.Hints.Enabled && result.Config.Hints.LearnedPruning)
+	infra.SetSourceCache(result.Config.Hints.Enabled && result.Config.Hints.SourceCache)
+	infra.SetClickSignatures(result.Config.Hints.Enabled && result.Config.Hints.LearnClicks)
+	infra.SetPrefetchMaxAge(prefetchMaxAge(result.Config))
 
 	// Reconfigure event tap hotkeys with new config
 	a.configureEventTapHotkeys(result.Config, a.logger)
@@ -32,6 +32,7 @@ func createHintsComponent(
 
 	// Always initialize generator to prevent nil pointer dereferences
 	component.Generator = hints.NewGenerator(hintChars)
+	component.Generator.SetVariableLength(cfg.Hints.VariableLengthLabels)
 
 	// Only initialize full component if hints are enabled
 	if !cfg.Hints.Enabled {
@@ -47,9 +48,15 @@ func createHintsComponent(
 		if err != nil {
 			log.Error("Failed to redraw hints", zap.Error(err))
 		}
+	}, func(changed []*hints.Hint, prefix string) {
+		if component.Overlay == nil {
+			return
+		}
+		component.Overlay.UpdateHintMatches(changed, prefix)
 	}, log)
 	component.Router = hints.NewRouter(component.Manager, log)
 	component.Context = &hints.Context{}
+	component.SetClickLearning(cfg.Hints.LearnClicks, log)
 
 	hintOverlay, err := hints.NewOverlayWithWindow(cfg.Hints, log, overlayManager.GetWindowPtr())
 	if err != nil {
@@ -2,11 +2,13 @@ package components
 
 import (
 	"strings"
+	"time"
 
 	"github.com/y3owk1n/neru/internal/config"
 	"github.com/y3owk1n/neru/internal/features/action"
 	"github.com/y3owk1n/neru/internal/features/grid"
 	"github.com/y3owk1n/neru/internal/features/hints"
+	"github.com/y3owk1n/neru/internal/features/hints/frequency"
 	"github.com/y3owk1n/neru/internal/features/scroll"
 	"go.uber.org/zap"
 )
@@ -19,10 +21,36 @@ type HintsComponent struct {
 	Router    *hints.Router
 	Context   *hints.Context
 	Style     hints.StyleMode
+	// Clicks counts selected elements per application; nil while learning is disabled.
+	Clicks *frequency.Store
+}
+
+// SetClickLearning enables or disables counting selected elements. Disabling saves what was
+// counted first.
+func (h *HintsComponent) SetClickLearning(enabled bool, log *zap.Logger) {
+	if enabled {
+		if h.Clicks == nil {
+			h.Clicks = frequency.NewStore(frequency.DefaultDir())
+		}
+		return
+	}
+
+	if h.Clicks != nil {
+		h.SaveClicks(log)
+		h.Clicks = nil
+	}
+}
+
+// SaveClicks persists the counted selections. It does nothing while learning is disabled.
+func (h *HintsComponent) SaveClicks(log *zap.Logger) {
+	err := h.Clicks.Save(time.Now())
+	if err != nil {
+		log.Warn("Failed to save click frequencies", zap.Error(err))
+	}
 }
 
 // UpdateConfig updates the hints component with new configuration.
-func (h *HintsComponent) UpdateConfig(cfg *config.Config, _ *zap.Logger) {
+func (h *HintsComponent) UpdateConfig(cfg *config.Config, log *zap.Logger) {
 	if h.Overlay != nil && cfg.Hints.Enabled {
 		h.Style = hints.BuildStyle(cfg.Hints)
 		h.Overlay.UpdateConfig(cfg.Hints)
@@ -31,6 +59,10 @@ func (h *HintsComponent) UpdateConfig(cfg *config.Config, _ *zap.Logger) {
 	if h.Generator != nil && cfg.Hints.HintCharacters != "" {
 		h.Generator.UpdateCharacters(cfg.Hints.HintCharacters)
 	}
+	if h.Generator != nil {
+		h.Generator.SetVariableLength(cfg.Hints.VariableLengthLabels)
+	}
+	h.SetClickLearning(cfg.Hints.Enabled && cfg.Hints.LearnClicks, log)
 }
 
 // GridComponent encapsulates all grid-related functionality.
@@ -4,6 +4,7 @@ import (
 	"errors"
 	"fmt"
 	"strings"
+	"time"
 
 	"github.com/y3owk1n/neru/internal/config"
 	"github.com/y3owk1n/neru/internal/domain"
@@ -66,10 +67,23 @@ func initializeAccessibility(cfg *config.Config, log *zap.Logger) error {
 			zap.Strings("roles", cfg.Hints.ClickableRoles))
 		accessibility.SetClickableRoles(cfg.Hints.ClickableRoles)
 	}
+	accessibility.SetIncrementalTree(cfg.Hints.Enabled && cfg.Hints.IncrementalTree)
+	accessibility.SetSubtreePruning(cfg.Hints.Enabled && cfg.Hints.LearnedPruning)
+	accessibility.SetSourceCache(cfg.Hints.Enabled && cfg.Hints.SourceCache)
+	accessibility.SetClickSignatures(cfg.Hints.Enabled && cfg.Hints.LearnClicks)
+	accessibility.SetPrefetchMaxAge(prefetchMaxAge(cfg))
 
 	return nil
 }
 
+// prefetchMaxAge returns how long prefetched elements are served; 0 disables prefetching.
+func prefetchMaxAge(cfg *config.Config) time.Duration {
+	if !cfg.Hints.Enabled || !cfg.Hints.Prefetch {
+		return 0
+	}
+	return time.Duration(cfg.Hints.PrefetchMaxAgeMs) * time.Millisecond
+}
+
 // initializeHotkeyService creates the hotkey service, using the provided dependency or creating a new one.
 func initializeHotkeyService(deps *deps, log *zap.Logger) hotkeyService {
 	if deps != nil && deps.Hotkeys != nil {
@@ -153,4 +167,5 @@ func (a *App) registerCommandHandlers() {
 	a.cmdHandlers[domain.CommandStatus] = a.handleStatus
 	a.cmdHandlers[domain.CommandConfig] = a.handleConfig
 	a.cmdHandlers[domain.CommandReloadConfig] = a.handleReloadConfig
+	a.cmdHandlers[domain.CommandSnapshot] = a.handleSnapshot
 }
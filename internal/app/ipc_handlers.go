@@ -76,10 +76,14 @@ func (a *App) handleHints(cmd ipc.Command) ipc.Response {
 		}
 	}
 
-	// Extract action parameter if provided
+	// Extract action parameter and refresh flag if provided
 	var action *string
-	if len(cmd.Args) > 1 {
-		action = &cmd.Args[1]
+	for index := 1; index < len(cmd.Args); index++ {
+		if cmd.Args[index] == ipc.HintsRefreshArg {
+			infra.RequestFullWalk()
+			continue
+		}
+		action = &cmd.Args[index]
 	}
 
 	a.modes.ActivateModeWithAction(domain.ModeHints, action)
@@ -181,10 +185,37 @@ func (a *App) handleIdle(_ ipc.Command) ipc.Response {
 
 func (a *App) handleStatus(_ ipc.Command) ipc.Response {
 	cfgPath := a.resolveConfigPath()
+	cacheStats := infra.GetCacheStats()
 	statusData := ipc.StatusData{
 		Enabled: a.state.IsEnabled(),
 		Mode:    domain.GetModeString(a.CurrentMode()),
 		Config:  cfgPath,
+		InfoCache: &ipc.InfoCacheStatus{
+			Hits:    cacheStats.Hits,
+			Misses:  cacheStats.Misses,
+			HitRate: cacheStats.HitRate(),
+			Entries: cacheStats.Entries,
+		},
+	}
+	for _, tuning := range infra.GetAppTunings() {
+		statusData.Apps = append(statusData.Apps, ipc.AppStatus{
+			PID:         tuning.PID,
+			BundleID:    tuning.BundleID,
+			Calls:       tuning.Calls,
+			EWMAUs:      tuning.EWMA.Microseconds(),
+			P50Us:       tuning.P50.Microseconds(),
+			P90Us:       tuning.P90.Microseconds(),
+			P99Us:       tuning.P99.Microseconds(),
+			LastNodes:   tuning.LastNodes,
+			LastDepth:   tuning.LastDepth,
+			Workers:     tuning.Workers,
+			InFlight:    tuning.InFlight,
+			MaxDepth:    tuning.MaxDepth,
+			TimeoutMs:   tuning.Timeout.Milliseconds(),
+			Timeouts:    tuning.Timeouts,
+			QuarantineS: int64(tuning.QuarantineLeft.Seconds()),
+			CappedWalks: tuning.CappedWalks,
+		})
 	}
 	return ipc.Response{Success: true, Data: statusData, Code: ipc.CodeOK}
 }
@@ -226,6 +257,43 @@ func (a *App) handleReloadConfig(_ ipc.Command) ipc.Response {
 	}
 }
 
+func (a *App) handleSnapshot(cmd ipc.Command) ipc.Response {
+	if len(cmd.Args) < 2 || !filepath.IsAbs(cmd.Args[1]) {
+		return ipc.Response{
+			Success: false,
+			Message: "snapshot path must be absolute",
+			Code:    ipc.CodeInvalidInput,
+		}
+	}
+	path := cmd.Args[1]
+
+	snap, err := infra.CaptureSnapshot()
+	if err != nil {
+		return ipc.Response{
+			Success: false,
+			Message: fmt.Sprintf("failed to capture snapshot: %v", err),
+			Code:    ipc.CodeActionFailed,
+		}
+	}
+
+	err = snap.Save(path)
+	if err != nil {
+		a.logger.Error("Failed to save snapshot", zap.Error(err), zap.String("path", path))
+		return ipc.Response{
+			Success: false,
+			Message: fmt.Sprintf("failed to save snapshot: %v", err),
+			Code:    ipc.CodeActionFailed,
+		}
+	}
+
+	return ipc.Response{
+		Success: true,
+		Message: fmt.Sprintf("snapshot of %s (%d elements) written to %s",
+			snap.BundleID, len(snap.Nodes), path),
+		Code: ipc.CodeOK,
+	}
+}
+
 // resolveConfigPath determines the configuration file path for status reporting.
 func (a *App) resolveConfigPath() string {
 	cfgPath := a.ConfigPath
@@ -1,15 +1,18 @@
 package app
 
 import (
+	"context"
 	"fmt"
 	"os"
 	"os/signal"
+	"slices"
 	"strings"
 	"syscall"
 	"time"
 
 	"github.com/getlantern/systray"
 	"github.com/y3owk1n/neru/internal/domain"
+	infra "github.com/y3owk1n/neru/internal/infra/accessibility"
 	"github.com/y3owk1n/neru/internal/infra/electron"
 	"github.com/y3owk1n/neru/internal/infra/logger"
 	"go.uber.org/zap"
@@ -41,6 +44,13 @@ func (a *App) setupAppWatcherCallbacks() {
 	a.appWatcher.OnActivate(func(_, bundleID string) {
 		a.handleAppActivation(bundleID)
 	})
+	// Launching or quitting an app changes the Dock, and quitting ends its menubar
+	a.appWatcher.OnLaunch(func(_, bundleID string) {
+		infra.InvalidateSourceCache(bundleID)
+	})
+	a.appWatcher.OnTerminate(func(_, bundleID string) {
+		infra.InvalidateSourceCache(bundleID)
+	})
 	// Watch for display parameter changes (monitor unplug/plug, resolution changes)
 	a.appWatcher.OnScreenParametersChanged(func() {
 		a.handleScreenParametersChange()
@@ -56,6 +66,8 @@ func (a *App) handleScreenParametersChange() {
 	defer func() { a.state.SetScreenChangeProcessing(false) }()
 
 	a.logger.Info("Screen parameters changed; adjusting overlays")
+	// The menubar and the Dock move with the screens
+	infra.InvalidateSourceCache("")
 	if a.overlayManager != nil {
 		a.overlayManager.ResizeToActiveScreenSync()
 	}
@@ -95,7 +107,8 @@ func (a *App) handleScreenParametersChange() {
 				a.overlayManager.ResizeToActiveScreenSync()
 			}
 
-			// Regenerate hints for current action
+			// Regenerate hints for current action; the fresh scan supersedes a streaming one
+			a.modes.CancelHintsScan()
 			a.UpdateRolesForCurrentApp()
 			elements := a.CollectElements()
 			if len(elements) > 0 {
@@ -135,11 +148,40 @@ func (a *App) handleAppActivation(bundleID string) {
 		if a.config.Hints.AdditionalAXSupport.Enable {
 			a.handleAdditionalAccessibility(bundleID)
 		}
+		if a.config.Hints.Prefetch {
+			a.schedulePrefetch(bundleID)
+		}
+		// Read the app's selection counts before hints are activated there
+		a.hintsComponent.Clicks.Preload(bundleID, time.Now())
 	}
 
 	a.logger.Debug("Done handling app activation")
 }
 
+// schedulePrefetch walks the activated application's frontmost window once it has settled,
+// so hints can skip the walk if activated soon after. The walk is dropped if another
+// application was activated meanwhile, or if a mode is active.
+func (a *App) schedulePrefetch(bundleID string) {
+	generation := a.prefetchGeneration.Add(1)
+	if a.config.IsAppExcluded(bundleID) ||
+		slices.Contains(a.config.Hints.PrefetchExcludedApps, bundleID) {
+		return
+	}
+
+	delay := time.Duration(a.config.Hints.PrefetchDelayMs) * time.Millisecond
+	time.AfterFunc(delay, func() {
+		if a.prefetchGeneration.Load() != generation || !a.state.IsEnabled() ||
+			a.state.CurrentMode() != domain.ModeIdle {
+			return
+		}
+		// The application may have lost focus without another one being activated
+		if a.accessibility.GetFocusedBundleID() != bundleID {
+			return
+		}
+		a.accessibility.Prefetch(context.Background())
+	})
+}
+
 // handleAdditionalAccessibility configures accessibility support for Electron/Chromium/Firefox applications.
 func (a *App) handleAdditionalAccessibility(bundleID string) {
 	cfg := a.config.Hints.AdditionalAXSupport
@@ -250,6 +292,10 @@ func (a *App) Cleanup() {
 		a.eventTap.Destroy()
 	}
 
+	// Keep what was learned about each app's tree and selections for the next start
+	infra.SaveSubtreePruning()
+	a.hintsComponent.SaveClicks(a.logger)
+
 	// Sync and close logger
 	err := logger.Sync()
 	if err != nil {
@@ -58,6 +58,7 @@ func (h *Handler) handleTabKey() {
 			h.Logger.Debug("Tab key disabled when action is pending")
 			return
 		}
+		h.CancelHintsScan()
 
 		if h.Hints.Context.InActionMode {
 			h.Hints.Context.SetInActionMode(false)
@@ -144,6 +145,9 @@ func (h *Handler) handleEscapeKey() {
 func (h *Handler) handleModeSpecificKey(key string) {
 	switch h.State.CurrentMode() {
 	case domain.ModeHints:
+		// Labels must stay stable once the user starts typing
+		h.CancelHintsScan()
+
 		if h.Hints.Context.InActionMode {
 			h.handleHintsActionKey(key)
 			// After handling the action, we stay in action mode.
@@ -173,6 +177,7 @@ func (h *Handler) handleModeSpecificKey(key string) {
 			}
 
 			h.Logger.Info("Found element", zap.String("label", h.Hints.Manager.GetInput()))
+			h.recordClick(hint)
 			infra.MoveMouseToPoint(center)
 
 			// Check if there's a pending action to execute
@@ -280,6 +285,8 @@ func (h *Handler) cleanupHintsMode() {
 		h.Hints.Manager.Reset()
 	}
 	h.Hints.Context.SetSelectedHint(nil)
+	h.CancelHintsScan()
+	h.Accessibility.EndActivation()
 
 	h.OverlayManager.Clear()
 	h.OverlayManager.Hide()
@@ -1,6 +1,9 @@
 package modes
 
 import (
+	"context"
+	"sync"
+
 	"github.com/y3owk1n/neru/internal/app/accessibility"
 	"github.com/y3owk1n/neru/internal/app/components"
 	"github.com/y3owk1n/neru/internal/config"
@@ -29,6 +32,10 @@ type Handler struct {
 	EnableEventTap  func()
 	DisableEventTap func()
 	RefreshHotkeys  func()
+
+	// scanMu serializes progressive hint refreshes with cancellation of the scan feeding them.
+	scanMu     sync.Mutex
+	scanCancel context.CancelFunc
 }
 
 // NewHandler creates a new mode handler.
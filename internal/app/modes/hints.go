@@ -1,8 +1,11 @@
 package modes
 
 import (
+	"context"
+	"errors"
 	"fmt"
 	"image"
+	"time"
 
 	"github.com/y3owk1n/neru/internal/domain"
 	"github.com/y3owk1n/neru/internal/features/hints"
@@ -11,6 +14,15 @@ import (
 	"go.uber.org/zap"
 )
 
+const (
+	// firstHintsBudget is how long hint mode collects elements before drawing the first hints.
+	firstHintsBudget = 50 * time.Millisecond
+	// hintsScanTimeout bounds a whole scan; elements found later are dropped.
+	hintsScanTimeout = 5 * time.Second
+	// firstHintsCapacity is the initial capacity for the first batch of elements.
+	firstHintsCapacity = 128
+)
+
 // ActivateMode activates a mode with a given action (for hints mode).
 func (h *Handler) ActivateMode(mode domain.Mode) {
 	h.ActivateModeWithAction(mode, nil)
@@ -46,6 +58,14 @@ func (h *Handler) activateHintModeInternal(preserveActionMode bool, action *stri
 		return
 	}
 
+	// Apps that keep timing out can only be scanned shallowly; grid reaches everything
+	if h.Config.Hints.SlowAppFallback == "grid" && h.Config.Grid.Enabled &&
+		h.Accessibility.IsFocusedAppQuarantined() {
+		h.Logger.Info("Focused app is slow to answer; falling back to grid mode")
+		h.activateGridModeWithAction(action)
+		return
+	}
+
 	// Prepare for mode activation (reset scroll, capture cursor)
 	h.prepareForModeActivation()
 
@@ -75,15 +95,26 @@ func (h *Handler) activateHintModeInternal(preserveActionMode bool, action *stri
 	h.State.SetHintOverlayNeedsRefresh(false)
 
 	h.Accessibility.UpdateRolesForCurrentApp()
+	h.prepareClickCounts()
+
+	// Released by cleanupHintsMode when the mode exits
+	h.Accessibility.BeginActivation()
+	scanCtx, cancelScan := h.startHintsScan()
+	stream := h.Accessibility.StreamElements(scanCtx)
 
-	elements := h.Accessibility.CollectElements()
+	elements, done := collectFirstHints(stream)
+	if done {
+		cancelScan()
+	}
 	if len(elements) == 0 {
+		cancelScan()
 		h.Logger.Warn("No elements found for action", zap.String("action", actionString))
 		return
 	}
 
 	err = h.SetupHints(elements)
 	if err != nil {
+		cancelScan()
 		h.Logger.Error("Failed to setup hints", zap.Error(err), zap.String("action", actionString))
 		return
 	}
@@ -97,6 +128,135 @@ func (h *Handler) activateHintModeInternal(preserveActionMode bool, action *stri
 	}
 
 	h.SetModeHints()
+
+	if !done {
+		go h.streamRemainingHints(scanCtx, cancelScan, stream, elements)
+	}
+}
+
+// prepareClickCounts remembers the focused application and hands the generator how often its
+// elements were selected before, while selections are counted.
+func (h *Handler) prepareClickCounts() {
+	if h.Hints.Clicks == nil {
+		h.Hints.Generator.SetClickCounts(nil)
+		return
+	}
+
+	bundleID := h.Accessibility.GetFocusedBundleID()
+	h.Hints.Context.SetBundleID(bundleID)
+	h.Hints.Generator.SetClickCounts(h.Hints.Clicks.Counts(bundleID, time.Now()))
+}
+
+// recordClick counts the selection of the hint's element in the background, so the next
+// activation can give it an easier label.
+func (h *Handler) recordClick(hint *hints.Hint) {
+	clicks := h.Hints.Clicks
+	bundleID := h.Hints.Context.GetBundleID()
+	signature := uint64(hint.Element.Signature)
+	if clicks == nil || bundleID == "" || signature == 0 {
+		return
+	}
+	go clicks.Record(bundleID, signature, time.Now())
+}
+
+// CancelHintsScan stops an in-flight progressive hint scan. Hints already drawn stay.
+func (h *Handler) CancelHintsScan() {
+	h.scanMu.Lock()
+	defer h.scanMu.Unlock()
+
+	if h.scanCancel != nil {
+		h.scanCancel()
+		h.scanCancel = nil
+	}
+}
+
+// startHintsScan cancels any previous scan and returns the context for a new one.
+func (h *Handler) startHintsScan() (context.Context, context.CancelFunc) {
+	ctx, cancel := context.WithTimeout(context.Background(), hintsScanTimeout)
+
+	h.scanMu.Lock()
+	defer h.scanMu.Unlock()
+
+	if h.scanCancel != nil {
+		h.scanCancel()
+	}
+	h.scanCancel = cancel
+
+	return ctx, cancel
+}
+
+// collectFirstHints reads streamed elements until the first-render budget has passed and at
+// least one element arrived, or until the stream ends. It reports whether the stream ended.
+func collectFirstHints(stream <-chan *infra.TreeNode) ([]*infra.TreeNode, bool) {
+	elements := make([]*infra.TreeNode, 0, firstHintsCapacity)
+
+	budget := time.NewTimer(firstHintsBudget)
+	defer budget.Stop()
+
+	expired := false
+	for !expired || len(elements) == 0 {
+		select {
+		case element, ok := <-stream:
+			if !ok {
+				return elements, true
+			}
+			elements = append(elements, element)
+		case <-budget.C:
+			expired = true
+		}
+	}
+
+	return elements, false
+}
+
+// streamRemainingHints keeps reading the scan after the first hints were drawn and redraws
+// the hints once with every element when the scan settles, so labels change at most once
+// while the user reads them. Typing cancels the scan, which keeps the drawn labels.
+func (h *Handler) streamRemainingHints(
+	ctx context.Context,
+	cancel context.CancelFunc,
+	stream <-chan *infra.TreeNode,
+	elements []*infra.TreeNode,
+) {
+	defer cancel()
+
+	shown := len(elements)
+collect:
+	for {
+		select {
+		case element, ok := <-stream:
+			if !ok {
+				break collect
+			}
+			elements = append(elements, element)
+		case <-ctx.Done():
+			break collect
+		}
+	}
+
+	if len(elements) > shown {
+		h.refreshStreamedHints(ctx, elements)
+	}
+}
+
+// refreshStreamedHints redraws hints for all elements the settled scan streamed. Nothing is
+// drawn when the scan was cancelled or hint mode ended; a scan that ran out of time still
+// draws what it found.
+func (h *Handler) refreshStreamedHints(ctx context.Context, elements []*infra.TreeNode) {
+	h.scanMu.Lock()
+	defer h.scanMu.Unlock()
+
+	if errors.Is(ctx.Err(), context.Canceled) || h.State.CurrentMode() != domain.ModeHints {
+		return
+	}
+
+	err := h.SetupHints(elements)
+	if err != nil {
+		h.Logger.Error("Failed to refresh streamed hints", zap.Error(err))
+		return
+	}
+
+	h.Logger.Debug("Refreshed streamed hints", zap.Int("count", len(elements)))
 }
 
 // SetupHints generates hints and draws them with appropriate styling.
@@ -0,0 +1,77 @@
+package cli
+
+import (
+	"fmt"
+	"path/filepath"
+	"time"
+
+	"github.com/spf13/cobra"
+	"github.com/y3owk1n/neru/internal/domain"
+	"github.com/y3owk1n/neru/internal/infra/ipc"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+)
+
+// snapshotTimeout is the shortest IPC timeout for snapshots; recording a large tree takes
+// much longer than a scan.
+const snapshotTimeout = time.Minute
+
+var debugCmd = &cobra.Command{
+	Use:   "debug",
+	Short: "Debugging tools",
+	Long:  "Commands that help diagnose slow or missing hints.",
+}
+
+var debugSnapshotCmd = &cobra.Command{
+	Use:   "snapshot [path]",
+	Short: "Record the frontmost window's accessibility tree",
+	Long: `Record the complete accessibility tree of the frontmost window, with the on-screen
+windows and the active screen, into a compact binary file that reproduces hint scans offline.
+The file defaults to neru-<time>.nsnap in the current directory.`,
+	Args: cobra.MaximumNArgs(1),
+	PreRunE: func(_ *cobra.Command, _ []string) error {
+		return requiresRunningInstance()
+	},
+	RunE: func(cmd *cobra.Command, args []string) error {
+		path := "neru-" + time.Now().Format("20060102-150405") + ".nsnap"
+		if len(args) > 0 {
+			path = args[0]
+		}
+		// The daemon resolves relative paths against its own working directory
+		path, err := filepath.Abs(path)
+		if err != nil {
+			return fmt.Errorf("failed to resolve snapshot path: %w", err)
+		}
+
+		delay, _ := cmd.Flags().GetDuration("delay")
+		if delay > 0 {
+			logger.Info(fmt.Sprintf("Recording in %s, switch to the window to record...", delay))
+			time.Sleep(delay)
+		}
+
+		client := ipc.NewClient()
+		response, err := client.SendWithTimeout(
+			ipc.Command{Action: domain.CommandSnapshot, Args: []string{domain.CommandSnapshot, path}},
+			max(time.Duration(timeoutSec)*time.Second, snapshotTimeout),
+		)
+		if err != nil {
+			return fmt.Errorf("failed to send snapshot command: %w", err)
+		}
+
+		if !response.Success {
+			if response.Code != "" {
+				return fmt.Errorf("%s (code: %s)", response.Message, response.Code)
+			}
+			return fmt.Errorf("%s", response.Message)
+		}
+
+		logger.Info(response.Message)
+		return nil
+	},
+}
+
+func init() {
+	debugSnapshotCmd.Flags().
+		Duration("delay", 3*time.Second, "Time to switch to the window to record before recording it")
+	debugCmd.AddCommand(debugSnapshotCmd)
+	rootCmd.AddCommand(debugCmd)
+}
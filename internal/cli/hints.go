@@ -5,6 +5,7 @@ import (
 
 	"github.com/spf13/cobra"
 	"github.com/y3owk1n/neru/internal/domain"
+	"github.com/y3owk1n/neru/internal/infra/ipc"
 	"github.com/y3owk1n/neru/internal/infra/logger"
 )
 
@@ -34,6 +35,9 @@ var hintsCmd = &cobra.Command{
 		if action != "" {
 			params = append(params, action)
 		}
+		if refresh, _ := cmd.Flags().GetBool("refresh"); refresh {
+			params = append(params, ipc.HintsRefreshArg)
+		}
 		return sendCommand("hints", params)
 	},
 }
@@ -41,5 +45,7 @@ var hintsCmd = &cobra.Command{
 func init() {
 	hintsCmd.Flags().
 		StringP("action", "a", "", "Action to perform on hint selection (left_click, right_click, middle_click, mouse_up, mouse_down)")
+	hintsCmd.Flags().
+		BoolP("refresh", "r", false, "Rescan the whole window, ignoring learned pruning and tracked trees")
 	rootCmd.AddCommand(hintsCmd)
 }
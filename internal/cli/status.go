@@ -45,6 +45,36 @@ var statusCmd = &cobra.Command{
 				logger.Info("  Status: " + status)
 				logger.Info("  Mode: " + sd.Mode)
 				logger.Info("  Config: " + sd.Config)
+				if sd.InfoCache != nil {
+					logger.Info(fmt.Sprintf("  Info cache: %.1f%% hit rate (%d hits, %d misses, %d entries)",
+						sd.InfoCache.HitRate*100,
+						sd.InfoCache.Hits,
+						sd.InfoCache.Misses,
+						sd.InfoCache.Entries))
+				}
+				if len(sd.Apps) > 0 {
+					logger.Info("  Accessibility latency:")
+				}
+				for _, app := range sd.Apps {
+					name := app.BundleID
+					if name == "" {
+						name = fmt.Sprintf("pid %d", app.PID)
+					}
+					logger.Info(fmt.Sprintf(
+						"    %s: %d calls, ewma %dµs, p50 %dµs, p90 %dµs, p99 %dµs; "+
+							"last walk %d nodes, depth %d; workers %d, in flight %d, max depth %d",
+						name, app.Calls, app.EWMAUs, app.P50Us, app.P90Us, app.P99Us,
+						app.LastNodes, app.LastDepth, app.Workers, app.InFlight, app.MaxDepth))
+					logger.Info(fmt.Sprintf("      timeout %dms, %d timed out",
+						app.TimeoutMs, app.Timeouts))
+					if app.QuarantineS > 0 {
+						logger.Info(fmt.Sprintf("      quarantined for %ds", app.QuarantineS))
+					}
+					if app.CappedWalks > 0 {
+						logger.Info(fmt.Sprintf("      %d walks stopped at max depth",
+							app.CappedWalks))
+					}
+				}
 			} else {
 				// Fallback to previous behavior
 				if data, ok := response.Data.(map[string]any); ok {
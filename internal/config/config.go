@@ -81,6 +81,9 @@ type HintsConfig struct {
 	BorderWidth    int     `toml:"border_width"`
 	Opacity        float64 `toml:"opacity"`
 
+	VariableLengthLabels bool `toml:"variable_length_labels"`
+	LearnClicks          bool `toml:"learn_clicks"`
+
 	BackgroundColor  string `toml:"background_color"`
 	TextColor        string `toml:"text_color"`
 	MatchedTextColor string `toml:"matched_text_color"`
@@ -94,6 +97,17 @@ type HintsConfig struct {
 	ClickableRoles       []string `toml:"clickable_roles"`
 	IgnoreClickableCheck bool     `toml:"ignore_clickable_check"`
 
+	IncrementalTree bool `toml:"incremental_tree"`
+	LearnedPruning  bool `toml:"learned_pruning"`
+	SourceCache     bool `toml:"source_cache"`
+
+	Prefetch             bool     `toml:"prefetch"`
+	PrefetchDelayMs      int      `toml:"prefetch_delay_ms"`
+	PrefetchMaxAgeMs     int      `toml:"prefetch_max_age_ms"`
+	PrefetchExcludedApps []string `toml:"prefetch_excluded_apps"`
+
+	SlowAppFallback string `toml:"slow_app_fallback"`
+
 	AppConfigs []AppConfig `toml:"app_configs"`
 
 	AdditionalAXSupport AdditionalAXSupport `toml:"additional_ax_support"`
@@ -241,6 +255,9 @@ func DefaultConfig() *Config {
 			BorderWidth:    1,
 			Opacity:        0.95,
 
+			VariableLengthLabels: false,
+			LearnClicks:          false,
+
 			BackgroundColor:  "#FFD700",
 			TextColor:        "#000000",
 			MatchedTextColor: "#737373",
@@ -275,6 +292,17 @@ func DefaultConfig() *Config {
 			},
 			IgnoreClickableCheck: false,
 
+			IncrementalTree: false,
+			LearnedPruning:  false,
+			SourceCache:     false,
+
+			Prefetch:             false,
+			PrefetchDelayMs:      250,
+			PrefetchMaxAgeMs:     3000,
+			PrefetchExcludedApps: []string{},
+
+			SlowAppFallback: "shallow",
+
 			AppConfigs: []AppConfig{},
 
 			AdditionalAXSupport: AdditionalAXSupport{
@@ -51,6 +51,22 @@ func (c *Config) validateHints() error {
 		return errors.New("hints.border_width must be non-negative")
 	}
 
+	if c.Hints.SlowAppFallback != "shallow" && c.Hints.SlowAppFallback != "grid" {
+		return errors.New("hints.slow_app_fallback must be one of: shallow, grid")
+	}
+
+	if c.Hints.PrefetchDelayMs < 0 {
+		return errors.New("hints.prefetch_delay_ms must be non-negative")
+	}
+	if c.Hints.PrefetchMaxAgeMs <= 0 {
+		return errors.New("hints.prefetch_max_age_ms must be positive")
+	}
+	for _, bundle := range c.Hints.PrefetchExcludedApps {
+		if strings.TrimSpace(bundle) == "" {
+			return errors.New("hints.prefetch_excluded_apps cannot contain empty values")
+		}
+	}
+
 	for _, role := range c.Hints.ClickableRoles {
 		if strings.TrimSpace(role) == "" {
 			return errors.New("hints.clickable_roles cannot contain empty values")
@@ -9,4 +9,5 @@ const (
 	CommandStatus       = "status"
 	CommandConfig       = "config"
 	CommandReloadConfig = "reload"
+	CommandSnapshot     = "snapshot"
 )
@@ -5,6 +5,8 @@ type Context struct {
 	SelectedHint  *Hint
 	InActionMode  bool
 	PendingAction *string
+	// BundleID is the application the hints were generated for, while selections are counted.
+	BundleID string
 }
 
 // SetSelectedHint sets the currently selected hint.
@@ -37,9 +39,20 @@ func (c *Context) GetPendingAction() *string {
 	return c.PendingAction
 }
 
+// SetBundleID sets the application the hints were generated for.
+func (c *Context) SetBundleID(bundleID string) {
+	c.BundleID = bundleID
+}
+
+// GetBundleID returns the application the hints were generated for.
+func (c *Context) GetBundleID() string {
+	return c.BundleID
+}
+
 // Reset resets the hints context to its initial state.
 func (c *Context) Reset() {
 	c.SelectedHint = nil
 	c.InActionMode = false
 	c.PendingAction = nil
+	c.BundleID = ""
 }
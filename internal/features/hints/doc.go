@@ -10,6 +10,7 @@
 //   - Element Detection: Query accessibility tree for clickable elements with role-based filtering
 //   - Visual Overlays: Render customizable hints over UI elements with configurable appearance
 //   - Input Routing: Match user input to hints and trigger appropriate actions
+//   - Incremental Filtering: Narrow hints through a label trie, one step per key and one pop per backspace
 //   - Style Customization: Support for different hint appearance modes and visual customization
 //   - Performance Optimization: Intelligent caching and efficient tree traversal algorithms
 //
@@ -42,6 +43,8 @@
 //   - Vimium-style: Sequential character hints (aa, ab, ac...)
 //   - Custom characters: User-defined hint character sets
 //   - Optimized distribution: Efficient character distribution for faster typing
+//   - Variable-length labels: Prefix-free labels of 1 to 3 characters, shortest for likely targets
+//   - Learned labels: Elements selected most in an application get the easiest labels
 //
 // Integration Points:
 // The hints package integrates with:
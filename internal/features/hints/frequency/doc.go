@@ -0,0 +1,21 @@
+// Package frequency counts, per application, how often each element was selected through a
+// hint, so the elements used most can be given the shortest and easiest labels.
+//
+// An element is identified by the signature the accessibility walk gives it: the chain of
+// role names from the window root down to the element, combined with the element's frame
+// relative to the window, rounded to coarse buckets. Signatures carry no element identity,
+// so they stay meaningful across activations and restarts as long as the application's
+// layout does.
+//
+// Key Features:
+//   - Lazy Loading: Each application's counts live in their own file, read in the background
+//     the first time the application's counts are asked for
+//   - Decay: All counts of an application halve once one of them saturates, so old habits
+//     fade as new ones form
+//   - Bounded Memory: Each application keeps a fixed number of elements, least recently
+//     selected dropped first, and only a fixed number of applications stay loaded
+//   - Persistence: Changed applications are saved to JSON files between restarts
+//
+// The package has no platform dependencies; hint mode records selections and hands the
+// counts to the hint generator.
+package frequency
@@ -0,0 +1,381 @@
+package frequency
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"hash/fnv"
+	"os"
+	"path/filepath"
+	"strconv"
+	"sync"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"github.com/y3owk1n/neru/internal/infra/persist"
+	"go.uber.org/zap"
+)
+
+const (
+	// maxEntriesPerApp bounds the elements kept for one application.
+	maxEntriesPerApp = 256
+	// maxLoadedApps bounds the applications whose counts stay in memory.
+	maxLoadedApps = 32
+	// maxCount is the count at which all counts of an application halve.
+	maxCount = 1024
+	// forgetAfter is how long an element is kept without being selected.
+	forgetAfter = 90 * 24 * time.Hour
+	// fileVersion is the version of the persisted format.
+	fileVersion = 1
+)
+
+// errUnsupportedVersion is returned when loading a file written by another format version.
+var errUnsupportedVersion = errors.New("unsupported click frequency file version")
+
+// Counts maps element signatures to how often the elements were selected.
+type Counts map[uint64]uint32
+
+// entry is the recorded state of one signature.
+type entry struct {
+	// Count is how often the element was selected, halved whenever the application's counts
+	// saturate.
+	Count uint32 `json:"count"`
+	// Seen is the Unix time in seconds of the last selection.
+	Seen int64 `json:"seen"`
+}
+
+// appCounts is the state of one application in memory.
+type appCounts struct {
+	entries map[uint64]*entry
+	// loaded is closed once the entries were read from disk.
+	loaded chan struct{}
+	// used is the Unix time in seconds the counts were last looked up or recorded to.
+	used  int64
+	dirty bool
+}
+
+// pendingWrite is an application's file encoded under the lock, to be written outside it.
+type pendingWrite struct {
+	path string
+	data []byte
+	app  *appCounts
+}
+
+// Store holds the selection counts of recently used applications, keyed by bundle ID, and
+// persists each application to its own file in a directory. It is safe for concurrent use.
+// Methods are safe on a nil receiver, which counts nothing.
+type Store struct {
+	mu   sync.Mutex
+	dir  string
+	apps map[string]*appCounts
+}
+
+// NewStore creates a store persisting to dir. An empty dir keeps counts in memory only.
+func NewStore(dir string) *Store {
+	return &Store{
+		dir:  dir,
+		apps: make(map[string]*appCounts),
+	}
+}
+
+// DefaultDir returns the directory counts persist to, or "" if there is no cache directory.
+func DefaultDir() string {
+	dir, err := os.UserCacheDir()
+	if err != nil {
+		logger.Warn("No cache directory for click frequencies", zap.Error(err))
+		return ""
+	}
+	return filepath.Join(dir, "neru", "click-frequency")
+}
+
+// Counts returns a snapshot of the application's counts, or nil while none are known. The
+// first call for an application starts loading its file in the background and returns nil,
+// so a lookup never waits on the disk.
+func (s *Store) Counts(bundleID string, now time.Time) Counts {
+	if s == nil || bundleID == "" {
+		return nil
+	}
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	app := s.acquireLocked(bundleID, now)
+	if !app.isLoaded() || len(app.entries) == 0 {
+		return nil
+	}
+	counts := make(Counts, len(app.entries))
+	for signature, recorded := range app.entries {
+		counts[signature] = recorded.Count
+	}
+	return counts
+}
+
+// Preload starts loading the application's counts in the background unless they are loaded.
+func (s *Store) Preload(bundleID string, now time.Time) {
+	if s == nil || bundleID == "" {
+		return
+	}
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	s.acquireLocked(bundleID, now)
+}
+
+// Record counts one selection of the element with the signature. It waits for the
+// application's counts to load, so callers run it off the input path.
+func (s *Store) Record(bundleID string, signature uint64, now time.Time) {
+	if s == nil || bundleID == "" || signature == 0 {
+		return
+	}
+
+	// The application may be unloaded while its file is read; record into whatever is
+	// current once loading finished
+	var app *appCounts
+	for {
+		s.mu.Lock()
+		app = s.acquireLocked(bundleID, now)
+		s.mu.Unlock()
+		<-app.loaded
+
+		s.mu.Lock()
+		if s.apps[bundleID] == app {
+			break
+		}
+		s.mu.Unlock()
+	}
+	defer s.mu.Unlock()
+
+	recorded := app.entries[signature]
+	if recorded == nil {
+		recorded = &entry{}
+		app.entries[signature] = recorded
+	}
+	recorded.Count++
+	recorded.Seen = now.Unix()
+	if recorded.Count >= maxCount {
+		halveEntries(app.entries)
+	}
+	persist.Trim(app.entries, maxEntriesPerApp, seenAt)
+	app.dirty = true
+}
+
+// Save writes every application whose counts changed since they were loaded or last saved.
+// Files are replaced atomically.
+func (s *Store) Save(now time.Time) error {
+	if s == nil || s.dir == "" {
+		return nil
+	}
+
+	s.mu.Lock()
+	var pending []pendingWrite
+	var errs []error
+	for bundleID, app := range s.apps {
+		if !app.dirty {
+			continue
+		}
+		write, err := s.encodeLocked(bundleID, app, now)
+		if err != nil {
+			errs = append(errs, err)
+			continue
+		}
+		pending = append(pending, write)
+	}
+	s.mu.Unlock()
+
+	return errors.Join(append(errs, s.flush(pending)...)...)
+}
+
+// acquireLocked returns the application's counts, starting to load them if they are not in
+// memory. It runs with s.mu held.
+func (s *Store) acquireLocked(bundleID string, now time.Time) *appCounts {
+	app := s.apps[bundleID]
+	if app == nil {
+		app = &appCounts{
+			entries: make(map[uint64]*entry),
+			loaded:  make(chan struct{}),
+		}
+		s.apps[bundleID] = app
+		go s.load(bundleID, app, now)
+	}
+	app.used = now.Unix()
+	return app
+}
+
+// load reads the application's file into app, then unloads the applications used least
+// recently beyond maxLoadedApps, saving those that changed.
+func (s *Store) load(bundleID string, app *appCounts, now time.Time) {
+	entries, err := readEntries(s.filePath(bundleID), now)
+	if err != nil {
+		logger.Warn("Failed to load click frequencies",
+			zap.String("bundle_id", bundleID),
+			zap.Error(err))
+	}
+
+	s.mu.Lock()
+	if entries != nil {
+		app.entries = entries
+	}
+	close(app.loaded)
+	pending := s.unloadLocked(bundleID, now)
+	s.mu.Unlock()
+
+	for _, err := range s.flush(pending) {
+		logger.Warn("Failed to save click frequencies", zap.Error(err))
+	}
+	logger.Debug("Loaded click frequencies",
+		zap.String("bundle_id", bundleID),
+		zap.Int("entries", len(entries)))
+}
+
+// unloadLocked drops loaded applications other than keep, least recently used first, until
+// at most maxLoadedApps remain. It returns the files of the dropped applications that
+// changed. It runs with s.mu held.
+func (s *Store) unloadLocked(keep string, now time.Time) []pendingWrite {
+	var pending []pendingWrite
+	for len(s.apps) > maxLoadedApps {
+		oldest := ""
+		for bundleID, app := range s.apps {
+			if bundleID == keep || !app.isLoaded() {
+				continue
+			}
+			if oldest == "" || app.used < s.apps[oldest].used {
+				oldest = bundleID
+			}
+		}
+		if oldest == "" {
+			break
+		}
+
+		app := s.apps[oldest]
+		delete(s.apps, oldest)
+		if !app.dirty || s.dir == "" {
+			continue
+		}
+		write, err := s.encodeLocked(oldest, app, now)
+		if err != nil {
+			logger.Warn("Failed to encode click frequencies", zap.Error(err))
+			continue
+		}
+		pending = append(pending, write)
+	}
+	return pending
+}
+
+// appFile is the persisted form of one application's counts.
+type appFile struct {
+	Version  int               `json:"version"`
+	BundleID string            `json:"bundle_id"`
+	Entries  map[uint64]*entry `json:"entries"`
+}
+
+// encodeLocked expires the application's old entries and encodes its file, marking it
+// saved. It runs with s.mu held.
+func (s *Store) encodeLocked(
+	bundleID string,
+	app *appCounts,
+	now time.Time,
+) (pendingWrite, error) {
+	expireEntries(app.entries, now)
+
+	data, err := json.Marshal(appFile{
+		Version:  fileVersion,
+		BundleID: bundleID,
+		Entries:  app.entries,
+	})
+	if err != nil {
+		return pendingWrite{}, fmt.Errorf("failed to encode click frequency file: %w", err)
+	}
+	app.dirty = false
+	return pendingWrite{path: s.filePath(bundleID), data: data, app: app}, nil
+}
+
+// flush writes the encoded files. Applications whose file could not be written are marked
+// changed again, so a later Save retries them.
+func (s *Store) flush(pending []pendingWrite) []error {
+	var errs []error
+	for _, write := range pending {
+		err := persist.WriteFile(write.path, write.data)
+		if err == nil {
+			continue
+		}
+		errs = append(errs, fmt.Errorf("failed to save click frequency file: %w", err))
+		s.mu.Lock()
+		write.app.dirty = true
+		s.mu.Unlock()
+	}
+	return errs
+}
+
+// filePath returns the file of the application, or "" if counts are kept in memory only.
+// Bundle IDs are hashed so any of them makes a safe file name.
+func (s *Store) filePath(bundleID string) string {
+	if s.dir == "" {
+		return ""
+	}
+	hash := fnv.New64a()
+	_, _ = hash.Write([]byte(bundleID))
+	return filepath.Join(s.dir, strconv.FormatUint(hash.Sum64(), 16)+".json")
+}
+
+// isLoaded reports whether the application's file was read.
+func (a *appCounts) isLoaded() bool {
+	select {
+	case <-a.loaded:
+		return true
+	default:
+		return false
+	}
+}
+
+// readEntries reads the entries of an application file, dropping those that expired while
+// the file was on disk. A missing file or empty path yields no entries.
+func readEntries(path string, now time.Time) (map[uint64]*entry, error) {
+	if path == "" {
+		return nil, nil
+	}
+
+	var file appFile
+	found, err := persist.ReadJSON(path, &file)
+	if err != nil {
+		return nil, fmt.Errorf("failed to load click frequency file: %w", err)
+	}
+	if !found {
+		return nil, nil
+	}
+	if file.Version != fileVersion {
+		return nil, fmt.Errorf("%w: %d", errUnsupportedVersion, file.Version)
+	}
+	if file.Entries == nil {
+		return nil, nil
+	}
+
+	for signature, recorded := range file.Entries {
+		if recorded == nil {
+			delete(file.Entries, signature)
+		}
+	}
+	expireEntries(file.Entries, now)
+	persist.Trim(file.Entries, maxEntriesPerApp, seenAt)
+	return file.Entries, nil
+}
+
+// expireEntries drops entries that were not selected for forgetAfter.
+func expireEntries(entries map[uint64]*entry, now time.Time) {
+	persist.Expire(entries, now.Add(-forgetAfter).Unix(), seenAt)
+}
+
+// halveEntries halves every count, dropping entries that reach zero.
+func halveEntries(entries map[uint64]*entry) {
+	for signature, recorded := range entries {
+		recorded.Count /= 2
+		if recorded.Count == 0 {
+			delete(entries, signature)
+		}
+	}
+}
+
+// seenAt returns when the entry was last selected, in Unix seconds.
+func seenAt(recorded *entry) int64 {
+	return recorded.Seen
+}
@@ -2,9 +2,10 @@ package hints
 
 import (
 	"image"
-	"sort"
+	"slices"
 	"strings"
 
+	"github.com/y3owk1n/neru/internal/features/hints/frequency"
 	"github.com/y3owk1n/neru/internal/infra/accessibility"
 	"github.com/y3owk1n/neru/internal/infra/logger"
 	"go.uber.org/zap"
@@ -21,10 +22,15 @@ type Hint struct {
 
 // Generator creates hint labels for UI elements based on their position and size.
 type Generator struct {
-	characters       string
-	uppercaseChars   string // Cached uppercase version.
-	maxHints         int
-	uppercaseRuneMap map[rune]rune // Cache for uppercase rune conversions.
+	characters     string
+	uppercaseChars string // Cached uppercase version.
+	maxHints       int
+	// labels holds every label of each length, built once per character set.
+	labels [maxLabelLength]*labelTable
+	// variableLength gives likely targets shorter labels instead of one length for all.
+	variableLength bool
+	// clicks counts past selections of the current application's elements by signature.
+	clicks frequency.Counts
 }
 
 // NewGenerator initializes a new hint generator with the specified character set.
@@ -45,18 +51,14 @@ func NewGenerator(characters string) *Generator {
 	)
 	logger.Debug("Setting maxHints", zap.Int("maxHints", maxHints))
 
-	// Cache uppercase version and create rune map
+	// Cache uppercase version and the label tables
 	uppercaseChars := strings.ToUpper(characters)
-	runeMap := make(map[rune]rune, len(characters))
-	for i, r := range characters {
-		runeMap[r] = rune(uppercaseChars[i])
-	}
 
 	return &Generator{
-		characters:       characters,
-		uppercaseChars:   uppercaseChars,
-		maxHints:         maxHints,
-		uppercaseRuneMap: runeMap,
+		characters:     characters,
+		uppercaseChars: uppercaseChars,
+		maxHints:       maxHints,
+		labels:         newLabelTables(uppercaseChars),
 	}
 }
 
@@ -75,37 +77,56 @@ func (g *Generator) UpdateCharacters(characters string) {
 	charCount := len(characters)
 	g.maxHints = charCount * charCount * charCount
 
-	// Update cached uppercase version and rune map
+	// Update cached uppercase version and rebuild the label tables
 	g.uppercaseChars = strings.ToUpper(characters)
-	g.uppercaseRuneMap = make(map[rune]rune, len(characters))
-	for i, r := range characters {
-		g.uppercaseRuneMap[r] = rune(g.uppercaseChars[i])
-	}
+	g.labels = newLabelTables(g.uppercaseChars)
 
 	logger.Debug("Updated hint characters",
 		zap.String("characters", characters),
 		zap.Int("maxHints", g.maxHints))
 }
 
+// SetVariableLength chooses between labels of one length for all elements and prefix-free
+// labels of 1 to 3 characters, shorter for larger elements.
+func (g *Generator) SetVariableLength(enabled bool) { g.variableLength = enabled }
+
+// SetClickCounts sets how often the current application's elements were selected before.
+// Elements selected more get shorter labels, or labels starting with the first characters;
+// nil treats all elements alike.
+func (g *Generator) SetClickCounts(counts frequency.Counts) { g.clicks = counts }
+
 // Generate creates hints for the given UI elements, sorted by position and limited by maximum count.
 func (g *Generator) Generate(elements []*accessibility.TreeNode) ([]*Hint, error) {
 	if len(elements) == 0 {
 		return []*Hint{}, nil
 	}
 
-	// Sort elements by position (top-to-bottom, left-to-right)
-	// Use a sortable slice type to avoid closure allocations
-	sortedElements := make(treeNodesByPosition, len(elements))
-	copy(sortedElements, elements)
-	sort.Sort(sortedElements)
+	// Order elements by rows (top-to-bottom, left-to-right)
+	sortedElements := readingOrder(elements)
 
 	// Limit to max hints
 	if g.maxHints > 0 && len(sortedElements) > g.maxHints {
 		sortedElements = sortedElements[:g.maxHints]
 	}
 
-	// Generate labels (alphabet-only) - already uppercase
-	labels := g.generateAlphabetLabels(len(sortedElements))
+	// Labels (alphabet-only, already uppercase) come from the prebuilt tables
+	labels := g.labelTable(len(sortedElements))
+	if len(sortedElements) > labels.len() {
+		sortedElements = sortedElements[:labels.len()]
+	}
+
+	// Labels that depend on every element's weight or selections are assigned up front
+	var assigned []string
+	switch {
+	case g.variableLength && g.labels[0].len() > 1:
+		weights := make([]float64, len(sortedElements))
+		for elementIndex, element := range sortedElements {
+			weights[elementIndex] = elementWeight(element) * g.clickFactor(element)
+		}
+		assigned = g.assignVariableLabels(weights)
+	case len(g.clicks) > 0:
+		assigned = g.rankedLabels(labels, sortedElements)
+	}
 
 	// Pre-allocate hints with exact capacity
 	hints := make([]*Hint, len(sortedElements))
@@ -114,8 +135,13 @@ func (g *Generator) Generate(elements []*accessibility.TreeNode) ([]*Hint, error
 		centerX := element.Info.Position.X + (element.Info.Size.X / 2)
 		centerY := element.Info.Position.Y + (element.Info.Size.Y / 2)
 
+		label := labels.label(elementIndex) // Substring of the table, no allocation
+		if assigned != nil {
+			label = assigned[elementIndex]
+		}
+
 		hints[elementIndex] = &Hint{
-			Label:    labels[elementIndex], // Already uppercase from generateAlphabetLabels
+			Label:    label,
 			Element:  element,
 			Position: image.Point{X: centerX, Y: centerY},
 			Size:     element.Info.Size,
@@ -125,87 +151,15 @@ func (g *Generator) Generate(elements []*accessibility.TreeNode) ([]*Hint, error
 	return hints, nil
 }
 
-// treeNodesByPosition implements sort.Interface for sorting TreeNodes by position.
-type treeNodesByPosition []*accessibility.TreeNode
-
-func (t treeNodesByPosition) Len() int { return len(t) }
-
-func (t treeNodesByPosition) Less(i, j int) bool {
-	posI := t[i].Info.Position
-	posJ := t[j].Info.Position
-
-	// Sort by Y first (top to bottom)
-	if posI.Y != posJ.Y {
-		return posI.Y < posJ.Y
-	}
-	// Then by X (left to right)
-	return posI.X < posJ.X
-}
-
-func (t treeNodesByPosition) Swap(i, j int) {
-	t[i], t[j] = t[j], t[i]
-}
-
-// generateAlphabetLabels generates alphabet-based hint labels using a prefix-avoidance strategy.
-// Ensures no single character label conflicts with the start of a multi-character label.
-// Returns uppercase labels.
-func (g *Generator) generateAlphabetLabels(count int) []string {
-	if count <= 0 {
-		return []string{}
-	}
-
-	// Pre-allocate with exact capacity
-	labels := make([]string, 0, count)
-	chars := []rune(g.uppercaseChars) // Use cached uppercase characters
-	numChars := len(chars)
-
-	var length int
-	switch {
-	case count <= numChars:
-		length = 1
-	case count <= numChars*numChars:
-		length = 2
-	default:
-		length = 3
-	}
-
-	// Generate labels of the determined length
-	switch length {
-	case 1:
-		// Single character labels
-		for i := range chars[:count] {
-			labels = append(labels, string(chars[i]))
-		}
-	case 2:
-		// All 2-char combinations using strings.Builder
-		var b strings.Builder
-		b.Grow(2)
-		for i := 0; i < numChars && len(labels) < count; i++ {
-			for j := 0; j < numChars && len(labels) < count; j++ {
-				b.Reset()
-				b.WriteRune(chars[i])
-				b.WriteRune(chars[j])
-				labels = append(labels, b.String())
-			}
-		}
-	case 3:
-		// All 3-char combinations using strings.Builder
-		var b strings.Builder
-		b.Grow(3)
-		for i := 0; i < numChars && len(labels) < count; i++ {
-			for j := 0; j < numChars && len(labels) < count; j++ {
-				for k := 0; k < numChars && len(labels) < count; k++ {
-					b.Reset()
-					b.WriteRune(chars[i])
-					b.WriteRune(chars[j])
-					b.WriteRune(chars[k])
-					labels = append(labels, b.String())
-				}
-			}
+// labelTable returns the table of the shortest labels that can tell count elements apart.
+// Labels of one length never prefix each other, so any leading part of a table is unambiguous.
+func (g *Generator) labelTable(count int) *labelTable {
+	for _, table := range g.labels[:maxLabelLength-1] {
+		if count <= table.len() {
+			return table
 		}
 	}
-
-	return labels[:count]
+	return g.labels[maxLabelLength-1]
 }
 
 // GetBounds returns the bounding rectangle for a hint.
@@ -240,38 +194,27 @@ func (h *Hint) GetSize() image.Point { return h.Size }
 // GetMatchedPrefix returns the matched prefix.
 func (h *Hint) GetMatchedPrefix() string { return h.MatchedPrefix }
 
-// HintCollection manages a collection of hints.
+// HintCollection manages a collection of hints and indexes them by label in a trie.
 type HintCollection struct {
-	hints   []*Hint
-	active  bool
-	byLabel map[string]*Hint
-	prefix1 map[byte][]*Hint
-	prefix2 map[string][]*Hint
+	hints  []*Hint
+	active bool
+	trie   *labelTrie
 }
 
 // NewHintCollection creates a new hint collection.
 func NewHintCollection(hints []*Hint) *HintCollection {
-	hintCollection := &HintCollection{
-		hints:   hints,
-		active:  true,
-		byLabel: make(map[string]*Hint, len(hints)),
-		prefix1: make(map[byte][]*Hint),
-		prefix2: make(map[string][]*Hint),
+	// Labels are already uppercase from generation; generated labels are also already sorted
+	sorted := hints
+	if !slices.IsSortedFunc(hints, compareLabels) {
+		sorted = slices.Clone(hints)
+		slices.SortStableFunc(sorted, compareLabels)
 	}
-	for _, hint := range hints {
-		// Labels are already uppercase from generation
-		label := hint.GetLabel()
-		hintCollection.byLabel[label] = hint
-		if len(label) >= 1 {
-			firstByte := label[0]
-			hintCollection.prefix1[firstByte] = append(hintCollection.prefix1[firstByte], hint)
-		}
-		if len(label) >= 2 {
-			prefix := label[:2]
-			hintCollection.prefix2[prefix] = append(hintCollection.prefix2[prefix], hint)
-		}
+
+	return &HintCollection{
+		hints:  hints,
+		active: true,
+		trie:   newLabelTrie(sorted),
 	}
-	return hintCollection
 }
 
 // GetHints returns all hints.
@@ -283,44 +226,24 @@ func (hc *HintCollection) GetHints() []*Hint {
 func (hc *HintCollection) FindByLabel(label string) *Hint {
 	// Convert to uppercase once for lookup
 	upperLabel := strings.ToUpper(label)
-	return hc.byLabel[upperLabel]
+	node := hc.trie.find(upperLabel)
+	if node == noChild {
+		return nil
+	}
+	return hc.trie.exact(node, len(upperLabel))
 }
 
-// FilterByPrefix filters hints by prefix.
+// FilterByPrefix returns the hints whose label starts with prefix, ordered by label. The slice
+// shares the collection's storage and must not be modified.
 func (hc *HintCollection) FilterByPrefix(prefix string) []*Hint {
 	if prefix == "" {
 		return hc.hints
 	}
-	// Convert to uppercase once at the start
-	upperPrefix := strings.ToUpper(prefix)
-	prefixLen := len(upperPrefix)
-
-	if prefixLen == 1 {
-		firstByte := upperPrefix[0]
-		bucket := hc.prefix1[firstByte]
-		if len(bucket) == 0 {
-			return []*Hint{}
-		}
-		// Pre-allocate with exact capacity
-		out := make([]*Hint, len(bucket))
-		copy(out, bucket)
-		return out
-	}
-	if prefixLen >= 2 {
-		if bucket, ok := hc.prefix2[upperPrefix[:2]]; ok {
-			// Pre-allocate with capacity hint
-			out := make([]*Hint, 0, len(bucket))
-			for _, hint := range bucket {
-				// Labels are already uppercase, direct comparison
-				if strings.HasPrefix(hint.GetLabel(), upperPrefix) {
-					out = append(out, hint)
-				}
-			}
-			return out
-		}
+	node := hc.trie.find(strings.ToUpper(prefix))
+	if node == noChild {
 		return []*Hint{}
 	}
-	return []*Hint{}
+	return hc.trie.hints(node)
 }
 
 // IsActive returns whether the collection is active.
@@ -338,11 +261,7 @@ func (hc *HintCollection) Count() int {
 	return len(hc.hints)
 }
 
-// GetByLabelMap returns the hint map by label.
-func (hc *HintCollection) GetByLabelMap() map[string]*Hint { return hc.byLabel }
-
-// GetPrefix1Map returns the prefix1 map.
-func (hc *HintCollection) GetPrefix1Map() map[byte][]*Hint { return hc.prefix1 }
-
-// GetPrefix2Map returns the prefix2 map.
-func (hc *HintCollection) GetPrefix2Map() map[string][]*Hint { return hc.prefix2 }
+// compareLabels orders hints by label.
+func compareLabels(first, second *Hint) int {
+	return strings.Compare(first.Label, second.Label)
+}
@@ -0,0 +1,58 @@
+package hints
+
+import (
+	"image"
+	"testing"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility"
+)
+
+// gridElements returns count elements laid out in rows of 20, like a dense toolbar or list.
+func gridElements(count int) []*accessibility.TreeNode {
+	elements := make([]*accessibility.TreeNode, count)
+	for index := range elements {
+		elements[index] = &accessibility.TreeNode{
+			Info: &accessibility.ElementInfo{
+				Position: image.Pt(index%20*48, index/20*32),
+				Size:     image.Pt(40, 24),
+				Role:     "AXButton",
+			},
+		}
+	}
+	return elements
+}
+
+// TestGenerateAllocatesNothingPerLabel checks that labels are handed out of the prebuilt
+// tables: beyond the Hint itself, one more element costs no allocation.
+func TestGenerateAllocatesNothingPerLabel(t *testing.T) {
+	generator := NewGenerator("asdfghjkl")
+	small, large := gridElements(81), gridElements(729)
+
+	allocs := func(elements []*accessibility.TreeNode) float64 {
+		return testing.AllocsPerRun(20, func() {
+			_, _ = generator.Generate(elements)
+		})
+	}
+	smallAllocs, largeAllocs := allocs(small), allocs(large)
+
+	perElement := (largeAllocs - smallAllocs) / float64(len(large)-len(small))
+	if perElement != 1 {
+		t.Errorf("Generate() allocates %.0f times for %d elements and %.0f for %d; "+
+			"want one allocation per element, for its Hint",
+			smallAllocs, len(small), largeAllocs, len(large))
+	}
+}
+
+func BenchmarkGenerate(b *testing.B) {
+	generator := NewGenerator("asdfghjkl")
+	elements := gridElements(500)
+
+	b.ReportAllocs()
+	for b.Loop() {
+		_, err := generator.Generate(elements)
+		if err != nil {
+			b.Fatal(err)
+		}
+	}
+	b.ReportMetric(float64(len(elements)), "hints/op")
+}
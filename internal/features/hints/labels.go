@@ -0,0 +1,226 @@
+package hints
+
+import (
+	"cmp"
+	"math"
+	"slices"
+	"strings"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility"
+)
+
+// maxLabelLength is the longest label the generator assigns.
+const maxLabelLength = 3
+
+// labelTable holds every label of one length over a character set, in generation order,
+// packed into a single string. Labels are substrings of it, so handing them out allocates
+// nothing.
+type labelTable struct {
+	slab string
+	// offsets has one entry per label plus an end marker; label i is
+	// slab[offsets[i]:offsets[i+1]]. Characters can take more than one byte.
+	offsets []int32
+}
+
+// newLabelTable builds the table of all labels of length characters: every combination of
+// chars, in order, with the first character changing slowest.
+func newLabelTable(chars []rune, length int) *labelTable {
+	count := 1
+	for range length {
+		count *= len(chars)
+	}
+
+	var slab strings.Builder
+	slab.Grow(count * length)
+	offsets := make([]int32, 0, count+1)
+
+	digits := make([]int, length)
+	for range count {
+		offsets = append(offsets, int32(slab.Len()))
+		for _, digit := range digits {
+			slab.WriteRune(chars[digit])
+		}
+
+		// Advance the combination like an odometer
+		for position := length - 1; position >= 0; position-- {
+			digits[position]++
+			if digits[position] < len(chars) {
+				break
+			}
+			digits[position] = 0
+		}
+	}
+	offsets = append(offsets, int32(slab.Len()))
+
+	return &labelTable{slab: slab.String(), offsets: offsets}
+}
+
+// len returns the number of labels in the table.
+func (t *labelTable) len() int {
+	return len(t.offsets) - 1
+}
+
+// label returns label index.
+func (t *labelTable) label(index int) string {
+	return t.slab[t.offsets[index]:t.offsets[index+1]]
+}
+
+// elementWeight estimates how likely an element is to be clicked from its size: larger
+// targets are hit more often. The square root keeps a large canvas from outweighing
+// everything else.
+func elementWeight(element *accessibility.TreeNode) float64 {
+	size := element.Info.Size
+	return math.Sqrt(float64(max(size.X, 1)) * float64(max(size.Y, 1)))
+}
+
+// clickBias is how much each past selection adds to an element's weight, as a multiple of it.
+// A couple of selections outweigh the largest difference in size.
+const clickBias = 16
+
+// clickFactor returns the factor by which past selections raise the element's weight.
+func (g *Generator) clickFactor(element *accessibility.TreeNode) float64 {
+	return 1 + clickBias*float64(g.clicks[uint64(element.Signature)])
+}
+
+// newLabelTables builds the tables of every label length for the uppercase characters.
+func newLabelTables(uppercaseChars string) [maxLabelLength]*labelTable {
+	chars := []rune(uppercaseChars)
+	var tables [maxLabelLength]*labelTable
+	for length := 1; length <= maxLabelLength; length++ {
+		tables[length-1] = newLabelTable(chars, length)
+	}
+	return tables
+}
+
+// labelPlan splits n labels into lengths. Labels of one character use the first characters;
+// the remaining characters start 2-character labels, and the last extended 2-character
+// prefixes start 3-character labels instead.
+type labelPlan struct {
+	single, double, triple int
+	extended               int
+}
+
+// planLabels returns the plan with the fewest expected keystrokes for labels of up to three
+// characters over k characters, given the weights sorted from heaviest to lightest. The
+// heaviest elements get the shortest labels. Any count up to k³ fits.
+func planLabels(sortedWeights []float64, k int) labelPlan {
+	n := len(sortedWeights)
+	// top[i] is the total weight of the i heaviest elements
+	top := make([]float64, n+1)
+	for index, weight := range sortedWeights {
+		top[index+1] = top[index] + weight
+	}
+
+	var best labelPlan
+	bestSaving := -1.0
+	for single := 0; single <= min(k, n); single++ {
+		rest := n - single
+		prefixes := (k - single) * k
+		extended := 0
+		if rest > prefixes {
+			// Every extended prefix trades one 2-character label for k 3-character ones
+			extended = (rest - prefixes + k - 2) / (k - 1)
+		}
+		if extended > prefixes {
+			continue
+		}
+		double := min(rest, prefixes-extended)
+
+		// Keystrokes are 3 per label, minus 2 per single and 1 per double
+		saving := top[single] + top[single+double]
+		if saving > bestSaving {
+			bestSaving = saving
+			best = labelPlan{
+				single:   single,
+				double:   double,
+				triple:   rest - double,
+				extended: extended,
+			}
+		}
+	}
+	return best
+}
+
+// assignVariableLabels labels elements, given in reading order, with prefix-free labels whose
+// length follows their weight. Within one length, labels follow reading order, so nearby
+// elements of similar weight keep neighbouring labels.
+func (g *Generator) assignVariableLabels(weights []float64) []string {
+	n := len(weights)
+	k := g.labels[0].len()
+
+	order := make([]int, n)
+	for index := range order {
+		order[index] = index
+	}
+	slices.SortStableFunc(order, func(first, second int) int {
+		return cmp.Compare(weights[second], weights[first])
+	})
+	sortedWeights := make([]float64, n)
+	for rank, index := range order {
+		sortedWeights[rank] = weights[index]
+	}
+	plan := planLabels(sortedWeights, k)
+
+	lengths := make([]uint8, n)
+	for rank, index := range order {
+		switch {
+		case rank < plan.single:
+			lengths[index] = 1
+		case rank < plan.single+plan.double:
+			lengths[index] = 2
+		default:
+			lengths[index] = 3
+		}
+	}
+
+	// Table indices follow the odometer order: pair (a, b) is a*k+b, triple (a, b, c) is
+	// (a*k+b)*k+c. Doubles start after the singles' first characters, triples after the
+	// last pair that is still a label.
+	nextDouble := plan.single * k
+	nextTriple := (k*k - plan.extended) * k
+	nextSingle := 0
+	labels := make([]string, n)
+	for index, length := range lengths {
+		switch length {
+		case 1:
+			labels[index] = g.labels[0].label(nextSingle)
+			nextSingle++
+		case 2:
+			labels[index] = g.labels[1].label(nextDouble)
+			nextDouble++
+		default:
+			labels[index] = g.labels[2].label(nextTriple)
+			nextTriple++
+		}
+	}
+	return labels
+}
+
+// rankedLabels hands the first labels of the table, which start with the first characters, to
+// the elements selected most, and the following ones to the rest in reading order. It returns
+// nil when none of the elements was selected before.
+func (g *Generator) rankedLabels(table *labelTable, elements []*accessibility.TreeNode) []string {
+	counts := make([]uint32, len(elements))
+	selected := false
+	for index, element := range elements {
+		counts[index] = g.clicks[uint64(element.Signature)]
+		selected = selected || counts[index] > 0
+	}
+	if !selected {
+		return nil
+	}
+
+	order := make([]int, len(elements))
+	for index := range order {
+		order[index] = index
+	}
+	slices.SortStableFunc(order, func(first, second int) int {
+		return cmp.Compare(counts[second], counts[first])
+	})
+
+	labels := make([]string, len(elements))
+	for rank, index := range order {
+		labels[index] = table.label(rank)
+	}
+	return labels
+}
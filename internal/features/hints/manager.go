@@ -1,23 +1,32 @@
 package hints
 
 import (
-	"strings"
-
 	"go.uber.org/zap"
 )
 
 // Manager handles hint input processing, filtering, and state management.
+// Input narrows a cursor over the collection's label trie, so a keystroke costs one trie step
+// plus the hints it affects, however many hints there are.
 type Manager struct {
 	currentInput string
 	currentHints *HintCollection
+	cursor       *Cursor
 	onHintUpdate func([]*Hint)
+	onHintMatch  func(changed []*Hint, prefix string)
 	logger       *zap.Logger
 }
 
-// NewManager initializes a new hint manager with the specified update callback and logger.
-func NewManager(onHintUpdate func([]*Hint), logger *zap.Logger) *Manager {
+// NewManager initializes a new hint manager with the specified callbacks and logger.
+// onHintUpdate receives the hints to draw from scratch; onHintMatch receives, after each
+// typed key or backspace, only the hints whose match changed together with the typed prefix.
+func NewManager(
+	onHintUpdate func([]*Hint),
+	onHintMatch func(changed []*Hint, prefix string),
+	logger *zap.Logger,
+) *Manager {
 	return &Manager{
 		onHintUpdate: onHintUpdate,
+		onHintMatch:  onHintMatch,
 		logger:       logger,
 	}
 }
@@ -25,6 +34,7 @@ func NewManager(onHintUpdate func([]*Hint), logger *zap.Logger) *Manager {
 // SetHints updates the current hint collection and resets the input state.
 func (m *Manager) SetHints(hints *HintCollection) {
 	m.currentHints = hints
+	m.cursor = hints.NewCursor()
 	m.currentInput = ""
 	m.logger.Debug("Hint manager: Setting new hints", zap.Int("hint_count", len(hints.GetHints())))
 	m.updateHints()
@@ -32,6 +42,9 @@ func (m *Manager) SetHints(hints *HintCollection) {
 
 // Reset clears the current input and refreshes all hints.
 func (m *Manager) Reset() {
+	if m.cursor != nil {
+		m.cursor.Reset()
+	}
 	m.currentInput = ""
 	m.logger.Debug("Hint manager: Resetting input")
 	m.updateHints()
@@ -52,13 +65,14 @@ func (m *Manager) HandleInput(key string) (*Hint, bool) {
 
 	// Handle backspace
 	if key == "\x7f" || key == "delete" || key == "backspace" {
-		if len(m.currentInput) > 0 {
-			m.currentInput = m.currentInput[:len(m.currentInput)-1]
+		if changed, ok := m.cursor.Widen(); ok {
+			m.currentInput = m.cursor.Prefix()
 			m.logger.Debug(
 				"Hint manager: Backspace processed",
 				zap.String("new_input", m.currentInput),
+				zap.Int("changed_count", len(changed)),
 			)
-			m.updateHints()
+			m.onHintMatch(changed, m.currentInput)
 		} else {
 			m.logger.Debug("Hint manager: Resetting on backspace with empty input")
 			m.Reset()
@@ -72,36 +86,32 @@ func (m *Manager) HandleInput(key string) (*Hint, bool) {
 		return nil, false
 	}
 
-	// Accumulate input (convert to uppercase to match hints)
-	m.currentInput += strings.ToUpper(key)
-	m.logger.Debug("Hint manager: Input accumulated", zap.String("current_input", m.currentInput))
-
-	// Filter and update hints
-	filtered := m.currentHints.FilterByPrefix(m.currentInput)
-	m.logger.Debug("Hint manager: Filtered hints", zap.Int("filtered_count", len(filtered)))
-
-	if len(filtered) == 0 {
+	// Narrow by the key (uppercase to match hints); only the hints still matching are marked
+	changed, ok := m.cursor.Narrow(toUpper(key[0]))
+	if !ok {
 		// No matches - reset
 		m.logger.Debug("Hint manager: No matches found, resetting")
+		m.cursor.Reset()
 		m.currentInput = ""
 		return nil, false
 	}
+	m.currentInput = m.cursor.Prefix()
 
-	// Update matched prefix for filtered hints
-	for _, hint := range filtered {
-		hint.MatchedPrefix = m.currentInput
-	}
+	m.logger.Debug("Hint manager: Filtered hints",
+		zap.String("current_input", m.currentInput),
+		zap.Int("filtered_count", len(m.cursor.Hints())),
+		zap.Int("changed_count", len(changed)))
 
-	// Notify of hint updates
-	m.onHintUpdate(filtered)
+	// Only the hints that matched before the key need redrawing
+	m.onHintMatch(changed, m.currentInput)
 
 	// Check for exact match
-	if len(filtered) == 1 && filtered[0].GetLabel() == m.currentInput {
+	if hint := m.cursor.Match(); hint != nil {
 		m.logger.Info(
 			"Hint manager: Exact match found",
-			zap.String("label", filtered[0].GetLabel()),
+			zap.String("label", hint.GetLabel()),
 		)
-		return filtered[0], true
+		return hint, true
 	}
 
 	return nil, false
@@ -119,20 +129,16 @@ func (m *Manager) GetHints() []*Hint {
 
 // updateHints updates the hints based on the current input.
 func (m *Manager) updateHints() {
+	// The cursor keeps the matched prefixes up to date
 	var filtered []*Hint
 	if m.currentInput == "" {
 		filtered = m.currentHints.GetHints()
 		m.logger.Debug("Hint manager: Showing all hints", zap.Int("count", len(filtered)))
 	} else {
-		filtered = m.currentHints.FilterByPrefix(m.currentInput)
+		filtered = m.cursor.Hints()
 		m.logger.Debug("Hint manager: Showing filtered hints", zap.Int("count", len(filtered)), zap.String("prefix", m.currentInput))
 	}
 
-	// Update matched prefix for filtered hints
-	for _, hint := range filtered {
-		hint.MatchedPrefix = m.currentInput
-	}
-
 	// Notify of hint updates
 	m.onHintUpdate(filtered)
 }
@@ -140,3 +146,10 @@ func (m *Manager) updateHints() {
 func isLetter(c byte) bool {
 	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
 }
+
+func toUpper(c byte) byte {
+	if c >= 'a' && c <= 'z' {
+		return c - 'a' + 'A'
+	}
+	return c
+}
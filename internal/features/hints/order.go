@@ -0,0 +1,110 @@
+package hints
+
+import (
+	"cmp"
+	"slices"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility"
+)
+
+const (
+	// rowTolerance is how far apart, in points, the top edges of elements in one row may be.
+	rowTolerance = 8
+	// minBuckets is how many row buckets are always acceptable, whatever the element count.
+	minBuckets = 1024
+	// bucketsPerElement bounds the row buckets per element beyond minBuckets; elements spread
+	// further apart are sorted by comparison instead.
+	bucketsPerElement = 8
+)
+
+// readingOrder returns the elements in reading order: rows from top to bottom, and left to
+// right within a row. A row starts at the topmost element not yet placed and takes every
+// element whose top edge is less than rowTolerance below it, so a pixel of misalignment does
+// not move an element to another row. The order depends only on the elements' frames and
+// signatures, not on the order they were found in, so labels stay put across activations.
+//
+// Elements are distributed into buckets of rowTolerance by their top edge in linear time;
+// only the few elements sharing a bucket or a row are compared.
+func readingOrder(elements []*accessibility.TreeNode) []*accessibility.TreeNode {
+	sorted := make([]*accessibility.TreeNode, len(elements))
+	if len(elements) == 0 {
+		return sorted
+	}
+
+	top, bottom := elements[0].Info.Position.Y, elements[0].Info.Position.Y
+	for _, element := range elements[1:] {
+		top = min(top, element.Info.Position.Y)
+		bottom = max(bottom, element.Info.Position.Y)
+	}
+
+	buckets := (bottom-top)/rowTolerance + 1
+	if buckets > minBuckets+bucketsPerElement*len(elements) {
+		copy(sorted, elements)
+		slices.SortFunc(sorted, compareTops)
+	} else {
+		bucketByTop(elements, sorted, top, buckets)
+	}
+
+	for start := 0; start < len(sorted); {
+		limit := sorted[start].Info.Position.Y + rowTolerance
+		end := start + 1
+		for end < len(sorted) && sorted[end].Info.Position.Y < limit {
+			end++
+		}
+		slices.SortFunc(sorted[start:end], compareInRow)
+		start = end
+	}
+	return sorted
+}
+
+// bucketByTop counting-sorts elements into sorted by the bucket of rowTolerance their top
+// edge falls in, counting from top, then orders each bucket by top edge.
+func bucketByTop(elements, sorted []*accessibility.TreeNode, top, buckets int) {
+	// starts[bucket+1] counts the bucket's elements, then becomes where the next one goes
+	starts := make([]int32, buckets+1)
+	for _, element := range elements {
+		starts[(element.Info.Position.Y-top)/rowTolerance+1]++
+	}
+	for bucket := 1; bucket <= buckets; bucket++ {
+		starts[bucket] += starts[bucket-1]
+	}
+	for _, element := range elements {
+		bucket := (element.Info.Position.Y - top) / rowTolerance
+		sorted[starts[bucket]] = element
+		starts[bucket]++
+	}
+
+	// starts[bucket] now ends the bucket
+	begin := int32(0)
+	for _, end := range starts[:buckets] {
+		if end-begin > 1 {
+			slices.SortFunc(sorted[begin:end], compareTops)
+		}
+		begin = end
+	}
+}
+
+// compareTops orders elements by top edge, then as within a row.
+func compareTops(first, second *accessibility.TreeNode) int {
+	if first.Info.Position.Y != second.Info.Position.Y {
+		return cmp.Compare(first.Info.Position.Y, second.Info.Position.Y)
+	}
+	return compareInRow(first, second)
+}
+
+// compareInRow orders elements of one row from left to right. Elements at the same spot are
+// ordered by top edge, size and signature, so the order never depends on how they were found.
+func compareInRow(first, second *accessibility.TreeNode) int {
+	a, b := first.Info, second.Info
+	switch {
+	case a.Position.X != b.Position.X:
+		return cmp.Compare(a.Position.X, b.Position.X)
+	case a.Position.Y != b.Position.Y:
+		return cmp.Compare(a.Position.Y, b.Position.Y)
+	case a.Size.X != b.Size.X:
+		return cmp.Compare(a.Size.X, b.Size.X)
+	case a.Size.Y != b.Size.Y:
+		return cmp.Compare(a.Size.Y, b.Size.Y)
+	}
+	return cmp.Compare(first.Signature, second.Signature)
+}
@@ -12,6 +12,7 @@ import "C"
 
 import (
 	"errors"
+	"strings"
 	"sync"
 	"sync/atomic"
 	"time"
@@ -241,6 +242,32 @@ func (o *Overlay) DrawHintsWithStyle(hints []*Hint, style StyleMode) error {
 	return o.drawHintsInternal(hints, style, true)
 }
 
+// UpdateHintMatches updates hints already drawn in place: those whose labels start with prefix
+// show it as matched, the others are hidden. Hints that are not drawn are ignored.
+func (o *Overlay) UpdateHintMatches(hints []*Hint, prefix string) {
+	if len(hints) == 0 {
+		return
+	}
+
+	cHints := make([]C.HintData, len(hints))
+	for i, hint := range hints {
+		matched := C.int(len(prefix))
+		if !strings.HasPrefix(hint.GetLabel(), prefix) {
+			matched = -1
+		}
+		cHints[i] = C.HintData{
+			label:               C.CString(hint.GetLabel()),
+			matchedPrefixLength: matched,
+		}
+	}
+
+	C.NeruUpdateHintMatches(o.window, &cHints[0], C.int(len(cHints)))
+
+	for _, cHint := range cHints {
+		C.free(unsafe.Pointer(cHint.label))
+	}
+}
+
 // DrawTargetDot draws a small circular dot at the target position.
 func (o *Overlay) DrawTargetDot(
 	x, y int,
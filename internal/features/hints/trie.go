@@ -0,0 +1,204 @@
+package hints
+
+import "math"
+
+// noChild marks an absent child slot, and the child table of a leaf.
+const noChild = -1
+
+// labelTrie indexes hints by label. Hints are kept sorted by label, so the hints below any
+// node are a contiguous range of them. Each inner node owns one block of child slots, one
+// per label byte in use, so stepping to a child is a single array lookup.
+type labelTrie struct {
+	sorted []*Hint
+	nodes  []trieNode
+	slots  []int32
+	// symbols maps a label byte to its slot in a child block; 0 marks bytes no label uses.
+	symbols  [math.MaxUint8 + 1]uint16
+	alphabet int
+}
+
+// trieNode is one label prefix.
+type trieNode struct {
+	// lo and hi bound the sorted hints whose labels start with the prefix.
+	lo, hi int32
+	// children is the first slot of the node's child block, or noChild for leaves.
+	children int32
+}
+
+// newLabelTrie builds the trie of hints, which must be sorted by label.
+func newLabelTrie(sorted []*Hint) *labelTrie {
+	trie := &labelTrie{sorted: sorted}
+	for _, hint := range sorted {
+		for index := range len(hint.Label) {
+			symbol := hint.Label[index]
+			if trie.symbols[symbol] == 0 {
+				trie.alphabet++
+				trie.symbols[symbol] = uint16(trie.alphabet)
+			}
+		}
+	}
+
+	trie.nodes = make([]trieNode, 1, len(sorted)+1)
+	trie.nodes[0] = trieNode{lo: 0, hi: int32(len(sorted)), children: noChild}
+
+	// Nodes are expanded in creation order; each expansion groups the node's range by the
+	// label byte at its depth
+	depths := []int{0}
+	for current := 0; current < len(trie.nodes); current++ {
+		node := trie.nodes[current]
+		depth := depths[current]
+
+		lo := node.lo
+		// Labels ending here sort before their extensions
+		for lo < node.hi && len(sorted[lo].Label) == depth {
+			lo++
+		}
+		if lo == node.hi {
+			continue
+		}
+
+		block := int32(len(trie.slots))
+		for range trie.alphabet {
+			trie.slots = append(trie.slots, noChild)
+		}
+		trie.nodes[current].children = block
+
+		for lo < node.hi {
+			symbol := sorted[lo].Label[depth]
+			hi := lo + 1
+			for hi < node.hi && sorted[hi].Label[depth] == symbol {
+				hi++
+			}
+			trie.slots[block+int32(trie.symbols[symbol])-1] = int32(len(trie.nodes))
+			trie.nodes = append(trie.nodes, trieNode{lo: lo, hi: hi, children: noChild})
+			depths = append(depths, depth+1)
+			lo = hi
+		}
+	}
+
+	return trie
+}
+
+// child returns the child of node for the label byte, or noChild.
+func (t *labelTrie) child(node int32, symbol byte) int32 {
+	block := t.nodes[node].children
+	slot := t.symbols[symbol]
+	if block == noChild || slot == 0 {
+		return noChild
+	}
+	return t.slots[block+int32(slot)-1]
+}
+
+// find returns the node of the prefix, or noChild if no label starts with it.
+func (t *labelTrie) find(prefix string) int32 {
+	node := int32(0)
+	for index := 0; index < len(prefix) && node != noChild; index++ {
+		node = t.child(node, prefix[index])
+	}
+	return node
+}
+
+// hints returns the hints below node. The slice shares the trie's storage.
+func (t *labelTrie) hints(node int32) []*Hint {
+	current := t.nodes[node]
+	return t.sorted[current.lo:current.hi:current.hi]
+}
+
+// exact returns the hint whose label is the prefix of node at depth, if any.
+func (t *labelTrie) exact(node int32, depth int) *Hint {
+	current := t.nodes[node]
+	if current.lo < current.hi && len(t.sorted[current.lo].Label) == depth {
+		return t.sorted[current.lo]
+	}
+	return nil
+}
+
+// Cursor narrows a hint collection one key at a time. It keeps the trie nodes of the typed
+// prefix on a stack, so a key is one child lookup and a backspace one pop. Only the hints
+// below the node entered or left get their matched prefix updated; a step reports the hints
+// below the shallower of its two nodes, the only ones whose match changed.
+type Cursor struct {
+	trie *labelTrie
+	// path holds the nodes of the typed prefix; path[0] is the root.
+	path []int32
+}
+
+// NewCursor returns a cursor at the start of the collection's labels.
+func (hc *HintCollection) NewCursor() *Cursor {
+	return &Cursor{trie: hc.trie, path: []int32{0}}
+}
+
+// Narrow extends the typed prefix by key, which must be uppercase, and marks the hints still
+// matching. It returns the hints that matched before: those still matching have a longer
+// matched prefix, the others stopped matching. It reports false and leaves the cursor
+// unchanged when no label continues with key.
+func (c *Cursor) Narrow(key byte) ([]*Hint, bool) {
+	current := c.node()
+	next := c.trie.child(current, key)
+	if next == noChild {
+		return nil, false
+	}
+
+	c.path = append(c.path, next)
+	c.mark(next)
+	return c.trie.hints(current), true
+}
+
+// Widen drops the last typed key and restores the matched prefix of the hints that matched
+// it. It returns the hints matching now: those that matched before have a shorter matched
+// prefix, the others started matching again. It reports false when nothing was typed.
+func (c *Cursor) Widen() ([]*Hint, bool) {
+	if len(c.path) == 1 {
+		return nil, false
+	}
+
+	left := c.node()
+	c.path = c.path[:len(c.path)-1]
+	c.mark(left)
+	return c.Hints(), true
+}
+
+// Reset drops everything typed.
+func (c *Cursor) Reset() {
+	for len(c.path) > 1 {
+		c.Widen()
+	}
+}
+
+// Hints returns the hints matching the typed prefix, ordered by label. The slice shares the
+// collection's storage and must not be modified.
+func (c *Cursor) Hints() []*Hint {
+	return c.trie.hints(c.node())
+}
+
+// Prefix returns the typed prefix.
+func (c *Cursor) Prefix() string {
+	if len(c.path) == 1 {
+		return ""
+	}
+	node := c.trie.nodes[c.node()]
+	return c.trie.sorted[node.lo].Label[:len(c.path)-1]
+}
+
+// Match returns the hint whose label is exactly the typed prefix when it is the only hint
+// left, or nil.
+func (c *Cursor) Match() *Hint {
+	node := c.trie.nodes[c.node()]
+	if node.hi-node.lo != 1 || len(c.path) == 1 {
+		return nil
+	}
+	return c.trie.exact(c.node(), len(c.path)-1)
+}
+
+// node returns the node of the typed prefix.
+func (c *Cursor) node() int32 {
+	return c.path[len(c.path)-1]
+}
+
+// mark sets the matched prefix of the hints below node to the typed prefix.
+func (c *Cursor) mark(node int32) {
+	prefix := c.Prefix()
+	for _, hint := range c.trie.hints(node) {
+		hint.MatchedPrefix = prefix
+	}
+}
@@ -0,0 +1,53 @@
+package hints
+
+import (
+	"slices"
+	"testing"
+)
+
+// labelsOf returns the labels of hints.
+func labelsOf(hints []*Hint) []string {
+	labels := make([]string, len(hints))
+	for index, hint := range hints {
+		labels[index] = hint.GetLabel()
+	}
+	return labels
+}
+
+// TestCursorReportsChangedHints checks that each step reports the hints whose match changed:
+// those matching before a key, and those matching again after a backspace.
+func TestCursorReportsChangedHints(t *testing.T) {
+	hints, err := NewGenerator("asd").Generate(gridElements(9))
+	if err != nil {
+		t.Fatalf("Generate() error = %v", err)
+	}
+	cursor := NewHintCollection(hints).NewCursor()
+
+	changed, ok := cursor.Narrow('A')
+	if !ok || len(changed) != len(hints) {
+		t.Fatalf("Narrow('A') = %d hints, %v; want all %d", len(changed), ok, len(hints))
+	}
+
+	changed, ok = cursor.Narrow('S')
+	if want := []string{"AA", "AD", "AS"}; !ok || !slices.Equal(labelsOf(changed), want) {
+		t.Fatalf("Narrow('S') = %v, %v; want %v", labelsOf(changed), ok, want)
+	}
+	if labels := labelsOf(cursor.Hints()); !slices.Equal(labels, []string{"AS"}) {
+		t.Errorf("Hints() = %v after AS, want [AS]", labels)
+	}
+
+	changed, ok = cursor.Widen()
+	if want := []string{"AA", "AD", "AS"}; !ok || !slices.Equal(labelsOf(changed), want) {
+		t.Errorf("Widen() = %v, %v; want %v", labelsOf(changed), ok, want)
+	}
+	for _, hint := range changed {
+		if hint.GetMatchedPrefix() != "A" {
+			t.Errorf("%s has matched prefix %q after widening, want A",
+				hint.GetLabel(), hint.GetMatchedPrefix())
+		}
+	}
+
+	if _, ok := cursor.Narrow('Q'); ok {
+		t.Error("Narrow('Q') succeeded, but no label continues with Q")
+	}
+}
@@ -2,8 +2,8 @@ package accessibility
 
 import (
 	"sync"
+	"sync/atomic"
 	"time"
-	"unsafe"
 
 	"github.com/y3owk1n/neru/internal/infra/logger"
 	"go.uber.org/zap"
@@ -13,23 +13,58 @@ import (
 type CachedInfo struct {
 	Info      *ElementInfo
 	ExpiresAt time.Time
+
+	// element holds a retained reference so the identity cannot be recycled while cached.
+	element *Element
+}
+
+// CacheStats summarizes the lookup effectiveness of an InfoCache.
+type CacheStats struct {
+	Hits       uint64
+	Misses     uint64
+	Entries    int
+	Partitions int
+}
+
+// HitRate returns the fraction of lookups served from the cache, or 0 before any lookup.
+func (s CacheStats) HitRate() float64 {
+	total := s.Hits + s.Misses
+	if total == 0 {
+		return 0
+	}
+	return float64(s.Hits) / float64(total)
+}
+
+// cachePartition holds the entries of a single process, keyed by element hash.
+// Entries sharing a hash form a short collision chain resolved with CFEqual.
+type cachePartition struct {
+	mu      sync.RWMutex
+	entries map[uint64][]*CachedInfo
+	// retired is set once the partition is dropped from the cache; entries stored after
+	// that would never be released, so writers fetch a fresh partition instead
+	retired bool
 }
 
 // InfoCache implements a thread-safe time-to-live cache for element information.
+// Entries are keyed by accessibility element identity rather than by Go pointer,
+// so distinct Element values referring to the same UI element share an entry.
 type InfoCache struct {
-	mu      sync.RWMutex
-	data    map[uintptr]*CachedInfo
-	ttl     time.Duration
-	stopCh  chan struct{}
-	stopped bool
+	mu         sync.RWMutex
+	partitions map[int]*cachePartition
+	ttl        time.Duration
+	stopCh     chan struct{}
+	stopped    bool
+
+	hits   atomic.Uint64
+	misses atomic.Uint64
 }
 
 // NewInfoCache initializes a new cache with the specified time-to-live duration.
 func NewInfoCache(ttl time.Duration) *InfoCache {
 	cache := &InfoCache{
-		data:   make(map[uintptr]*CachedInfo, 100),
-		ttl:    ttl,
-		stopCh: make(chan struct{}),
+		partitions: make(map[int]*cachePartition, 8),
+		ttl:        ttl,
+		stopCh:     make(chan struct{}),
 	}
 
 	// Start cleanup goroutine
@@ -40,60 +75,175 @@ func NewInfoCache(ttl time.Duration) *InfoCache {
 
 // Get retrieves a cached element information if it exists and hasn't expired.
 func (c *InfoCache) Get(elem *Element) *ElementInfo {
-	c.mu.RLock()
-	defer c.mu.RUnlock()
+	return c.GetMany([]*Element{elem})[0]
+}
 
-	// #nosec G103 -- Using pointer address as map key is safe for cache
-	key := uintptr(unsafe.Pointer(elem))
-	cached, exists := c.data[key]
+// GetMany looks up several elements at once. The result is index-aligned with elems and
+// holds nil for misses. Identity checks for all candidates of a process share one bridge call.
+func (c *InfoCache) GetMany(elems []*Element) []*ElementInfo {
+	results := make([]*ElementInfo, len(elems))
+	now := time.Now()
 
-	if !exists {
-		return nil
+	// Siblings almost always belong to one process, so walk runs of equal PIDs
+	for start := 0; start < len(elems); {
+		end := start + 1
+		for end < len(elems) && sameProcess(elems[start], elems[end]) {
+			end++
+		}
+		if elems[start] != nil {
+			c.getFromPartition(elems[start].key.pid, elems[start:end], results[start:end], now)
+		}
+		start = end
 	}
 
-	// Check if expired
-	if time.Now().After(cached.ExpiresAt) {
-		return nil
+	var hits, lookups uint64
+	for index, elem := range elems {
+		if elem == nil {
+			continue
+		}
+		lookups++
+		if results[index] != nil {
+			hits++
+		}
 	}
+	c.hits.Add(hits)
+	c.misses.Add(lookups - hits)
 
-	return cached.Info
+	return results
 }
 
 // Set stores element information in the cache with the configured time-to-live.
 func (c *InfoCache) Set(elem *Element, info *ElementInfo) {
-	c.mu.Lock()
-	defer c.mu.Unlock()
-
-	// #nosec G103 -- Using pointer address as map key is safe for cache
-	key := uintptr(unsafe.Pointer(elem))
-	expiresAt := time.Now().Add(c.ttl)
-	c.data[key] = &CachedInfo{
-		Info:      info,
-		ExpiresAt: expiresAt,
+	if elem == nil || elem.ref == nil {
+		return
 	}
 
+	now := time.Now()
+	expiresAt := now.Add(c.ttl)
+
+	part := c.lockPartition(elem.key.pid)
+	part.store(elem.retain(), info, now, expiresAt)
+	part.mu.Unlock()
+
 	logger.Debug("Cached element info",
-		zap.Uintptr("element_ptr", key),
+		zap.Uint64("element_hash", elem.key.hash),
+		zap.Int("pid", elem.key.pid),
 		zap.String("role", info.Role),
-		zap.String("title", info.Title),
 		zap.Time("expires_at", expiresAt))
 }
 
+// SetMany stores the information of several elements, index-aligned with elems. Elements
+// whose info is nil are skipped. Each partition is locked once per run of its elements.
+func (c *InfoCache) SetMany(elems []*Element, infos []*ElementInfo) {
+	now := time.Now()
+	expiresAt := now.Add(c.ttl)
+
+	var part *cachePartition
+	partPID := 0
+	stored := 0
+	for index, elem := range elems {
+		if elem == nil || elem.ref == nil || infos[index] == nil {
+			continue
+		}
+		if part != nil && partPID != elem.key.pid {
+			part.mu.Unlock()
+			part = nil
+		}
+		if part == nil {
+			part, partPID = c.lockPartition(elem.key.pid), elem.key.pid
+		}
+		part.store(elem.retain(), infos[index], now, expiresAt)
+		stored++
+	}
+	if part != nil {
+		part.mu.Unlock()
+	}
+
+	if stored > 0 {
+		logger.Debug("Cached element infos",
+			zap.Int("entries", stored),
+			zap.Time("expires_at", expiresAt))
+	}
+}
+
 // Size returns the current number of entries in the cache.
 func (c *InfoCache) Size() int {
 	c.mu.RLock()
 	defer c.mu.RUnlock()
-	return len(c.data)
+
+	size := 0
+	for _, part := range c.partitions {
+		part.mu.RLock()
+		for _, chain := range part.entries {
+			size += len(chain)
+		}
+		part.mu.RUnlock()
+	}
+	return size
+}
+
+// Stats returns the cumulative hit and miss counts together with the current size.
+func (c *InfoCache) Stats() CacheStats {
+	c.mu.RLock()
+	partitions := len(c.partitions)
+	c.mu.RUnlock()
+
+	return CacheStats{
+		Hits:       c.hits.Load(),
+		Misses:     c.misses.Load(),
+		Entries:    c.Size(),
+		Partitions: partitions,
+	}
 }
 
 // Clear removes all entries from the cache.
 func (c *InfoCache) Clear() {
 	c.mu.Lock()
-	defer c.mu.Unlock()
-	c.data = make(map[uintptr]*CachedInfo, 100)
+	partitions := c.partitions
+	c.partitions = make(map[int]*cachePartition, 8)
+	c.mu.Unlock()
+
+	for _, part := range partitions {
+		part.releaseAll()
+	}
 	logger.Debug("Cache cleared")
 }
 
+// Remove drops the entries of the given elements. Entries that merely share an
+// element's hash are dropped as well, which is harmless for a cache.
+func (c *InfoCache) Remove(elems []*Element) {
+	for _, elem := range elems {
+		if elem == nil {
+			continue
+		}
+
+		part := c.partition(elem.key.pid, false)
+		if part == nil {
+			continue
+		}
+
+		part.mu.Lock()
+		for _, cached := range part.entries[elem.key.hash] {
+			cached.element.Release()
+		}
+		delete(part.entries, elem.key.hash)
+		part.mu.Unlock()
+	}
+}
+
+// InvalidatePID removes all entries belonging to the given process.
+func (c *InfoCache) InvalidatePID(pid int) {
+	c.mu.Lock()
+	part := c.partitions[pid]
+	delete(c.partitions, pid)
+	c.mu.Unlock()
+
+	if part != nil {
+		part.releaseAll()
+		logger.Debug("Cache partition invalidated", zap.Int("pid", pid))
+	}
+}
+
 // Stop terminates the cache cleanup goroutine and releases resources.
 func (c *InfoCache) Stop() {
 	if !c.stopped {
@@ -103,6 +253,94 @@ func (c *InfoCache) Stop() {
 	}
 }
 
+// partition returns the partition for a process, creating it when requested.
+func (c *InfoCache) partition(pid int, create bool) *cachePartition {
+	c.mu.RLock()
+	part := c.partitions[pid]
+	c.mu.RUnlock()
+	if part != nil || !create {
+		return part
+	}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	part = c.partitions[pid]
+	if part == nil {
+		part = &cachePartition{entries: make(map[uint64][]*CachedInfo, 100)}
+		c.partitions[pid] = part
+	}
+	return part
+}
+
+// lockPartition returns the live partition for a process with its write lock held, creating
+// it when missing. A partition retired between the lookup and the lock is skipped.
+func (c *InfoCache) lockPartition(pid int) *cachePartition {
+	for {
+		part := c.partition(pid, true)
+		part.mu.Lock()
+		if !part.retired {
+			return part
+		}
+		part.mu.Unlock()
+	}
+}
+
+// getFromPartition resolves lookups for elements of a single process.
+// The partition read lock is held across the identity check so that cached
+// references cannot be released while they are being compared.
+func (c *InfoCache) getFromPartition(
+	pid int,
+	elems []*Element,
+	results []*ElementInfo,
+	now time.Time,
+) {
+	part := c.partition(pid, false)
+	if part == nil {
+		return
+	}
+
+	part.mu.RLock()
+	defer part.mu.RUnlock()
+
+	var candidates, probes []*Element
+	var candidateInfos []*ElementInfo
+	var pending []int
+
+	for index, elem := range elems {
+		if elem == nil || elem.ref == nil {
+			continue
+		}
+
+		for _, cached := range part.entries[elem.key.hash] {
+			if !now.Before(cached.ExpiresAt) {
+				continue
+			}
+
+			// Same reference needs no bridge round-trip
+			if cached.element.ref == elem.ref {
+				results[index] = cached.Info
+				break
+			}
+
+			candidates = append(candidates, cached.element)
+			probes = append(probes, elem)
+			candidateInfos = append(candidateInfos, cached.Info)
+			pending = append(pending, index)
+		}
+	}
+
+	if len(pending) == 0 {
+		return
+	}
+
+	for pendingIndex, equal := range elementsEqual(candidates, probes) {
+		index := pending[pendingIndex]
+		if equal && results[index] == nil {
+			results[index] = candidateInfos[pendingIndex]
+		}
+	}
+}
+
 // cleanupLoop runs a periodic cleanup process to remove expired cache entries.
 func (c *InfoCache) cleanupLoop() {
 	ticker := time.NewTicker(c.ttl / 2) // Cleanup at half the TTL interval
@@ -121,27 +359,105 @@ func (c *InfoCache) cleanupLoop() {
 
 // cleanup removes all expired entries from the cache.
 func (c *InfoCache) cleanup() {
+	now := time.Now()
+
 	c.mu.Lock()
 	defer c.mu.Unlock()
 
-	now := time.Now()
-	// Pre-allocate slice for keys to delete
-	toDelete := make([]uintptr, 0, len(c.data)/4) // Estimate 25% might be expired
+	removed := 0
+	remaining := 0
+	for pid, part := range c.partitions {
+		partRemoved, partRemaining := part.removeExpired(now)
+		removed += partRemoved
+		remaining += partRemaining
 
-	for key, cached := range c.data {
-		if now.After(cached.ExpiresAt) {
-			toDelete = append(toDelete, key)
+		// Drop partitions of processes that no longer have live entries; removeExpired
+		// retired them under their own lock so no concurrent Set can still store into them
+		if partRemaining == 0 {
+			delete(c.partitions, pid)
 		}
 	}
 
-	// Batch delete
-	for _, key := range toDelete {
-		delete(c.data, key)
+	if removed > 0 {
+		logger.Debug("Cache cleanup completed",
+			zap.Int("removed_entries", removed),
+			zap.Int("remaining_entries", remaining),
+			zap.Int("partitions", len(c.partitions)))
 	}
+}
 
-	if len(toDelete) > 0 {
-		logger.Debug("Cache cleanup completed",
-			zap.Int("removed_entries", len(toDelete)),
-			zap.Int("remaining_entries", len(c.data)))
+// removeExpired drops expired entries and returns the removed and remaining counts. A
+// partition left empty is retired.
+func (p *cachePartition) removeExpired(now time.Time) (int, int) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	removed := 0
+	remaining := 0
+	for hash, chain := range p.entries {
+		kept := chain[:0]
+		for _, cached := range chain {
+			if now.After(cached.ExpiresAt) {
+				cached.element.Release()
+				removed++
+				continue
+			}
+			kept = append(kept, cached)
+		}
+
+		if len(kept) == 0 {
+			delete(p.entries, hash)
+		} else {
+			p.entries[hash] = kept
+		}
+		remaining += len(kept)
+	}
+	p.retired = remaining == 0
+
+	return removed, remaining
+}
+
+// store adds an entry holding retained, replacing expired entries and any entry held through
+// the same reference. It runs with p.mu held.
+func (p *cachePartition) store(
+	retained *Element,
+	info *ElementInfo,
+	now, expiresAt time.Time,
+) {
+	chain := p.entries[retained.key.hash]
+	kept := chain[:0]
+	for _, cached := range chain {
+		if cached.element.ref == retained.ref || !now.Before(cached.ExpiresAt) {
+			cached.element.Release()
+			continue
+		}
+		kept = append(kept, cached)
+	}
+	p.entries[retained.key.hash] = append(kept, &CachedInfo{
+		Info:      info,
+		ExpiresAt: expiresAt,
+		element:   retained,
+	})
+}
+
+// releaseAll drops every entry, releases the retained references and retires the partition.
+func (p *cachePartition) releaseAll() {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	p.retired = true
+	for _, chain := range p.entries {
+		for _, cached := range chain {
+			cached.element.Release()
+		}
+	}
+	p.entries = make(map[uint64][]*CachedInfo)
+}
+
+// sameProcess reports whether two elements belong to the same process partition.
+func sameProcess(a, b *Element) bool {
+	if a == nil || b == nil {
+		return a == b
 	}
+	return a.key.pid == b.key.pid
 }
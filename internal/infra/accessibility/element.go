@@ -1,19 +1,11 @@
 package accessibility
 
-/*
-#cgo CFLAGS: -x objective-c
-#include "../bridge/accessibility.h"
-#include <stdlib.h>
-*/
-import "C"
-
 import (
 	"errors"
-	"fmt"
 	"image"
 	"sort"
 	"strings"
-	"sync"
+	"sync/atomic"
 	"unsafe"
 
 	"github.com/y3owk1n/neru/internal/config"
@@ -24,15 +16,25 @@ import (
 // Element represents a UI element in the macOS accessibility hierarchy.
 type Element struct {
 	ref unsafe.Pointer
+	key elementKey
+	// owner is the scope that releases ref, or nil when the caller owns the element. It only
+	// changes with the owning scope's lock held.
+	owner atomic.Pointer[Scope]
 }
 
-var (
-	clickableRoles   = make(map[string]struct{})
-	clickableRolesMu sync.RWMutex
+// elementKey identifies an accessibility element independently of the reference holding it.
+// Distinct references to the same element share a key; equal keys are confirmed with CFEqual.
+type elementKey struct {
+	hash uint64
+	pid  int
+}
 
+// clickableRoles is swapped atomically by SetClickableRoles and read lock-free per node.
+var clickableRoles atomic.Pointer[RoleSet]
+
+var (
 	// Pre-allocated common errors.
 	errElementNil      = errors.New("element reference is nil")
-	errGetChildrenNil  = errors.New("cannot get children: element reference is nil")
 	errSetFocusNil     = errors.New("cannot set focus: element reference is nil")
 	errSetFocusFailed  = errors.New("failed to set focus on element")
 	errGetAttributeNil = errors.New("cannot get attribute: element reference is nil")
@@ -42,102 +44,59 @@ var (
 
 // SetClickableRoles configures which accessibility roles are treated as clickable.
 func SetClickableRoles(roles []string) {
-	clickableRolesMu.Lock()
-	defer clickableRolesMu.Unlock()
-
-	clickableRoles = make(map[string]struct{}, len(roles))
+	trimmed := make([]string, 0, len(roles))
 	for _, role := range roles {
-		trimmed := strings.TrimSpace(role)
-		if trimmed == "" {
+		role = strings.TrimSpace(role)
+		if role == "" {
 			continue
 		}
-		clickableRoles[trimmed] = struct{}{}
+		trimmed = append(trimmed, role)
 	}
 
+	set := NewRoleSet(trimmed...)
+	clickableRoles.Store(&set)
+
 	logger.Debug("Updated clickable roles",
-		zap.Int("count", len(clickableRoles)),
+		zap.Int("count", set.Len()),
 		zap.Strings("roles", roles))
 }
 
 // GetClickableRoles returns the configured clickable roles.
 func GetClickableRoles() []string {
-	clickableRolesMu.RLock()
-	defer clickableRolesMu.RUnlock()
-
-	// Pre-allocate with exact capacity
-	roles := make([]string, 0, len(clickableRoles))
-	for role := range clickableRoles {
-		roles = append(roles, role)
+	set := clickableRoles.Load()
+	if set == nil {
+		return []string{}
 	}
+
+	roles := set.Names()
 	sort.Strings(roles)
 	return roles
 }
 
-// ElementInfo contains metadata and positioning information for a UI element.
+// ElementInfo contains the positioning and role of a UI element, which is all that tree
+// traversal and filtering need. Descriptive attributes are fetched on demand with GetAttributes.
 type ElementInfo struct {
-	Position        image.Point
-	Size            image.Point
+	Position image.Point
+	Size     image.Point
+	Role     string
+	RoleID   RoleID
+	PID      int
+}
+
+// ElementAttributes contains descriptive attributes of a UI element.
+type ElementAttributes struct {
 	Title           string
-	Role            string
 	RoleDescription string
 	IsEnabled       bool
 	IsFocused       bool
-	PID             int
-}
-
-// CheckAccessibilityPermissions verifies that the application has been granted accessibility permissions.
-func CheckAccessibilityPermissions() bool {
-	result := C.checkAccessibilityPermissions()
-	return result == 1
-}
-
-// GetSystemWideElement returns the system-wide accessibility element representing the entire screen.
-func GetSystemWideElement() *Element {
-	ref := C.getSystemWideElement()
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
-}
-
-// GetFocusedApplication returns the currently focused application element.
-func GetFocusedApplication() *Element {
-	ref := C.getFocusedApplication()
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
-}
-
-// GetApplicationByPID returns an application element identified by its process ID.
-func GetApplicationByPID(pid int) *Element {
-	ref := C.getApplicationByPID(C.int(pid))
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
-}
-
-// GetApplicationByBundleID returns an application element identified by its bundle identifier.
-func GetApplicationByBundleID(bundleID string) *Element {
-	cBundle := C.CString(bundleID)
-	defer C.free(unsafe.Pointer(cBundle))
-
-	ref := C.getApplicationByBundleId(cBundle)
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
 }
 
-// GetElementAtPosition returns the UI element at the specified screen coordinates.
-func GetElementAtPosition(x, y int) *Element {
-	pos := C.CGPoint{x: C.double(x), y: C.double(y)}
-	ref := C.getElementAtPosition(pos)
-	if ref == nil {
-		return nil
+// elementsEqual reports, pairwise, whether two element lists refer to the same elements.
+func elementsEqual(first, second []*Element) []bool {
+	if len(first) == 0 || len(first) != len(second) {
+		return make([]bool, len(first))
 	}
-	return &Element{ref: ref}
+	return currentProvider().Equal(first, second)
 }
 
 // GetInfo retrieves metadata and positioning information for the element.
@@ -145,189 +104,50 @@ func (e *Element) GetInfo() (*ElementInfo, error) {
 	if e.ref == nil {
 		return nil, errGetInfoNil
 	}
-
-	cInfo := C.getElementInfo(e.ref)
-	if cInfo == nil {
-		return nil, errGetInfoFailed
-	}
-	defer C.freeElementInfo(cInfo)
-
-	info := &ElementInfo{
-		Position: image.Point{
-			X: int(cInfo.position.x),
-			Y: int(cInfo.position.y),
-		},
-		Size: image.Point{
-			X: int(cInfo.size.width),
-			Y: int(cInfo.size.height),
-		},
-		IsEnabled: bool(cInfo.isEnabled),
-		IsFocused: bool(cInfo.isFocused),
-		PID:       int(cInfo.pid),
-	}
-
-	if cInfo.title != nil {
-		info.Title = C.GoString(cInfo.title)
-	}
-	if cInfo.role != nil {
-		info.Role = C.GoString(cInfo.role)
-	}
-	if cInfo.roleDescription != nil {
-		info.RoleDescription = C.GoString(cInfo.roleDescription)
-	}
-
-	return info, nil
+	return currentProvider().Info(e)
 }
 
-// GetChildren returns all child elements of this element.
-func (e *Element) GetChildren() ([]*Element, error) {
+// childrenWithInfo returns the children of the element together with their info using a
+// single provider call. roleID is the element's own role, which selects visible rows for lists,
+// tables and outlines. timedOut reports that the application did not answer a request within
+// its messaging timeout.
+func (e *Element) childrenWithInfo(roleID RoleID) ([]*Element, []*ElementInfo, bool) {
 	if e.ref == nil {
-		return nil, errGetChildrenNil
-	}
-
-	var count C.int
-	var rawChildren unsafe.Pointer
-
-	info := globalCache.Get(e)
-	if info == nil {
-		var err error
-		info, err = e.GetInfo()
-		if err != nil {
-			return nil, fmt.Errorf("failed to get element info: %w", err)
-		}
-		globalCache.Set(e, info)
+		return nil, nil, false
 	}
-
-	if info != nil {
-		switch info.Role {
-		case "AXList", "AXTable", "AXOutline":
-			ptr := unsafe.Pointer(C.getVisibleRows(e.ref, &count))
-			if ptr != nil {
-				rawChildren = ptr
-			} else {
-				rawChildren = unsafe.Pointer(C.getChildren(e.ref, &count))
-			}
-		default:
-			rawChildren = unsafe.Pointer(C.getChildren(e.ref, &count))
-		}
-	}
-
-	if rawChildren == nil || count == 0 {
-		return nil, nil
-	}
-	defer C.free(rawChildren)
-
-	childSlice := (*[1 << 30]unsafe.Pointer)(rawChildren)[:count:count]
-	// Pre-allocate and directly create elements
-	children := make([]*Element, int(count))
-	for i := range int(count) {
-		children[i] = &Element{ref: childSlice[i]}
-	}
-
-	return children, nil
+	return currentProvider().ChildrenWithInfo(e, roleID)
 }
 
-// SetFocus sets focus to the element.
-func (e *Element) SetFocus() error {
+// retain returns a new Element holding its own reference to the same accessibility element.
+func (e *Element) retain() *Element {
 	if e.ref == nil {
-		return errSetFocusNil
-	}
-
-	result := C.setFocus(e.ref)
-	if result == 0 {
-		return errSetFocusFailed
-	}
-	return nil
-}
-
-// GetAttribute gets a custom attribute value.
-func (e *Element) GetAttribute(name string) (string, error) {
-	if e.ref == nil {
-		return "", errGetAttributeNil
-	}
-
-	cName := C.CString(name)
-	defer C.free(unsafe.Pointer(cName))
-
-	cValue := C.getElementAttribute(e.ref, cName)
-	if cValue == nil {
-		return "", fmt.Errorf("attribute %q not found on element", name)
+		return nil
 	}
-	defer C.freeString(cValue)
-
-	return C.GoString(cValue), nil
+	trackRefs(1)
+	return &Element{ref: currentProvider().Retain(e.ref), key: e.key}
 }
 
-// Release releases the element reference.
+// Release releases the element reference. Elements owned by a scope may be released early;
+// the scope skips them when it closes.
 func (e *Element) Release() {
 	if e.ref != nil {
-		C.releaseElement(e.ref)
+		releaseRefs([]unsafe.Pointer{e.ref})
 		e.ref = nil
 	}
 }
 
 // ReleaseAll releases all elements in a slice.
 func ReleaseAll(elements []*Element) {
-	for _, elem := range elements {
-		if elem != nil {
-			elem.Release()
-		}
-	}
+	ReleaseElements(elements)
 }
 
-// GetAllWindows returns all windows of the focused application.
-func GetAllWindows() ([]*Element, error) {
-	var count C.int
-	windows := C.getAllWindows(&count)
-	if windows == nil || count == 0 {
-		return []*Element{}, nil
-	}
-	defer C.free(unsafe.Pointer(windows))
-
-	windowSlice := (*[1 << 30]unsafe.Pointer)(unsafe.Pointer(windows))[:count:count]
-	result := make([]*Element, count)
-
-	for i := range result {
-		result[i] = &Element{ref: windowSlice[i]}
-	}
-
-	return result, nil
-}
-
-// GetFrontmostWindow returns the frontmost window.
+// GetFrontmostWindow returns the frontmost window, owned by the active scope if any.
 func GetFrontmostWindow() *Element {
-	ref := C.getFrontmostWindow()
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
-}
-
-// GetMenuBar returns the menu bar element for the given application element.
-func (e *Element) GetMenuBar() *Element {
-	if e.ref == nil {
-		return nil
-	}
-	ref := C.getMenuBar(e.ref)
-	if ref == nil {
-		return nil
-	}
-	return &Element{ref: ref}
-}
-
-// GetApplicationName returns the application name.
-func (e *Element) GetApplicationName() string {
-	if e.ref == nil {
-		return ""
-	}
-
-	cName := C.getApplicationName(e.ref)
-	if cName == nil {
-		return ""
+	window := currentProvider().FrontmostWindow()
+	if window != nil {
+		activeScope.Load().own([]*Element{window})
 	}
-	defer C.freeString(cName)
-
-	return C.GoString(cName)
+	return window
 }
 
 // GetBundleIdentifier returns the bundle identifier.
@@ -335,133 +155,22 @@ func (e *Element) GetBundleIdentifier() string {
 	if e.ref == nil {
 		return ""
 	}
-
-	cBundleID := C.getBundleIdentifier(e.ref)
-	if cBundleID == nil {
-		return ""
-	}
-	defer C.freeString(cBundleID)
-
-	return C.GoString(cBundleID)
+	return currentProvider().BundleIdentifier(e)
 }
 
-// GetScrollBounds returns the scroll area bounds.
-func (e *Element) GetScrollBounds() image.Rectangle {
-	if e.ref == nil {
-		return image.Rectangle{}
-	}
-
-	rect := C.getScrollBounds(e.ref)
-	return image.Rectangle{
-		Min: image.Point{
-			X: int(rect.origin.x),
-			Y: int(rect.origin.y),
-		},
-		Max: image.Point{
-			X: int(rect.origin.x + rect.size.width),
-			Y: int(rect.origin.y + rect.size.height),
-		},
-	}
-}
-
-// MoveMouseToPoint moves the cursor to a specific screen point.
-// If smooth cursor movement is enabled in the configuration, it will use smooth movement.
-func MoveMouseToPoint(p image.Point) {
-	cfg := config.Global()
-	if cfg != nil && cfg.SmoothCursor.MoveMouseEnabled {
-		// Use smooth movement
-		MoveMouseToPointSmooth(p, cfg.SmoothCursor.Steps, cfg.SmoothCursor.Delay)
-	} else {
-		// Use direct movement
-		pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-		C.moveMouse(pos)
-	}
-}
-
-// MoveMouseToPointSmooth moves the cursor smoothly to a specific screen point.
-func MoveMouseToPointSmooth(end image.Point, steps, delay int) {
-	start := GetCurrentCursorPosition()
-	startPos := C.CGPoint{x: C.double(start.X), y: C.double(start.Y)}
-	endPos := C.CGPoint{x: C.double(end.X), y: C.double(end.Y)}
-	C.moveMouseSmooth(startPos, endPos, C.int(steps), C.int(delay))
-}
-
-// LeftClickAtPoint performs a left mouse click at the specified point.
-func LeftClickAtPoint(p image.Point, restoreCursor bool) error {
-	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-	result := C.performLeftClickAtPosition(pos, C.bool(restoreCursor))
-	if result == 0 {
-		return fmt.Errorf("failed to perform left-click at position (%d, %d)", p.X, p.Y)
-	}
-	return nil
-}
-
-// RightClickAtPoint performs a right mouse click at the specified point.
-func RightClickAtPoint(p image.Point, restoreCursor bool) error {
-	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-	result := C.performRightClickAtPosition(pos, C.bool(restoreCursor))
-	if result == 0 {
-		return fmt.Errorf("failed to perform right-click at position (%d, %d)", p.X, p.Y)
-	}
-	return nil
-}
-
-// MiddleClickAtPoint performs a middle mouse click at the specified point.
-func MiddleClickAtPoint(p image.Point, restoreCursor bool) error {
-	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-	result := C.performMiddleClickAtPosition(pos, C.bool(restoreCursor))
-	if result == 0 {
-		return fmt.Errorf("failed to perform middle-click at position (%d, %d)", p.X, p.Y)
-	}
-	return nil
-}
-
-// LeftMouseDownAtPoint performs a left mouse down action at the specified point.
-func LeftMouseDownAtPoint(p image.Point) error {
-	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-	result := C.performLeftMouseDownAtPosition(pos)
-	if result == 0 {
-		return fmt.Errorf("failed to perform left-mouse-down at position (%d, %d)", p.X, p.Y)
-	}
-	return nil
-}
-
-// LeftMouseUpAtPoint performs a left mouse up action at the specified point.
-func LeftMouseUpAtPoint(p image.Point) error {
-	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
-	result := C.performLeftMouseUpAtPosition(pos)
-	if result == 0 {
-		return fmt.Errorf("failed to perform left-mouse-up at position (%d, %d)", p.X, p.Y)
-	}
-	return nil
-}
-
-// LeftMouseUp performs a left mouse up action at the current cursor position.
-func LeftMouseUp() error {
-	result := C.performLeftMouseUpAtCursor()
-	if result == 0 {
-		return errors.New("failed to perform left-mouse-up at cursor")
-	}
-	return nil
-}
-
-// ScrollAtCursor scrolls the element at the current cursor position by the specified deltas.
-func ScrollAtCursor(deltaX, deltaY int) error {
-	result := C.scrollAtCursor(C.int(deltaX), C.int(deltaY))
-	if result == 0 {
-		return fmt.Errorf("failed to scroll at cursor with delta (%d, %d)", deltaX, deltaY)
-	}
-	return nil
-}
-
-// GetCurrentCursorPosition returns the current cursor position in screen coordinates.
-func GetCurrentCursorPosition() image.Point {
-	pos := C.getCurrentCursorPosition()
-	return image.Point{X: int(pos.x), Y: int(pos.y)}
+// GetPID returns the process ID of the application the element belongs to.
+func (e *Element) GetPID() int {
+	return e.key.pid
 }
 
 // IsClickable checks if the element is clickable.
 func (e *Element) IsClickable() bool {
+	return e.isClickable(nil)
+}
+
+// isClickable implements IsClickable. Tree walkers pass the info they already hold;
+// a nil info is looked up in the shared cache.
+func (e *Element) isClickable(info *ElementInfo) bool {
 	if e.ref == nil {
 		return false
 	}
@@ -489,7 +198,9 @@ func (e *Element) IsClickable() bool {
 		}
 	}
 
-	info := globalCache.Get(e)
+	if info == nil {
+		info = globalCache.Get(e)
+	}
 	if info == nil {
 		var err error
 		info, err = e.GetInfo()
@@ -500,23 +211,18 @@ func (e *Element) IsClickable() bool {
 	}
 
 	// First check if the role is in the clickable roles list
-	clickableRolesMu.RLock()
-	_, ok := clickableRoles[info.Role]
-	clickableRolesMu.RUnlock()
-
-	if ok {
-		// Also verify it actually has click action
-		result := C.hasClickAction(e.ref)
-		return result == 1
+	if roles := clickableRoles.Load(); roles != nil && roles.Has(info.RoleID) {
+		// Also verify it actually has click action; coverage comes from the window snapshot
+		release := appLimiter.Acquire(e.key.pid)
+		action := currentProvider().ClickAction(e)
+		release()
+		switch action {
+		case ClickActionPresent:
+			return true
+		case ClickActionIfVisible:
+			return centerVisible(info)
+		}
 	}
 
 	return false
 }
-
-// IsClickable checks if the element is clickable
-
-// IsMissionControlActive checks if Mission Control is currently active.
-func IsMissionControlActive() bool {
-	result := C.isMissionControlActive()
-	return bool(result)
-}
@@ -0,0 +1,356 @@
+package accessibility
+
+/*
+#cgo CFLAGS: -x objective-c
+#include "../bridge/accessibility.h"
+#include <stdlib.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"fmt"
+	"image"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/config"
+)
+
+// newElement wraps a single accessibility reference and resolves its identity.
+func newElement(ref unsafe.Pointer) *Element {
+	return newElements([]unsafe.Pointer{ref})[0]
+}
+
+// newElements wraps accessibility references like wrapElements and hands them to the active
+// scope, if any.
+func newElements(refs []unsafe.Pointer) []*Element {
+	elements := wrapElements(refs)
+	activeScope.Load().own(elements)
+	return elements
+}
+
+// wrapElements wraps accessibility references, resolving all identities with one bridge call.
+// The Elements share a single backing allocation and belong to the caller.
+func wrapElements(refs []unsafe.Pointer) []*Element {
+	elements := make([]*Element, len(refs))
+	if len(refs) == 0 {
+		return elements
+	}
+
+	identities := make([]C.ElementIdentity, len(refs))
+	C.getElementIdentities(&refs[0], C.int(len(refs)), &identities[0])
+
+	backing := make([]Element, len(refs))
+	for i, ref := range refs {
+		backing[i] = Element{
+			ref: ref,
+			key: elementKey{
+				hash: uint64(identities[i].hash),
+				pid:  int(identities[i].pid),
+			},
+		}
+		elements[i] = &backing[i]
+	}
+	trackRefs(len(elements))
+
+	return elements
+}
+
+// CheckAccessibilityPermissions verifies that the application has been granted accessibility permissions.
+func CheckAccessibilityPermissions() bool {
+	result := C.checkAccessibilityPermissions()
+	return result == 1
+}
+
+// GetSystemWideElement returns the system-wide accessibility element representing the entire screen.
+func GetSystemWideElement() *Element {
+	ref := C.getSystemWideElement()
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetFocusedApplication returns the currently focused application element.
+func GetFocusedApplication() *Element {
+	ref := C.getFocusedApplication()
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetApplicationByPID returns an application element identified by its process ID.
+func GetApplicationByPID(pid int) *Element {
+	ref := C.getApplicationByPID(C.int(pid))
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetApplicationByBundleID returns an application element identified by its bundle identifier.
+func GetApplicationByBundleID(bundleID string) *Element {
+	cBundle := C.CString(bundleID)
+	defer C.free(unsafe.Pointer(cBundle))
+
+	ref := C.getApplicationByBundleId(cBundle)
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetElementAtPosition returns the UI element at the specified screen coordinates.
+func GetElementAtPosition(x, y int) *Element {
+	pos := C.CGPoint{x: C.double(x), y: C.double(y)}
+	ref := C.getElementAtPosition(pos)
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetAttributes retrieves the descriptive attributes of the element. They are not cached.
+func (e *Element) GetAttributes() (*ElementAttributes, error) {
+	if e.ref == nil {
+		return nil, errGetInfoNil
+	}
+
+	cAttributes := C.getElementAttributes(e.ref)
+	if cAttributes == nil {
+		return nil, errGetInfoFailed
+	}
+	defer C.freeElementAttributes(cAttributes)
+
+	attributes := &ElementAttributes{
+		IsEnabled: bool(cAttributes.isEnabled),
+		IsFocused: bool(cAttributes.isFocused),
+	}
+	if cAttributes.title != nil {
+		attributes.Title = C.GoString(cAttributes.title)
+	}
+	if cAttributes.roleDescription != nil {
+		attributes.RoleDescription = C.GoString(cAttributes.roleDescription)
+	}
+
+	return attributes, nil
+}
+
+// infoError returns why the attributes of a bridge ElementInfo could not be fetched, or nil.
+func infoError(cInfo *C.ElementInfo) error {
+	if cInfo.axError == 0 {
+		return nil
+	}
+	return fmt.Errorf("%w: AXError %d", errGetInfoFailed, int(cInfo.axError))
+}
+
+// elementInfoFromC converts the non-string fields and the interned role of a bridge ElementInfo.
+func elementInfoFromC(cInfo *C.ElementInfo) ElementInfo {
+	roleID, role := roleFromC(cInfo)
+	return ElementInfo{
+		Role:   role,
+		RoleID: roleID,
+		Position: image.Point{
+			X: int(cInfo.position.x),
+			Y: int(cInfo.position.y),
+		},
+		Size: image.Point{
+			X: int(cInfo.size.width),
+			Y: int(cInfo.size.height),
+		},
+		PID: int(cInfo.pid),
+	}
+}
+
+// SetFocus sets focus to the element.
+func (e *Element) SetFocus() error {
+	if e.ref == nil {
+		return errSetFocusNil
+	}
+
+	result := C.setFocus(e.ref)
+	if result == 0 {
+		return errSetFocusFailed
+	}
+	return nil
+}
+
+// GetAttribute gets a custom attribute value.
+func (e *Element) GetAttribute(name string) (string, error) {
+	if e.ref == nil {
+		return "", errGetAttributeNil
+	}
+
+	cName := C.CString(name)
+	defer C.free(unsafe.Pointer(cName))
+
+	cValue := C.getElementAttribute(e.ref, cName)
+	if cValue == nil {
+		return "", fmt.Errorf("attribute %q not found on element", name)
+	}
+	defer C.freeString(cValue)
+
+	return C.GoString(cValue), nil
+}
+
+// GetAllWindows returns all windows of the focused application.
+func GetAllWindows() ([]*Element, error) {
+	var count C.int
+	windows := C.getAllWindows(&count)
+	if windows == nil || count == 0 {
+		return []*Element{}, nil
+	}
+	defer C.free(unsafe.Pointer(windows))
+
+	windowSlice := (*[1 << 30]unsafe.Pointer)(unsafe.Pointer(windows))[:count:count]
+	return newElements(windowSlice), nil
+}
+
+// GetMenuBar returns the menu bar element for the given application element.
+func (e *Element) GetMenuBar() *Element {
+	if e.ref == nil {
+		return nil
+	}
+	ref := C.getMenuBar(e.ref)
+	if ref == nil {
+		return nil
+	}
+	return newElement(ref)
+}
+
+// GetApplicationName returns the application name.
+func (e *Element) GetApplicationName() string {
+	if e.ref == nil {
+		return ""
+	}
+
+	cName := C.getApplicationName(e.ref)
+	if cName == nil {
+		return ""
+	}
+	defer C.freeString(cName)
+
+	return C.GoString(cName)
+}
+
+// GetScrollBounds returns the scroll area bounds.
+func (e *Element) GetScrollBounds() image.Rectangle {
+	if e.ref == nil {
+		return image.Rectangle{}
+	}
+
+	rect := C.getScrollBounds(e.ref)
+	return image.Rectangle{
+		Min: image.Point{
+			X: int(rect.origin.x),
+			Y: int(rect.origin.y),
+		},
+		Max: image.Point{
+			X: int(rect.origin.x + rect.size.width),
+			Y: int(rect.origin.y + rect.size.height),
+		},
+	}
+}
+
+// MoveMouseToPoint moves the cursor to a specific screen point.
+// If smooth cursor movement is enabled in the configuration, it will use smooth movement.
+func MoveMouseToPoint(p image.Point) {
+	cfg := config.Global()
+	if cfg != nil && cfg.SmoothCursor.MoveMouseEnabled {
+		// Use smooth movement
+		MoveMouseToPointSmooth(p, cfg.SmoothCursor.Steps, cfg.SmoothCursor.Delay)
+	} else {
+		// Use direct movement
+		pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+		C.moveMouse(pos)
+	}
+}
+
+// MoveMouseToPointSmooth moves the cursor smoothly to a specific screen point.
+func MoveMouseToPointSmooth(end image.Point, steps, delay int) {
+	start := GetCurrentCursorPosition()
+	startPos := C.CGPoint{x: C.double(start.X), y: C.double(start.Y)}
+	endPos := C.CGPoint{x: C.double(end.X), y: C.double(end.Y)}
+	C.moveMouseSmooth(startPos, endPos, C.int(steps), C.int(delay))
+}
+
+// LeftClickAtPoint performs a left mouse click at the specified point.
+func LeftClickAtPoint(p image.Point, restoreCursor bool) error {
+	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+	result := C.performLeftClickAtPosition(pos, C.bool(restoreCursor))
+	if result == 0 {
+		return fmt.Errorf("failed to perform left-click at position (%d, %d)", p.X, p.Y)
+	}
+	return nil
+}
+
+// RightClickAtPoint performs a right mouse click at the specified point.
+func RightClickAtPoint(p image.Point, restoreCursor bool) error {
+	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+	result := C.performRightClickAtPosition(pos, C.bool(restoreCursor))
+	if result == 0 {
+		return fmt.Errorf("failed to perform right-click at position (%d, %d)", p.X, p.Y)
+	}
+	return nil
+}
+
+// MiddleClickAtPoint performs a middle mouse click at the specified point.
+func MiddleClickAtPoint(p image.Point, restoreCursor bool) error {
+	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+	result := C.performMiddleClickAtPosition(pos, C.bool(restoreCursor))
+	if result == 0 {
+		return fmt.Errorf("failed to perform middle-click at position (%d, %d)", p.X, p.Y)
+	}
+	return nil
+}
+
+// LeftMouseDownAtPoint performs a left mouse down action at the specified point.
+func LeftMouseDownAtPoint(p image.Point) error {
+	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+	result := C.performLeftMouseDownAtPosition(pos)
+	if result == 0 {
+		return fmt.Errorf("failed to perform left-mouse-down at position (%d, %d)", p.X, p.Y)
+	}
+	return nil
+}
+
+// LeftMouseUpAtPoint performs a left mouse up action at the specified point.
+func LeftMouseUpAtPoint(p image.Point) error {
+	pos := C.CGPoint{x: C.double(p.X), y: C.double(p.Y)}
+	result := C.performLeftMouseUpAtPosition(pos)
+	if result == 0 {
+		return fmt.Errorf("failed to perform left-mouse-up at position (%d, %d)", p.X, p.Y)
+	}
+	return nil
+}
+
+// LeftMouseUp performs a left mouse up action at the current cursor position.
+func LeftMouseUp() error {
+	result := C.performLeftMouseUpAtCursor()
+	if result == 0 {
+		return errors.New("failed to perform left-mouse-up at cursor")
+	}
+	return nil
+}
+
+// ScrollAtCursor scrolls the element at the current cursor position by the specified deltas.
+func ScrollAtCursor(deltaX, deltaY int) error {
+	result := C.scrollAtCursor(C.int(deltaX), C.int(deltaY))
+	if result == 0 {
+		return fmt.Errorf("failed to scroll at cursor with delta (%d, %d)", deltaX, deltaY)
+	}
+	return nil
+}
+
+// GetCurrentCursorPosition returns the current cursor position in screen coordinates.
+func GetCurrentCursorPosition() image.Point {
+	pos := C.getCurrentCursorPosition()
+	return image.Point{X: int(pos.x), Y: int(pos.y)}
+}
+
+// IsMissionControlActive checks if Mission Control is currently active.
+func IsMissionControlActive() bool {
+	result := C.isMissionControlActive()
+	return bool(result)
+}
@@ -0,0 +1,341 @@
+package accessibility
+
+import (
+	"image"
+	"sync"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/traversal"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// Arena storage is split into fixed-size chunks that never move, so workers can fill the
+// slots they reserved without holding the arena lock.
+const (
+	flatChunkShift = 10
+	flatChunkSize  = 1 << flatChunkShift
+	flatChunkMask  = flatChunkSize - 1
+	maxFlatChunks  = 1024
+)
+
+// noNode marks a missing parent or child index.
+const noNode int32 = -1
+
+// flatChunk holds one block of nodes as parallel arrays.
+type flatChunk struct {
+	elements    [flatChunkSize]*Element
+	infos       [flatChunkSize]*ElementInfo
+	frames      [flatChunkSize]image.Rectangle
+	roles       [flatChunkSize]RoleID
+	parents     [flatChunkSize]int32
+	firstChild  [flatChunkSize]int32
+	childCounts [flatChunkSize]int32
+}
+
+// TreeArena owns the storage of one flat tree. It is reset and reused between activations,
+// so a traversal allocates a handful of chunks instead of one object per node.
+type TreeArena struct {
+	mu     sync.Mutex
+	chunks [maxFlatChunks]*flatChunk
+	length int32
+}
+
+// treeArenas recycles arenas across activations and concurrent sources.
+var treeArenas = sync.Pool{
+	New: func() any { return NewTreeArena() },
+}
+
+// NewTreeArena creates an empty arena.
+func NewTreeArena() *TreeArena {
+	return &TreeArena{}
+}
+
+// Reset drops all nodes while keeping the allocated chunks for reuse.
+func (a *TreeArena) Reset() {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+
+	// Clear references so released elements and infos can be collected
+	for index := range a.length {
+		chunk, offset := a.slot(index)
+		chunk.elements[offset] = nil
+		chunk.infos[offset] = nil
+	}
+	a.length = 0
+}
+
+// reserve allocates count consecutive node indices. It returns false when the arena is full.
+func (a *TreeArena) reserve(count int) (int32, bool) {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+
+	first := a.length
+	end := int(first) + count
+	if end > maxFlatChunks*flatChunkSize {
+		return noNode, false
+	}
+
+	lastChunk := (end - 1) >> flatChunkShift
+	for chunkIndex := int(first) >> flatChunkShift; chunkIndex <= lastChunk; chunkIndex++ {
+		if a.chunks[chunkIndex] == nil {
+			a.chunks[chunkIndex] = &flatChunk{}
+		}
+	}
+	a.length = int32(end)
+
+	return first, true
+}
+
+// set fills a reserved slot.
+func (a *TreeArena) set(index int32, element *Element, info *ElementInfo, parent int32) {
+	chunk, offset := a.slot(index)
+	chunk.elements[offset] = element
+	chunk.infos[offset] = info
+	chunk.frames[offset] = rectFromInfo(info)
+	chunk.roles[offset] = info.RoleID
+	chunk.parents[offset] = parent
+	chunk.firstChild[offset] = noNode
+	chunk.childCounts[offset] = 0
+}
+
+// setChildren links a node to its consecutive block of children.
+func (a *TreeArena) setChildren(index, first, count int32) {
+	chunk, offset := a.slot(index)
+	chunk.firstChild[offset] = first
+	chunk.childCounts[offset] = count
+}
+
+func (a *TreeArena) slot(index int32) (*flatChunk, int32) {
+	return a.chunks[index>>flatChunkShift], index & flatChunkMask
+}
+
+// FlatTree is a tree stored in an arena. Node 0 is the root; the children of a node occupy
+// consecutive indices in accessibility order. The tree is only valid until its arena is reset.
+type FlatTree struct {
+	arena *TreeArena
+}
+
+// Len returns the number of nodes.
+func (t *FlatTree) Len() int {
+	return int(t.arena.length)
+}
+
+// Element returns the accessibility element of a node.
+func (t *FlatTree) Element(index int32) *Element {
+	chunk, offset := t.arena.slot(index)
+	return chunk.elements[offset]
+}
+
+// Info returns the element information of a node.
+func (t *FlatTree) Info(index int32) *ElementInfo {
+	chunk, offset := t.arena.slot(index)
+	return chunk.infos[offset]
+}
+
+// Frame returns the screen rectangle of a node.
+func (t *FlatTree) Frame(index int32) image.Rectangle {
+	chunk, offset := t.arena.slot(index)
+	return chunk.frames[offset]
+}
+
+// Role returns the interned role of a node.
+func (t *FlatTree) Role(index int32) RoleID {
+	chunk, offset := t.arena.slot(index)
+	return chunk.roles[offset]
+}
+
+// Parent returns the index of a node's parent, or -1 for the root.
+func (t *FlatTree) Parent(index int32) int32 {
+	chunk, offset := t.arena.slot(index)
+	return chunk.parents[offset]
+}
+
+// Children returns the index of a node's first child and the number of children.
+func (t *FlatTree) Children(index int32) (int32, int32) {
+	chunk, offset := t.arena.slot(index)
+	return chunk.firstChild[offset], chunk.childCounts[offset]
+}
+
+// FindClickableElements returns the clickable nodes of the tree. Only these nodes are
+// materialized as TreeNodes, sharing one allocation; they carry no parent or child links.
+func (t *FlatTree) FindClickableElements() []*TreeNode {
+	clickable := make([]int32, 0, 64)
+	for index := range int32(t.Len()) {
+		if t.Element(index).isClickable(t.Info(index)) {
+			clickable = append(clickable, index)
+		}
+	}
+	return t.materialize(clickable)
+}
+
+// BuildFlatTree walks the tree below root into arena, which is reset first.
+func BuildFlatTree(root *Element, opts TreeOptions, arena *TreeArena) (*FlatTree, error) {
+	if root == nil {
+		logger.Debug("BuildFlatTree called with nil root element")
+		return nil, errRootElementNil
+	}
+
+	release := opts.scope.hold()
+	defer release()
+
+	info, err := rootInfo(root, opts.Cache)
+	if err != nil {
+		return nil, err
+	}
+
+	arena.Reset()
+	rootIndex, _ := arena.reserve(1)
+	arena.set(rootIndex, root, info, noNode)
+
+	traversal.NewScheduler(opts.Workers).Run(func(worker *traversal.Worker) {
+		expandFlat(worker, arena, rootIndex, 1, opts, rootBranch(info))
+	})
+	opts.walk.finish()
+
+	tree := &FlatTree{arena: arena}
+	logger.Debug("Flat tree building completed",
+		zap.String("root_role", info.Role),
+		zap.Int("nodes", tree.Len()))
+
+	return tree, nil
+}
+
+// expandFlat resolves the children of a node into a consecutive block of the arena and
+// spawns a task for each of them. branch is the node's position in the walk.
+func expandFlat(
+	worker *traversal.Worker,
+	arena *TreeArena,
+	index int32,
+	depth int,
+	opts TreeOptions,
+	branch walkBranch,
+) {
+	chunk, offset := arena.slot(index)
+	children, infos, validCount := resolveChildren(
+		chunk.elements[offset],
+		chunk.infos[offset],
+		depth,
+		opts,
+		branch,
+	)
+	if validCount == 0 {
+		return
+	}
+
+	first, ok := arena.reserve(validCount)
+	if !ok {
+		logger.Warn("Tree arena full, truncating traversal", zap.Int("depth", depth))
+		return
+	}
+
+	next := first
+	for childIndex, child := range children {
+		if infos[childIndex] == nil {
+			continue
+		}
+		arena.set(next, child, infos[childIndex], index)
+		next++
+	}
+	arena.setChildren(index, first, int32(validCount))
+
+	for child := first; child < next; child++ {
+		childChunk, childOffset := arena.slot(child)
+		childBranch := branch.child(childChunk.infos[childOffset])
+		worker.Spawn(func(worker *traversal.Worker) {
+			expandFlat(worker, arena, child, depth+1, opts, childBranch)
+		})
+	}
+}
+
+// findClickable returns the clickable nodes like FindClickableElements and reports what each
+// subtree contained to skips. A nil skips learns nothing. Clickable nodes are signed whenever
+// the branches are followed.
+func (t *FlatTree) findClickable(skips *subtreeSkips) []*TreeNode {
+	if skips == nil && !signClickables.Load() {
+		return t.FindClickableElements()
+	}
+
+	// Parents precede their children, so paths fill forwards
+	length := int32(t.Len())
+	branches := make([]walkBranch, length)
+	clickable := make([]int32, 0, 64)
+	for index := range length {
+		if parent := t.Parent(index); parent == noNode {
+			branches[index] = rootBranch(t.Info(index))
+		} else {
+			branches[index] = branches[parent].child(t.Info(index))
+		}
+		if t.Element(index).isClickable(t.Info(index)) {
+			clickable = append(clickable, index)
+		}
+	}
+	if skips != nil {
+		t.observeSubtrees(skips, branches, clickable)
+	}
+
+	result := t.materialize(clickable)
+	for position, index := range clickable {
+		result[position].Signature = branches[index].signature(t.Info(index))
+	}
+	return result
+}
+
+// observeSubtrees reports to skips how many nodes and clickable nodes each subtree holds,
+// leaving out subtrees that hold content. Children follow their parents, so counts accumulate
+// backwards.
+func (t *FlatTree) observeSubtrees(skips *subtreeSkips, branches []walkBranch, clickable []int32) {
+	length := int32(len(branches))
+	nodes := make([]int32, length)
+	clickables := make([]int32, length)
+	content := make([]bool, length)
+	for _, index := range clickable {
+		clickables[index] = 1
+	}
+	for index := length - 1; index >= 0; index-- {
+		nodes[index]++
+		content[index] = content[index] || branches[index].content
+		if !content[index] {
+			skips.observe(
+				branches[index].signature(t.Info(index)),
+				int(nodes[index]),
+				int(clickables[index]),
+			)
+		}
+		if parent := t.Parent(index); parent != noNode {
+			nodes[parent] += nodes[index]
+			clickables[parent] += clickables[index]
+			content[parent] = content[parent] || content[index]
+		}
+	}
+}
+
+// materialize creates TreeNodes for the given node indices, sharing one allocation.
+func (t *FlatTree) materialize(indices []int32) []*TreeNode {
+	nodes := make([]TreeNode, len(indices))
+	result := make([]*TreeNode, len(indices))
+	for position, index := range indices {
+		nodes[position] = TreeNode{
+			Element: t.Element(index),
+			Info:    t.Info(index),
+		}
+		result[position] = &nodes[position]
+	}
+	return result
+}
+
+// findClickableFlat builds the tree below root in a pooled arena and returns its clickable nodes.
+func findClickableFlat(root *Element, opts TreeOptions) ([]*TreeNode, error) {
+	arena, _ := treeArenas.Get().(*TreeArena)
+	defer func() {
+		arena.Reset()
+		treeArenas.Put(arena)
+	}()
+
+	tree, err := BuildFlatTree(root, opts, arena)
+	if err != nil {
+		return nil, err
+	}
+	elements := tree.findClickable(opts.skips)
+	opts.commitSkips()
+	return elements, nil
+}
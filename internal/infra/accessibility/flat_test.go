@@ -0,0 +1,110 @@
+package accessibility
+
+import "testing"
+
+// flatTreeSpec is benchmarkTree without simulated latency, so allocations dominate.
+var flatTreeSpec = func() SyntheticSpec {
+	spec := benchmarkTree
+	spec.CallLatencyUs = 0
+	return spec
+}()
+
+func TestBuildFlatTreeMatchesBuildTree(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 4}
+
+	root, err := BuildTree(window, opts)
+	if err != nil {
+		t.Fatalf("BuildTree() error = %v", err)
+	}
+	flat, err := BuildFlatTree(window, opts, NewTreeArena())
+	if err != nil {
+		t.Fatalf("BuildFlatTree() error = %v", err)
+	}
+
+	if flat.Len() != countNodes(root) {
+		t.Errorf("BuildFlatTree() has %d nodes, BuildTree() %d", flat.Len(), countNodes(root))
+	}
+	for index := range int32(flat.Len()) {
+		if parent := flat.Parent(index); parent >= index {
+			t.Fatalf("node %d has parent %d; parents must precede their children", index, parent)
+		}
+	}
+	if len(flat.FindClickableElements()) == 0 {
+		t.Error("FindClickableElements() found nothing")
+	}
+}
+
+// TestFlatTreeAllocs checks that a reused arena walks the tree with fewer allocations than
+// the linked tree, which allocates a node block and child slice per parent.
+func TestFlatTreeAllocs(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 1}
+	arena := NewTreeArena()
+
+	flatAllocs := testing.AllocsPerRun(20, func() {
+		opts.Cache.Clear()
+		_, _ = BuildFlatTree(window, opts, arena)
+	})
+	linkedAllocs := testing.AllocsPerRun(20, func() {
+		opts.Cache.Clear()
+		_, _ = BuildTree(window, opts)
+	})
+
+	t.Logf("allocations per walk of %d nodes: flat %.0f, linked %.0f",
+		provider.Len(), flatAllocs, linkedAllocs)
+	if flatAllocs >= linkedAllocs {
+		t.Errorf("BuildFlatTree() allocates %.0f times per walk, BuildTree() %.0f",
+			flatAllocs, linkedAllocs)
+	}
+}
+
+func BenchmarkBuildFlatTree(b *testing.B) {
+	provider := useSyntheticTree(b, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(b), Workers: 1}
+	arena := NewTreeArena()
+
+	b.ReportAllocs()
+	for b.Loop() {
+		opts.Cache.Clear()
+		_, err := BuildFlatTree(window, opts, arena)
+		if err != nil {
+			b.Fatal(err)
+		}
+	}
+	b.ReportMetric(float64(provider.Len()), "nodes/op")
+}
+
+func BenchmarkFindClickableFlat(b *testing.B) {
+	provider := useSyntheticTree(b, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(b), Workers: 1}
+
+	b.ReportAllocs()
+	for b.Loop() {
+		opts.Cache.Clear()
+		_, err := findClickableFlat(window, opts)
+		if err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkBuildLinkedTree(b *testing.B) {
+	provider := useSyntheticTree(b, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(b), Workers: 1}
+
+	b.ReportAllocs()
+	for b.Loop() {
+		opts.Cache.Clear()
+		_, err := BuildTree(window, opts)
+		if err != nil {
+			b.Fatal(err)
+		}
+	}
+	b.ReportMetric(float64(provider.Len()), "nodes/op")
+}
@@ -0,0 +1,19 @@
+// Package incremental maintains the dirty state of persistent accessibility trees from a
+// stream of accessibility notifications.
+//
+// The package is deliberately free of cgo. It knows elements only by their identity keys
+// (process ID plus CFHash) and tracks the parent/child structure recorded by the last walk
+// of each window. Notifications delivered by the Objective-C observer bridge are translated
+// into Events and applied here; the accessibility package then asks which subtrees became
+// dirty and re-walks only those on the next hint activation.
+//
+// Key Features:
+//   - Per-window Trees: Structure of each scanned window, keyed by element identity
+//   - Event Application: Created, destroyed, moved, resized, and value-changed notifications
+//     mark the smallest affected subtree dirty
+//   - Minimal Re-walks: Dirty subtrees nested inside other dirty subtrees are collapsed
+//   - Bounded Memory: The Set keeps a fixed number of window trees in LRU order
+//
+// Because the package has no platform dependencies, the tree-maintenance logic can be driven
+// by synthetic notification streams on any platform.
+package incremental
@@ -0,0 +1,181 @@
+package incremental
+
+import (
+	"container/list"
+	"sync"
+)
+
+// DefaultMaxTrees bounds how many window trees a Set keeps by default.
+const DefaultMaxTrees = 16
+
+// SetStats counts how notifications were handled.
+type SetStats struct {
+	Trees   int
+	Applied uint64
+	Ignored uint64
+}
+
+// Set owns the persistent trees of recently scanned windows and routes notifications to them.
+// It is safe for concurrent use: notifications arrive on the bridge's event queue while walks
+// run on the activation goroutine.
+type Set struct {
+	mu       sync.Mutex
+	maxTrees int
+	trees    map[Key]*list.Element
+	order    *list.List
+	pids     map[int]int
+	onEvict  func(root Key, lastOfPID bool)
+	stats    SetStats
+}
+
+// NewSet creates a Set holding at most maxTrees windows.
+// onEvict is called, with the Set lock held, for every window tree that is dropped;
+// lastOfPID is true when no other tree of the same process remains.
+func NewSet(maxTrees int, onEvict func(root Key, lastOfPID bool)) *Set {
+	if maxTrees <= 0 {
+		maxTrees = DefaultMaxTrees
+	}
+	return &Set{
+		maxTrees: maxTrees,
+		trees:    make(map[Key]*list.Element, maxTrees),
+		order:    list.New(),
+		pids:     make(map[int]int),
+		onEvict:  onEvict,
+	}
+}
+
+// With runs fn with exclusive access to the tree of the given window, creating a stale tree
+// when none exists. The window becomes the most recently used one.
+func (s *Set) With(root Key, fn func(tree *Tree)) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	entry, ok := s.trees[root]
+	if ok {
+		s.order.MoveToFront(entry)
+	} else {
+		entry = s.order.PushFront(NewTree(root))
+		s.trees[root] = entry
+		s.pids[root.PID]++
+		s.evictLocked()
+	}
+
+	tree, _ := entry.Value.(*Tree)
+	fn(tree)
+}
+
+// Dispatch applies a notification to every tree of the notifying process.
+// It returns true when at least one tree was affected.
+func (s *Set) Dispatch(event Event) bool {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	pid := event.Element.PID
+	if pid == 0 {
+		pid = event.Parent.PID
+	}
+
+	if event.Kind == EventFocusedWindowChanged {
+		// Keep the newly focused window's tree from being evicted first
+		if entry, ok := s.trees[event.Element]; ok {
+			s.order.MoveToFront(entry)
+		}
+		s.stats.Ignored++
+		return false
+	}
+
+	applied := false
+	if s.pids[pid] > 0 {
+		for entry := s.order.Front(); entry != nil; entry = entry.Next() {
+			tree, _ := entry.Value.(*Tree)
+			if tree.root.PID != pid {
+				continue
+			}
+			if tree.Apply(event) {
+				applied = true
+			}
+		}
+	}
+
+	if applied {
+		s.stats.Applied++
+	} else {
+		s.stats.Ignored++
+	}
+	return applied
+}
+
+// HasPID reports whether any window tree of the process is tracked.
+func (s *Set) HasPID(pid int) bool {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return s.pids[pid] > 0
+}
+
+// InvalidatePID marks every tree of the process for a full rebuild, for example when
+// notifications for it can no longer be trusted.
+func (s *Set) InvalidatePID(pid int) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	for entry := s.order.Front(); entry != nil; entry = entry.Next() {
+		tree, _ := entry.Value.(*Tree)
+		if tree.root.PID == pid {
+			tree.Invalidate()
+		}
+	}
+}
+
+// Remove drops the tree of a window.
+func (s *Set) Remove(root Key) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if entry, ok := s.trees[root]; ok {
+		s.removeLocked(entry)
+	}
+}
+
+// Clear drops every tree.
+func (s *Set) Clear() {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	for s.order.Len() > 0 {
+		s.removeLocked(s.order.Back())
+	}
+}
+
+// Stats returns the number of tracked trees and notification counters.
+func (s *Set) Stats() SetStats {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	stats := s.stats
+	stats.Trees = s.order.Len()
+	return stats
+}
+
+// evictLocked drops least recently used trees beyond the capacity.
+func (s *Set) evictLocked() {
+	for s.order.Len() > s.maxTrees {
+		s.removeLocked(s.order.Back())
+	}
+}
+
+// removeLocked unlinks a tree and notifies the owner.
+func (s *Set) removeLocked(entry *list.Element) {
+	tree, _ := entry.Value.(*Tree)
+	s.order.Remove(entry)
+	delete(s.trees, tree.root)
+
+	s.pids[tree.root.PID]--
+	lastOfPID := s.pids[tree.root.PID] <= 0
+	if lastOfPID {
+		delete(s.pids, tree.root.PID)
+	}
+
+	if s.onEvict != nil {
+		s.onEvict(tree.root, lastOfPID)
+	}
+}
@@ -0,0 +1,315 @@
+package incremental
+
+import (
+	"cmp"
+	"slices"
+)
+
+// Key identifies an accessibility element by its owning process and CFHash.
+type Key struct {
+	PID  int
+	Hash uint64
+}
+
+// IsZero reports whether the key does not refer to any element.
+func (k Key) IsZero() bool {
+	return k == Key{}
+}
+
+// EventKind enumerates the accessibility notifications that affect a tree.
+// The values mirror ElementEventKind in accessibility.h.
+type EventKind uint8
+
+const (
+	// EventCreated is delivered when a UI element is created.
+	EventCreated EventKind = iota
+	// EventDestroyed is delivered when a UI element is destroyed.
+	EventDestroyed
+	// EventMoved is delivered when a UI element or window moves.
+	EventMoved
+	// EventResized is delivered when a UI element or window is resized.
+	EventResized
+	// EventValueChanged is delivered when the value of a UI element changes.
+	EventValueChanged
+	// EventFocusedWindowChanged is delivered when an application focuses another window.
+	EventFocusedWindowChanged
+)
+
+// String returns the notification name for logging.
+func (k EventKind) String() string {
+	switch k {
+	case EventCreated:
+		return "created"
+	case EventDestroyed:
+		return "destroyed"
+	case EventMoved:
+		return "moved"
+	case EventResized:
+		return "resized"
+	case EventValueChanged:
+		return "value_changed"
+	case EventFocusedWindowChanged:
+		return "focused_window_changed"
+	default:
+		return "unknown"
+	}
+}
+
+// Event is a single accessibility notification.
+// Parent is only set for EventCreated, and is zero there too when the parent could not be
+// looked up; the new element may then belong to any tree of the process.
+type Event struct {
+	Kind    EventKind
+	Element Key
+	Parent  Key
+}
+
+// node records the structure observed for one element during the last walk.
+type node struct {
+	parent   Key
+	children []Key
+	// shared marks a key recorded at more than one position, i.e. a hash collision.
+	shared bool
+}
+
+// Tree tracks the recorded structure of a single window and which parts of it are dirty.
+// Tree is not safe for concurrent use; Set serializes access.
+type Tree struct {
+	root  Key
+	nodes map[Key]*node
+	dirty map[Key]struct{}
+	stale bool
+}
+
+// NewTree creates an empty tree for the window identified by root.
+// A new tree is stale until its first full walk has been recorded.
+func NewTree(root Key) *Tree {
+	return &Tree{
+		root:  root,
+		nodes: map[Key]*node{root: {}},
+		dirty: make(map[Key]struct{}),
+		stale: true,
+	}
+}
+
+// Root returns the window key the tree was created for.
+func (t *Tree) Root() Key {
+	return t.root
+}
+
+// Len returns the number of recorded elements, including the root.
+func (t *Tree) Len() int {
+	return len(t.nodes)
+}
+
+// Contains reports whether the element was seen during the last walk.
+func (t *Tree) Contains(key Key) bool {
+	_, ok := t.nodes[key]
+	return ok
+}
+
+// Stale reports whether the whole tree must be rebuilt.
+func (t *Tree) Stale() bool {
+	return t.stale
+}
+
+// Invalidate forces a full rebuild on the next walk.
+func (t *Tree) Invalidate() {
+	t.stale = true
+	clear(t.dirty)
+}
+
+// Apply updates the dirty state for a notification.
+// It returns false when the event does not concern any element of this tree.
+func (t *Tree) Apply(event Event) bool {
+	switch event.Kind {
+	case EventCreated:
+		if event.Parent.IsZero() {
+			t.Invalidate()
+			return true
+		}
+		if !t.Contains(event.Parent) {
+			return false
+		}
+		t.markDirty(event.Parent)
+		return true
+
+	case EventDestroyed:
+		current, ok := t.nodes[event.Element]
+		if !ok {
+			return false
+		}
+		if event.Element == t.root || current.shared {
+			t.Invalidate()
+			return true
+		}
+		parent := current.parent
+		t.removeSubtree(event.Element)
+		t.markDirty(parent)
+		return true
+
+	case EventMoved, EventResized:
+		if !t.Contains(event.Element) {
+			return false
+		}
+		// Every descendant shares the window's coordinate change
+		if event.Element == t.root {
+			t.Invalidate()
+			return true
+		}
+		t.markDirty(event.Element)
+		return true
+
+	case EventValueChanged:
+		if !t.Contains(event.Element) {
+			return false
+		}
+		t.markDirty(event.Element)
+		return true
+
+	case EventFocusedWindowChanged:
+		return false
+
+	default:
+		return false
+	}
+}
+
+// Record stores the children observed for parent during a walk, replacing the previous
+// child list. Children that disappeared are forgotten together with their subtrees.
+func (t *Tree) Record(parent Key, children []Key) {
+	current, ok := t.nodes[parent]
+	if !ok {
+		current = &node{}
+		t.nodes[parent] = current
+	}
+
+	for _, child := range current.children {
+		if !slices.Contains(children, child) {
+			t.removeSubtree(child)
+		}
+	}
+
+	current.children = slices.Clone(children)
+	for _, child := range children {
+		existing, ok := t.nodes[child]
+		if !ok {
+			t.nodes[child] = &node{parent: parent}
+			continue
+		}
+		if existing.parent != parent || child == t.root {
+			existing.shared = true
+		}
+	}
+}
+
+// ResetSubtree forgets everything recorded below key, keeping key itself.
+// It is called before a dirty subtree is walked again.
+func (t *Tree) ResetSubtree(key Key) {
+	current, ok := t.nodes[key]
+	if !ok {
+		return
+	}
+	for _, child := range current.children {
+		t.removeSubtree(child)
+	}
+	current.children = nil
+}
+
+// RecordSubtree replaces everything recorded below key with the structure reported by walk,
+// which calls record once per visited parent. Notifications applied after TakeDirty but
+// before RecordSubtree may describe changes the walk did not see, so their dirty marks
+// survive the replacement.
+func (t *Tree) RecordSubtree(key Key, walk func(record func(parent Key, children []Key))) {
+	pending := make([]Key, 0, len(t.dirty))
+	for dirtyKey := range t.dirty {
+		pending = append(pending, dirtyKey)
+	}
+
+	t.ResetSubtree(key)
+	walk(t.Record)
+
+	for _, dirtyKey := range pending {
+		t.markDirty(dirtyKey)
+	}
+}
+
+// TakeDirty returns the subtrees that must be walked again and clears the dirty state.
+// When full is true the whole tree must be rebuilt and roots is nil. Otherwise roots
+// holds the topmost dirty elements, in a deterministic order; subtrees nested inside
+// another dirty subtree are omitted.
+func (t *Tree) TakeDirty() ([]Key, bool) {
+	if t.stale {
+		t.stale = false
+		clear(t.dirty)
+		return nil, true
+	}
+
+	roots := make([]Key, 0, len(t.dirty))
+	for key := range t.dirty {
+		if !t.Contains(key) || t.hasDirtyAncestor(key) {
+			continue
+		}
+		roots = append(roots, key)
+	}
+	clear(t.dirty)
+
+	slices.SortFunc(roots, func(a, b Key) int {
+		if a.PID != b.PID {
+			return cmp.Compare(a.PID, b.PID)
+		}
+		return cmp.Compare(a.Hash, b.Hash)
+	})
+
+	return roots, false
+}
+
+// markDirty schedules the subtree rooted at key for a new walk.
+func (t *Tree) markDirty(key Key) {
+	current, ok := t.nodes[key]
+	if !ok {
+		return
+	}
+	if key == t.root || current.shared {
+		t.Invalidate()
+		return
+	}
+	t.dirty[key] = struct{}{}
+}
+
+// hasDirtyAncestor reports whether any ancestor of key is already scheduled.
+func (t *Tree) hasDirtyAncestor(key Key) bool {
+	for depth := 0; depth < len(t.nodes); depth++ {
+		current, ok := t.nodes[key]
+		if !ok || key == t.root {
+			return false
+		}
+		key = current.parent
+		if _, dirty := t.dirty[key]; dirty {
+			return true
+		}
+	}
+	return false
+}
+
+// removeSubtree forgets key and all of its recorded descendants.
+func (t *Tree) removeSubtree(key Key) {
+	if key == t.root {
+		return
+	}
+
+	pending := []Key{key}
+	for len(pending) > 0 {
+		last := len(pending) - 1
+		current := pending[last]
+		pending = pending[:last]
+
+		recorded, ok := t.nodes[current]
+		if !ok {
+			continue
+		}
+		pending = append(pending, recorded.children...)
+		delete(t.nodes, current)
+		delete(t.dirty, current)
+	}
+}
@@ -0,0 +1,257 @@
+package incremental_test
+
+import (
+	"slices"
+	"testing"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/incremental"
+)
+
+const testPID = 42
+
+// key returns the key of a synthetic element of the test process.
+func key(hash uint64) incremental.Key {
+	return incremental.Key{PID: testPID, Hash: hash}
+}
+
+// newRecordedTree returns a tree rooted at 1 holding the walk
+//
+//	1 ─┬─ 2 ─┬─ 4
+//	   │     └─ 5
+//	   └─ 3 ─── 6
+//
+// with no dirty state left.
+func newRecordedTree(t *testing.T) *incremental.Tree {
+	t.Helper()
+
+	tree := incremental.NewTree(key(1))
+	roots, full := tree.TakeDirty()
+	if !full || roots != nil {
+		t.Fatalf("new tree: TakeDirty() = %v, %v; want nil, true", roots, full)
+	}
+	tree.Record(key(1), []incremental.Key{key(2), key(3)})
+	tree.Record(key(2), []incremental.Key{key(4), key(5)})
+	tree.Record(key(3), []incremental.Key{key(6)})
+	return tree
+}
+
+func TestTreeApplyEventStreams(t *testing.T) {
+	tests := []struct {
+		name      string
+		events    []incremental.Event
+		wantRoots []incremental.Key
+		wantFull  bool
+	}{
+		{
+			name:      "no events",
+			wantRoots: []incremental.Key{},
+		},
+		{
+			name: "created marks its parent",
+			events: []incremental.Event{
+				{Kind: incremental.EventCreated, Element: key(7), Parent: key(4)},
+			},
+			wantRoots: []incremental.Key{key(4)},
+		},
+		{
+			name: "created with unknown parent rebuilds",
+			events: []incremental.Event{
+				{Kind: incremental.EventCreated, Element: key(7)},
+			},
+			wantFull: true,
+		},
+		{
+			name: "created outside the tree is ignored",
+			events: []incremental.Event{
+				{Kind: incremental.EventCreated, Element: key(8), Parent: key(99)},
+			},
+			wantRoots: []incremental.Key{},
+		},
+		{
+			name: "nested dirty subtrees collapse to the topmost",
+			events: []incremental.Event{
+				{Kind: incremental.EventValueChanged, Element: key(4)},
+				{Kind: incremental.EventResized, Element: key(2)},
+				{Kind: incremental.EventMoved, Element: key(5)},
+			},
+			wantRoots: []incremental.Key{key(2)},
+		},
+		{
+			name: "sibling subtrees stay separate",
+			events: []incremental.Event{
+				{Kind: incremental.EventValueChanged, Element: key(6)},
+				{Kind: incremental.EventValueChanged, Element: key(4)},
+			},
+			wantRoots: []incremental.Key{key(4), key(6)},
+		},
+		{
+			name: "destroyed child of the root rebuilds",
+			events: []incremental.Event{
+				{Kind: incremental.EventDestroyed, Element: key(2)},
+				{Kind: incremental.EventValueChanged, Element: key(4)},
+			},
+			wantFull: true,
+		},
+		{
+			name: "destroyed leaf marks its parent",
+			events: []incremental.Event{
+				{Kind: incremental.EventDestroyed, Element: key(6)},
+			},
+			wantRoots: []incremental.Key{key(3)},
+		},
+		{
+			name: "moved window rebuilds",
+			events: []incremental.Event{
+				{Kind: incremental.EventValueChanged, Element: key(4)},
+				{Kind: incremental.EventMoved, Element: key(1)},
+			},
+			wantFull: true,
+		},
+		{
+			name: "focus changes are ignored",
+			events: []incremental.Event{
+				{Kind: incremental.EventFocusedWindowChanged, Element: key(1)},
+			},
+			wantRoots: []incremental.Key{},
+		},
+	}
+
+	for _, test := range tests {
+		t.Run(test.name, func(t *testing.T) {
+			tree := newRecordedTree(t)
+			for _, event := range test.events {
+				tree.Apply(event)
+			}
+
+			roots, full := tree.TakeDirty()
+			if full != test.wantFull {
+				t.Fatalf("TakeDirty() full = %v, want %v", full, test.wantFull)
+			}
+			if full {
+				return
+			}
+			if !slices.Equal(roots, test.wantRoots) {
+				t.Fatalf("TakeDirty() roots = %v, want %v", roots, test.wantRoots)
+			}
+		})
+	}
+}
+
+func TestTreeDestroyedForgetsSubtree(t *testing.T) {
+	tree := newRecordedTree(t)
+
+	if !tree.Apply(incremental.Event{Kind: incremental.EventDestroyed, Element: key(2)}) {
+		t.Fatal("Apply(destroyed 2) = false, want true")
+	}
+	for _, hash := range []uint64{2, 4, 5} {
+		if tree.Contains(key(hash)) {
+			t.Errorf("Contains(%d) = true after its subtree was destroyed", hash)
+		}
+	}
+	if tree.Len() != 3 {
+		t.Errorf("Len() = %d, want 3", tree.Len())
+	}
+
+	// Events for forgotten elements no longer concern the tree
+	if tree.Apply(incremental.Event{Kind: incremental.EventValueChanged, Element: key(4)}) {
+		t.Error("Apply(value changed 4) = true for a destroyed element")
+	}
+}
+
+func TestTreeRecordSubtreeKeepsConcurrentMarks(t *testing.T) {
+	tree := newRecordedTree(t)
+
+	tree.Apply(incremental.Event{Kind: incremental.EventValueChanged, Element: key(2)})
+	roots, _ := tree.TakeDirty()
+	if !slices.Equal(roots, []incremental.Key{key(2)}) {
+		t.Fatalf("TakeDirty() roots = %v, want [2]", roots)
+	}
+
+	// A notification arriving while the dirty subtree is walked again
+	tree.Apply(incremental.Event{Kind: incremental.EventValueChanged, Element: key(6)})
+	tree.RecordSubtree(key(2), func(record func(incremental.Key, []incremental.Key)) {
+		record(key(2), []incremental.Key{key(4), key(7)})
+	})
+
+	if tree.Contains(key(5)) || !tree.Contains(key(7)) {
+		t.Error("RecordSubtree did not replace the children of 2")
+	}
+	roots, full := tree.TakeDirty()
+	if full || !slices.Equal(roots, []incremental.Key{key(6)}) {
+		t.Errorf("TakeDirty() = %v, %v; want [6], false", roots, full)
+	}
+}
+
+func TestTreeSharedKeyRebuilds(t *testing.T) {
+	tree := newRecordedTree(t)
+
+	// A hash collision records the same key below two parents
+	tree.Record(key(3), []incremental.Key{key(6), key(4)})
+	tree.Apply(incremental.Event{Kind: incremental.EventValueChanged, Element: key(4)})
+
+	if _, full := tree.TakeDirty(); !full {
+		t.Error("TakeDirty() full = false for a change to a shared key")
+	}
+}
+
+func TestSetDispatchRoutesByProcess(t *testing.T) {
+	var evicted []incremental.Key
+	set := incremental.NewSet(2, func(root incremental.Key, _ bool) {
+		evicted = append(evicted, root)
+	})
+
+	other := incremental.Key{PID: testPID + 1, Hash: 1}
+	for _, root := range []incremental.Key{key(1), other} {
+		set.With(root, func(tree *incremental.Tree) {
+			tree.TakeDirty()
+			tree.Record(root, []incremental.Key{{PID: root.PID, Hash: 2}})
+		})
+	}
+
+	if !set.Dispatch(incremental.Event{Kind: incremental.EventValueChanged, Element: key(2)}) {
+		t.Error("Dispatch(value changed 2) = false, want true")
+	}
+	if set.Dispatch(incremental.Event{Kind: incremental.EventValueChanged, Element: key(9)}) {
+		t.Error("Dispatch(value changed 9) = true for an element of no tree")
+	}
+
+	set.With(other, func(tree *incremental.Tree) {
+		if roots, full := tree.TakeDirty(); full || len(roots) != 0 {
+			t.Errorf("other process: TakeDirty() = %v, %v; want no dirty state", roots, full)
+		}
+	})
+
+	stats := set.Stats()
+	if stats.Trees != 2 || stats.Applied != 1 || stats.Ignored != 1 {
+		t.Errorf("Stats() = %+v, want 2 trees, 1 applied, 1 ignored", stats)
+	}
+
+	set.With(key(100), func(*incremental.Tree) {})
+	if !slices.Equal(evicted, []incremental.Key{key(1)}) {
+		t.Errorf("evicted = %v, want [1]", evicted)
+	}
+}
+
+func BenchmarkTreeApplyCreationStorm(b *testing.B) {
+	const width = 64
+
+	tree := incremental.NewTree(key(1))
+	tree.TakeDirty()
+	children := make([]incremental.Key, width)
+	for index := range children {
+		children[index] = key(uint64(index) + 2)
+	}
+	tree.Record(key(1), children)
+
+	b.ReportAllocs()
+	for b.Loop() {
+		for index := range width {
+			tree.Apply(incremental.Event{
+				Kind:    incremental.EventCreated,
+				Element: key(uint64(width + index + 2)),
+				Parent:  children[index],
+			})
+		}
+		tree.TakeDirty()
+	}
+}
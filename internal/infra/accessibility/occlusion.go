@@ -0,0 +1,34 @@
+package accessibility
+
+import (
+	"sync/atomic"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// windowSnapshot is the window list elements are checked against, taken once per scan.
+var windowSnapshot atomic.Pointer[occlusion.Index]
+
+// snapshotWindows replaces the window snapshot with the current on-screen windows.
+func snapshotWindows() {
+	windows := currentProvider().Windows()
+	if windows == nil {
+		logger.Debug("Window list unavailable; treating elements as visible")
+	}
+
+	windowSnapshot.Store(occlusion.NewIndex(windows, occlusion.DefaultCellSize))
+	logger.Debug("Window snapshot taken", zap.Int("windows", len(windows)))
+}
+
+// centerVisible reports whether the center of the element is not covered by a window of
+// another application. Without a snapshot yet, one is taken.
+func centerVisible(info *ElementInfo) bool {
+	index := windowSnapshot.Load()
+	if index == nil {
+		snapshotWindows()
+		index = windowSnapshot.Load()
+	}
+	return index.Visible(rectFromInfo(info), info.PID)
+}
@@ -0,0 +1,20 @@
+// Package occlusion answers whether a point on screen is covered by a window of another
+// application, using one snapshot of the on-screen window list instead of a system-wide
+// accessibility hit test per element.
+//
+// The snapshot lists windows front to back with their owner process and frame. The Index
+// buckets the windows into a uniform grid over their union, so a lookup only scans the few
+// windows overlapping one cell, in stacking order, and stops at the first that contains the
+// point.
+//
+// Key Features:
+//   - Single Snapshot: Built once per activation from the window list; lookups never leave
+//     the process
+//   - Uniform Grid: Cells of a fixed size hold the windows overlapping them, front to back,
+//     packed into one slab
+//   - Bounded Memory: The grid grows its cells rather than their number on very large
+//     desktops
+//
+// The package has no platform dependencies; the accessibility package takes the snapshot
+// through the bridge and resolves elements that are clickable only when visible.
+package occlusion
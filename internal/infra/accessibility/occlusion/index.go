@@ -0,0 +1,152 @@
+package occlusion
+
+import "image"
+
+const (
+	// DefaultCellSize is the grid cell edge in points. Windows are large, so most cells hold
+	// only a handful of them.
+	DefaultCellSize = 128
+
+	// maxCells bounds the grid; larger desktops get larger cells.
+	maxCells = 1 << 14
+)
+
+// Window is one on-screen window of the snapshot.
+type Window struct {
+	PID    int
+	Bounds image.Rectangle
+}
+
+// Index is an immutable spatial index over a window snapshot. It is safe for concurrent use.
+type Index struct {
+	windows  []Window
+	origin   image.Point
+	cellSize int
+	cols     int
+	rows     int
+	// starts[i]..starts[i+1] are the entries of cell i; entries are window indices, front
+	// to back.
+	starts  []int32
+	entries []int32
+}
+
+// NewIndex indexes windows given front to back. Windows with empty bounds are ignored.
+// A cellSize below 1 uses DefaultCellSize.
+func NewIndex(windows []Window, cellSize int) *Index {
+	if cellSize < 1 {
+		cellSize = DefaultCellSize
+	}
+
+	index := &Index{
+		windows:  make([]Window, 0, len(windows)),
+		cellSize: cellSize,
+	}
+
+	var union image.Rectangle
+	for _, window := range windows {
+		if window.Bounds.Empty() {
+			continue
+		}
+		index.windows = append(index.windows, window)
+		union = union.Union(window.Bounds)
+	}
+	if len(index.windows) == 0 {
+		return index
+	}
+
+	index.origin = union.Min
+	for {
+		index.cols = ceilDiv(union.Dx(), index.cellSize)
+		index.rows = ceilDiv(union.Dy(), index.cellSize)
+		if index.cols*index.rows <= maxCells {
+			break
+		}
+		index.cellSize *= 2
+	}
+
+	// Count, then fill, so every cell's entries share one slab in stacking order
+	cells := index.cols * index.rows
+	index.starts = make([]int32, cells+1)
+	for i := range index.windows {
+		index.forCells(index.windows[i].Bounds, func(cell int) {
+			index.starts[cell+1]++
+		})
+	}
+	for cell := range cells {
+		index.starts[cell+1] += index.starts[cell]
+	}
+
+	index.entries = make([]int32, index.starts[cells])
+	fill := make([]int32, cells)
+	copy(fill, index.starts[:cells])
+	for i := range index.windows {
+		index.forCells(index.windows[i].Bounds, func(cell int) {
+			index.entries[fill[cell]] = int32(i)
+			fill[cell]++
+		})
+	}
+
+	return index
+}
+
+// Len returns the number of indexed windows.
+func (ix *Index) Len() int {
+	return len(ix.windows)
+}
+
+// TopAt returns the frontmost window containing the point.
+func (ix *Index) TopAt(point image.Point) (Window, bool) {
+	if len(ix.windows) == 0 {
+		return Window{}, false
+	}
+
+	col := floorDiv(point.X-ix.origin.X, ix.cellSize)
+	row := floorDiv(point.Y-ix.origin.Y, ix.cellSize)
+	if col < 0 || row < 0 || col >= ix.cols || row >= ix.rows {
+		return Window{}, false
+	}
+
+	cell := row*ix.cols + col
+	for _, entry := range ix.entries[ix.starts[cell]:ix.starts[cell+1]] {
+		window := ix.windows[entry]
+		if point.In(window.Bounds) {
+			return window, true
+		}
+	}
+	return Window{}, false
+}
+
+// Visible reports whether the center of rect, as seen by a click, belongs to the process.
+// A point outside every window, such as on the menu bar, counts as visible.
+func (ix *Index) Visible(rect image.Rectangle, pid int) bool {
+	center := image.Pt((rect.Min.X+rect.Max.X)/2, (rect.Min.Y+rect.Max.Y)/2)
+	window, ok := ix.TopAt(center)
+	return !ok || window.PID == pid
+}
+
+// forCells calls fn with every cell the bounds overlap.
+func (ix *Index) forCells(bounds image.Rectangle, fn func(cell int)) {
+	minCol := floorDiv(bounds.Min.X-ix.origin.X, ix.cellSize)
+	minRow := floorDiv(bounds.Min.Y-ix.origin.Y, ix.cellSize)
+	maxCol := floorDiv(bounds.Max.X-1-ix.origin.X, ix.cellSize)
+	maxRow := floorDiv(bounds.Max.Y-1-ix.origin.Y, ix.cellSize)
+	for row := minRow; row <= maxRow; row++ {
+		for col := minCol; col <= maxCol; col++ {
+			fn(row*ix.cols + col)
+		}
+	}
+}
+
+// ceilDiv divides positive a by positive b, rounding up.
+func ceilDiv(a, b int) int {
+	return (a + b - 1) / b
+}
+
+// floorDiv divides a by positive b, rounding toward negative infinity.
+func floorDiv(a, b int) int {
+	quotient := a / b
+	if a%b != 0 && a < 0 {
+		quotient--
+	}
+	return quotient
+}
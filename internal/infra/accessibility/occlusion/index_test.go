@@ -0,0 +1,155 @@
+package occlusion_test
+
+import (
+	"image"
+	"math/rand"
+	"testing"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+)
+
+const (
+	appPID   = 1
+	otherPID = 2
+)
+
+func TestIndexTopAt(t *testing.T) {
+	// Front to back: a small dialog over two windows that share an edge at x=600
+	index := occlusion.NewIndex([]occlusion.Window{
+		{PID: 3, Bounds: image.Rect(500, 300, 700, 400)},
+		{PID: appPID, Bounds: image.Rect(0, 0, 600, 800)},
+		{PID: otherPID, Bounds: image.Rect(600, 0, 1200, 800)},
+		{PID: 4, Bounds: image.Rect(900, 900, 900, 1000)},
+	}, 64)
+
+	tests := []struct {
+		name    string
+		point   image.Point
+		wantPID int
+		wantOK  bool
+	}{
+		{name: "inside the back window", point: image.Pt(100, 100), wantPID: appPID, wantOK: true},
+		{name: "before a shared edge", point: image.Pt(599, 100), wantPID: appPID, wantOK: true},
+		{name: "on a shared edge", point: image.Pt(600, 100), wantPID: otherPID, wantOK: true},
+		{name: "front window wins", point: image.Pt(550, 350), wantPID: 3, wantOK: true},
+		{name: "past the front window", point: image.Pt(700, 350), wantPID: otherPID, wantOK: true},
+		{name: "bottom edge of the union", point: image.Pt(100, 800)},
+		{name: "left of the union", point: image.Pt(-1, 100)},
+		{name: "empty window is ignored", point: image.Pt(900, 950)},
+	}
+
+	if index.Len() != 3 {
+		t.Fatalf("Len() = %d, want 3", index.Len())
+	}
+	for _, test := range tests {
+		t.Run(test.name, func(t *testing.T) {
+			window, ok := index.TopAt(test.point)
+			if ok != test.wantOK || window.PID != test.wantPID {
+				t.Errorf("TopAt(%v) = pid %d, %v; want pid %d, %v",
+					test.point, window.PID, ok, test.wantPID, test.wantOK)
+			}
+		})
+	}
+}
+
+func TestIndexEmpty(t *testing.T) {
+	for _, windows := range [][]occlusion.Window{
+		nil,
+		{{PID: otherPID, Bounds: image.Rect(10, 10, 10, 40)}},
+	} {
+		index := occlusion.NewIndex(windows, 0)
+		if _, ok := index.TopAt(image.Pt(10, 20)); ok {
+			t.Errorf("TopAt() found a window in an index of %d windows", index.Len())
+		}
+		if !index.Visible(image.Rect(0, 0, 20, 40), appPID) {
+			t.Error("Visible() = false with no window to hide the element")
+		}
+	}
+}
+
+func TestIndexVisible(t *testing.T) {
+	// A second display left of the main one, and a full-screen window covering the main one
+	screen := image.Rect(0, 0, 1440, 900)
+	index := occlusion.NewIndex([]occlusion.Window{
+		{PID: otherPID, Bounds: screen},
+		{PID: appPID, Bounds: image.Rect(-1920, 0, 0, 1080)},
+		{PID: appPID, Bounds: image.Rect(100, 100, 800, 600)},
+	}, 0)
+
+	tests := []struct {
+		name string
+		rect image.Rectangle
+		want bool
+	}{
+		{name: "under the full-screen window", rect: image.Rect(200, 200, 240, 220)},
+		{name: "full-screen window's own corner", rect: image.Rect(1400, 880, 1440, 900)},
+		{name: "negative coordinates", rect: image.Rect(-1000, 500, -960, 520), want: true},
+		{name: "center on the displays' shared edge", rect: image.Rect(-20, 500, 20, 520)},
+		{name: "above every window", rect: image.Rect(200, -30, 240, -10), want: true},
+	}
+
+	for _, test := range tests {
+		t.Run(test.name, func(t *testing.T) {
+			if got := index.Visible(test.rect, appPID); got != test.want {
+				t.Errorf("Visible(%v) = %v, want %v", test.rect, got, test.want)
+			}
+		})
+	}
+}
+
+func TestIndexGrowsCellsOnLargeDesktops(t *testing.T) {
+	// A 1-point grid over this desktop would need far more cells than the index allows
+	index := occlusion.NewIndex([]occlusion.Window{
+		{PID: otherPID, Bounds: image.Rect(20000, 20000, 20010, 20010)},
+		{PID: appPID, Bounds: image.Rect(0, 0, 30000, 30000)},
+	}, 1)
+
+	if window, _ := index.TopAt(image.Pt(20005, 20005)); window.PID != otherPID {
+		t.Errorf("TopAt() inside the small window = pid %d, want %d", window.PID, otherPID)
+	}
+	if window, _ := index.TopAt(image.Pt(20010, 20005)); window.PID != appPID {
+		t.Errorf("TopAt() next to the small window = pid %d, want %d", window.PID, appPID)
+	}
+}
+
+// benchmarkWindows returns count windows scattered over two 5K displays, front to back.
+func benchmarkWindows(count int) []occlusion.Window {
+	random := rand.New(rand.NewSource(7))
+	windows := make([]occlusion.Window, count)
+	for i := range windows {
+		x, y := random.Intn(10240-800), random.Intn(2880-600)
+		windows[i] = occlusion.Window{
+			PID:    1 + random.Intn(8),
+			Bounds: image.Rect(x, y, x+400+random.Intn(1600), y+300+random.Intn(1200)),
+		}
+	}
+	return windows
+}
+
+func BenchmarkIndex(b *testing.B) {
+	windows := benchmarkWindows(40)
+
+	b.Run("build", func(b *testing.B) {
+		b.ReportAllocs()
+		for b.Loop() {
+			occlusion.NewIndex(windows, 0)
+		}
+	})
+
+	b.Run("visible", func(b *testing.B) {
+		index := occlusion.NewIndex(windows, 0)
+		random := rand.New(rand.NewSource(1))
+		rects := make([]image.Rectangle, 1024)
+		for i := range rects {
+			x, y := random.Intn(10240), random.Intn(2880)
+			rects[i] = image.Rect(x, y, x+24, y+24)
+		}
+
+		b.ReportAllocs()
+		i := 0
+		for b.Loop() {
+			index.Visible(rects[i%len(rects)], 1)
+			i++
+		}
+	})
+}
@@ -0,0 +1,18 @@
+//go:build !darwin
+
+package accessibility
+
+// defaultProvider serves an empty synthetic window where the accessibility API is not
+// available; tests and benchmarks install their own provider with SetProvider.
+var defaultProvider Provider = NewSyntheticProvider(SyntheticSpec{})
+
+// knownRoles returns the roles interned up front, indexed by role ID. Without the bridge only
+// the empty role is; everything else is interned on first use.
+func knownRoles() []string {
+	return []string{""}
+}
+
+// bundleIDForPID returns "": there are no application bundles without the bridge.
+func bundleIDForPID(int) string {
+	return ""
+}
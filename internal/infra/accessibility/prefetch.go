@@ -0,0 +1,244 @@
+package accessibility
+
+import (
+	"context"
+	"errors"
+	"slices"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// prefetchWorkers bounds background walks, so they stay out of the way of the application and
+// of scans the user is waiting for.
+const prefetchWorkers = 1
+
+var (
+	errPrefetchBusy      = errors.New("prefetch skipped: an activation is in progress")
+	errPrefetchCancelled = errors.New("prefetch cancelled by a scan")
+)
+
+// prefetchMaxAge is how long the result of a background walk is served, in nanoseconds;
+// 0 disables background walks.
+var prefetchMaxAge atomic.Int64
+
+// prefetch holds the running background walk and the result of the last one.
+var prefetch struct {
+	sync.Mutex
+	// running is the walk in progress, if any.
+	running *prefetchRun
+	// warm is the last completed result while it has neither been served nor expired.
+	warm *warmResult
+}
+
+// prefetchRun is one background walk.
+type prefetchRun struct {
+	cancel context.CancelFunc
+}
+
+// warmResult is the outcome of a background walk without incremental trees. Its elements
+// belong to no scope until the result is served or dropped.
+type warmResult struct {
+	window *Element
+	nodes  []*TreeNode
+	roles  []string
+	at     time.Time
+}
+
+// SetPrefetchMaxAge enables background walks whose results are served for up to maxAge; 0
+// disables them and drops a kept result.
+func SetPrefetchMaxAge(maxAge time.Duration) {
+	prefetchMaxAge.Store(int64(max(maxAge, 0)))
+	if maxAge <= 0 {
+		cancelPrefetch()
+		dropWarm(nil)
+	}
+}
+
+// PrefetchClickableElements walks the frontmost window in the background, so the next scan of
+// the same window can skip the walk. With incremental trees the walk brings the window's
+// tracked tree up to date; otherwise its clickable elements are kept for the configured max
+// age. Background walks yield to scans: none starts while an activation's scope is open, and a
+// scan starting meanwhile cancels it.
+func PrefetchClickableElements(ctx context.Context) error {
+	maxAge := time.Duration(prefetchMaxAge.Load())
+	if maxAge <= 0 {
+		return nil
+	}
+
+	scope, unhold := beginBackgroundScope()
+	if scope == nil {
+		return errPrefetchBusy
+	}
+	defer func() {
+		unhold()
+		scope.Close()
+	}()
+
+	ctx, cancel := context.WithCancel(ctx)
+	defer cancel()
+	run := &prefetchRun{cancel: cancel}
+	prefetch.Lock()
+	if prefetch.running != nil {
+		prefetch.running.cancel()
+	}
+	prefetch.running = run
+	prefetch.Unlock()
+	defer func() {
+		prefetch.Lock()
+		if prefetch.running == run {
+			prefetch.running = nil
+		}
+		prefetch.Unlock()
+	}()
+
+	cacheOnce.Do(func() {
+		globalCache = NewInfoCache(5 * time.Second)
+	})
+
+	window := currentProvider().FrontmostWindow()
+	if window == nil {
+		return errNoFrontmostWindow
+	}
+	scope.own([]*Element{window})
+
+	snapshotWindows()
+
+	opts := DefaultTreeOptions()
+	opts.scope = scope
+	opts.Cache = globalCache
+	opts.skips = newSubtreeSkips(window, false)
+	tuneOptions(&opts, window.key.pid)
+	opts.Workers = prefetchWorkers
+	opts.walk.ctx = ctx
+
+	start := time.Now()
+	if tracker := activeTracker.Load(); tracker != nil {
+		// Learning happens when a scan reads the tree; the walk only refreshes it
+		// Cancelled and truncated walks leave the tracked tree dirty
+		_, err := tracker.build(window, opts)
+		if opts.walk.cancelled() {
+			return errPrefetchCancelled
+		}
+		if err != nil {
+			return err
+		}
+		logger.Debug("Prefetched tracked tree", zap.Duration("duration", time.Since(start)))
+		return nil
+	}
+
+	roles := GetClickableRoles()
+	out := make(chan *TreeNode, 256)
+	collected := make(chan []*TreeNode)
+	go func() {
+		var nodes []*TreeNode
+		for node := range out {
+			nodes = append(nodes, node)
+		}
+		collected <- nodes
+	}()
+	_, err := streamClickable(ctx, window, opts, out)
+	close(out)
+	nodes := <-collected
+	if err != nil {
+		if ctx.Err() != nil {
+			return errPrefetchCancelled
+		}
+		return err
+	}
+
+	// The result outlives the background scope until a scan takes it
+	warm := &warmResult{
+		window: window.retain(),
+		nodes:  nodes,
+		roles:  roles,
+		at:     time.Now(),
+	}
+	KeepElements(warm.elements())
+	prefetch.Lock()
+	previous := prefetch.warm
+	prefetch.warm = warm
+	prefetch.Unlock()
+	if previous != nil {
+		previous.release()
+	}
+	time.AfterFunc(maxAge, func() { dropWarm(warm) })
+
+	logger.Debug("Prefetched clickable elements",
+		zap.Int("count", len(nodes)),
+		zap.Duration("duration", time.Since(start)))
+	return nil
+}
+
+// cancelPrefetch stops the running background walk, if any. Scans call it first, so they
+// never wait behind a walk nobody asked for.
+func cancelPrefetch() {
+	prefetch.Lock()
+	defer prefetch.Unlock()
+
+	if prefetch.running != nil {
+		prefetch.running.cancel()
+		prefetch.running = nil
+	}
+}
+
+// takePrefetched returns the kept clickable elements of window and hands them to the active
+// scope. It reports false when there are none, or they are outdated: too old, found with other
+// clickable roles, or of another window. A result is served at most once; full scans drop it.
+func takePrefetched(window *Element, full bool) ([]*TreeNode, bool) {
+	prefetch.Lock()
+	warm := prefetch.warm
+	prefetch.warm = nil
+	prefetch.Unlock()
+	if warm == nil {
+		return nil, false
+	}
+
+	age := time.Since(warm.at)
+	if full || age > time.Duration(prefetchMaxAge.Load()) ||
+		!slices.Equal(warm.roles, GetClickableRoles()) ||
+		!elementsEqual([]*Element{warm.window}, []*Element{window})[0] {
+		warm.release()
+		return nil, false
+	}
+
+	warm.window.Release()
+	activeScope.Load().own(warm.elements())
+
+	logger.Debug("Serving prefetched clickable elements",
+		zap.Int("count", len(warm.nodes)),
+		zap.Duration("age", age))
+	return warm.nodes, true
+}
+
+// dropWarm releases the kept result if it is warm, or whatever result is kept for nil.
+func dropWarm(warm *warmResult) {
+	prefetch.Lock()
+	current := prefetch.warm
+	if current == nil || (warm != nil && current != warm) {
+		prefetch.Unlock()
+		return
+	}
+	prefetch.warm = nil
+	prefetch.Unlock()
+
+	current.release()
+}
+
+// elements returns the elements of the result's nodes.
+func (w *warmResult) elements() []*Element {
+	elements := make([]*Element, len(w.nodes))
+	for index, node := range w.nodes {
+		elements[index] = node.Element
+	}
+	return elements
+}
+
+// release drops the references of the result's window and elements.
+func (w *warmResult) release() {
+	w.window.Release()
+	ReleaseElements(w.elements())
+}
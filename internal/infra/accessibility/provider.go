@@ -0,0 +1,96 @@
+package accessibility
+
+import (
+	"image"
+	"sync/atomic"
+	"time"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+)
+
+// ClickAction tells how an element qualifies as clickable. The values match the bridge's
+// ClickAction enum.
+type ClickAction int
+
+const (
+	// ClickActionNone marks elements that are not clickable.
+	ClickActionNone ClickAction = iota
+	// ClickActionPresent marks elements that are clickable wherever they are.
+	ClickActionPresent
+	// ClickActionIfVisible marks elements that are clickable only if their center is not
+	// covered by a window of another application.
+	ClickActionIfVisible
+)
+
+// Provider is the source of everything tree walks read: children, element info,
+// clickability, the on-screen windows and the screen bounds. On macOS the default provider
+// queries the accessibility API through the bridge. SyntheticProvider generates trees in
+// memory and ReplayProvider serves recorded snapshots, so traversal and filtering run, and
+// can be benchmarked, on any platform.
+//
+// Element references are opaque to the rest of the package; only the provider that handed
+// out an element interprets its reference. Elements returned by FrontmostWindow and
+// ChildrenWithInfo belong to no scope; the caller hands them to the scope of its walk.
+type Provider interface {
+	// FrontmostWindow returns the focused window of the frontmost application, or nil.
+	FrontmostWindow() *Element
+	// Info returns the positioning and role of the element.
+	Info(element *Element) (*ElementInfo, error)
+	// ChildrenWithInfo returns the children of the element together with their info. roleID
+	// is the element's own role. Infos are nil for children whose attributes could not be
+	// fetched. timedOut reports that the application did not answer in time.
+	ChildrenWithInfo(element *Element, roleID RoleID) ([]*Element, []*ElementInfo, bool)
+	// ClickAction classifies how the element qualifies as clickable, without testing whether
+	// it is covered.
+	ClickAction(element *Element) ClickAction
+	// BundleIdentifier returns the bundle identifier of the element's application.
+	BundleIdentifier(element *Element) string
+	// Title returns the element's title, or "" if it has none. Walks never need it; it is
+	// read when recording snapshots.
+	Title(element *Element) string
+	// Equal reports, pairwise, whether two equally long element lists refer to the same
+	// elements.
+	Equal(first, second []*Element) []bool
+	// Retain returns a new reference to the element behind ref.
+	Retain(ref unsafe.Pointer) unsafe.Pointer
+	// Release drops references.
+	Release(refs []unsafe.Pointer)
+	// Windows returns the on-screen windows front to back, or nil if they are unknown.
+	Windows() []occlusion.Window
+	// ActiveScreenBounds returns the bounds of the screen containing the cursor.
+	ActiveScreenBounds() image.Rectangle
+	// SetMessagingTimeout bounds the requests to the process; pid 0 sets the default for
+	// every process and a timeout of 0 removes the bound.
+	SetMessagingTimeout(pid int, timeout time.Duration)
+	// Observe starts delivering the process's change notifications to the incremental tree
+	// tracker and the source cache. It returns the function that stops it, or nil if the
+	// process cannot be observed.
+	Observe(pid int) func()
+}
+
+// providerHolder lets an interface value live in an atomic pointer.
+type providerHolder struct {
+	provider Provider
+}
+
+// activeProvider is nil until SetProvider is called; defaultProvider applies until then.
+var activeProvider atomic.Pointer[providerHolder]
+
+// SetProvider replaces the provider tree walks read from; nil restores the platform default.
+// Elements obtained from the previous provider must not be used afterwards.
+func SetProvider(provider Provider) {
+	if provider == nil {
+		activeProvider.Store(nil)
+		return
+	}
+	activeProvider.Store(&providerHolder{provider: provider})
+}
+
+// currentProvider returns the provider in use.
+func currentProvider() Provider {
+	if holder := activeProvider.Load(); holder != nil {
+		return holder.provider
+	}
+	return defaultProvider
+}
@@ -0,0 +1,236 @@
+package accessibility
+
+/*
+#cgo CFLAGS: -x objective-c
+#include "../bridge/accessibility.h"
+#include <stdlib.h>
+
+extern void elementObserverCallbackBridge(int kind, ElementIdentity element, ElementIdentity parent, void *userData);
+*/
+import "C"
+
+import (
+	"image"
+	"time"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/incremental"
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// maxSnapshotWindows bounds the windows one snapshot holds; the frontmost come first.
+const maxSnapshotWindows = 256
+
+// defaultProvider queries the macOS accessibility API.
+var defaultProvider Provider = bridgeProvider{}
+
+// bridgeProvider implements Provider on top of the Objective-C bridge.
+type bridgeProvider struct{}
+
+// FrontmostWindow returns the focused window of the frontmost application, or nil.
+func (bridgeProvider) FrontmostWindow() *Element {
+	ref := C.getFrontmostWindow()
+	if ref == nil {
+		return nil
+	}
+	return wrapElements([]unsafe.Pointer{ref})[0]
+}
+
+// Info returns the positioning and role of the element.
+func (bridgeProvider) Info(element *Element) (*ElementInfo, error) {
+	cInfo := C.getElementInfo(element.ref)
+	if cInfo == nil {
+		return nil, errGetInfoFailed
+	}
+	defer C.freeElementInfo(cInfo)
+
+	info := elementInfoFromC(cInfo)
+
+	return &info, nil
+}
+
+// ChildrenWithInfo returns the children of the element together with their info using a
+// single bridge call. The Elements and ElementInfos each share one backing allocation.
+func (bridgeProvider) ChildrenWithInfo(
+	element *Element,
+	roleID RoleID,
+) ([]*Element, []*ElementInfo, bool) {
+	var cTimedOut C.int
+	packed := C.getChildrenWithInfo(element.ref, C.int(roleID), &cTimedOut)
+	timedOut := cTimedOut != 0
+	if packed == nil {
+		return nil, nil, timedOut
+	}
+	defer C.freeElementChildren(packed)
+
+	count := int(packed.count)
+	refs := unsafe.Slice(packed.elements, count)
+	identities := unsafe.Slice(packed.identities, count)
+	cInfos := unsafe.Slice(packed.infos, count)
+
+	elements := make([]*Element, count)
+	infos := make([]*ElementInfo, count)
+	elementBacking := make([]Element, count)
+	infoBacking := make([]ElementInfo, count)
+	for i := range count {
+		elementBacking[i] = Element{
+			ref: refs[i],
+			key: elementKey{
+				hash: uint64(identities[i].hash),
+				pid:  int(identities[i].pid),
+			},
+		}
+		elements[i] = &elementBacking[i]
+
+		err := infoError(&cInfos[i])
+		if err != nil {
+			logger.Debug("Failed to get child element info", zap.Error(err))
+			continue
+		}
+		infoBacking[i] = elementInfoFromC(&cInfos[i])
+		infos[i] = &infoBacking[i]
+	}
+	trackRefs(count)
+
+	return elements, infos, timedOut
+}
+
+// ClickAction classifies the element with the bridge's action, focus and role checks.
+func (bridgeProvider) ClickAction(element *Element) ClickAction {
+	return ClickAction(C.getClickAction(element.ref))
+}
+
+// BundleIdentifier returns the bundle identifier of the element's application.
+func (bridgeProvider) BundleIdentifier(element *Element) string {
+	cBundleID := C.getBundleIdentifier(element.ref)
+	if cBundleID == nil {
+		return ""
+	}
+	defer C.freeString(cBundleID)
+
+	return C.GoString(cBundleID)
+}
+
+// Title returns the element's title attribute.
+func (bridgeProvider) Title(element *Element) string {
+	attributes, err := element.GetAttributes()
+	if err != nil {
+		return ""
+	}
+	return attributes.Title
+}
+
+// Equal compares the references pairwise with CFEqual in one bridge call.
+func (bridgeProvider) Equal(first, second []*Element) []bool {
+	firstRefs := make([]unsafe.Pointer, len(first))
+	secondRefs := make([]unsafe.Pointer, len(second))
+	for i := range first {
+		firstRefs[i] = first[i].ref
+		secondRefs[i] = second[i].ref
+	}
+
+	cEqual := make([]C.bool, len(first))
+	C.elementsEqualBatch(&firstRefs[0], &secondRefs[0], C.int(len(first)), &cEqual[0])
+
+	equal := make([]bool, len(first))
+	for i, value := range cEqual {
+		equal[i] = bool(value)
+	}
+	return equal
+}
+
+// Retain returns a new reference to the element behind ref.
+func (bridgeProvider) Retain(ref unsafe.Pointer) unsafe.Pointer {
+	return C.retainElement(ref)
+}
+
+// Release drops references with one bridge call.
+func (bridgeProvider) Release(refs []unsafe.Pointer) {
+	C.releaseElements(&refs[0], C.int(len(refs)))
+}
+
+// Windows returns the on-screen windows that can cover application content, front to back.
+func (bridgeProvider) Windows() []occlusion.Window {
+	var frames [maxSnapshotWindows]C.WindowFrame
+	count := int(C.getOnScreenWindows(&frames[0], C.int(len(frames))))
+	if count < 0 {
+		return nil
+	}
+
+	windows := make([]occlusion.Window, count)
+	for i := range count {
+		windows[i] = occlusion.Window{
+			PID:    int(frames[i].pid),
+			Bounds: rectFromCG(frames[i].bounds),
+		}
+	}
+	return windows
+}
+
+// ActiveScreenBounds returns the bounds of the screen containing the cursor.
+func (bridgeProvider) ActiveScreenBounds() image.Rectangle {
+	return rectFromCG(C.getActiveScreenBounds())
+}
+
+// SetMessagingTimeout bounds the requests to the process, or to all processes for pid 0.
+func (bridgeProvider) SetMessagingTimeout(pid int, timeout time.Duration) {
+	if pid == 0 {
+		C.setGlobalMessagingTimeout(C.float(timeout.Seconds()))
+		return
+	}
+	C.setApplicationMessagingTimeout(C.int(pid), C.float(timeout.Seconds()))
+}
+
+// Observe creates an accessibility observer for the process.
+func (bridgeProvider) Observe(pid int) func() {
+	observer := C.createElementObserver(
+		C.int(pid),
+		C.ElementObserverCallback(C.elementObserverCallbackBridge),
+		nil,
+	)
+	if observer == nil {
+		return nil
+	}
+	return func() {
+		C.destroyElementObserver(observer)
+	}
+}
+
+// rectFromCG converts a bridge rectangle to screen coordinates.
+func rectFromCG(rect C.CGRect) image.Rectangle {
+	return image.Rect(
+		int(rect.origin.x),
+		int(rect.origin.y),
+		int(rect.origin.x+rect.size.width),
+		int(rect.origin.y+rect.size.height),
+	)
+}
+
+// bundleIDForPID returns the bundle identifier of the process, or "" if it has none.
+func bundleIDForPID(pid int) string {
+	app := GetApplicationByPID(pid)
+	if app == nil {
+		return ""
+	}
+	defer app.Release()
+	return app.GetBundleIdentifier()
+}
+
+// elementObserverCallbackBridge forwards observer notifications to the active tracker and
+// source cache. It runs on the bridge's serial event queue and must stay cheap.
+//
+//export elementObserverCallbackBridge
+func elementObserverCallbackBridge(
+	kind C.int,
+	element C.ElementIdentity,
+	parent C.ElementIdentity,
+	_ unsafe.Pointer,
+) {
+	dispatchElementEvent(incremental.Event{
+		Kind:    incremental.EventKind(kind),
+		Element: incremental.Key{PID: int(element.pid), Hash: uint64(element.hash)},
+		Parent:  incremental.Key{PID: int(parent.pid), Hash: uint64(parent.hash)},
+	})
+}
@@ -0,0 +1,20 @@
+// Package pruning learns, per application, which accessibility subtrees never contain a
+// clickable element, so tree walks can skip them without enumerating their children.
+//
+// A subtree is identified by a Signature: the chain of role names from the window root
+// down to the subtree's root, combined with the subtree's frame relative to the window,
+// rounded to coarse buckets. Signatures carry no element identity, so they stay meaningful
+// across activations and restarts as long as the application's layout does.
+//
+// Key Features:
+//   - Learning: A subtree is skipped only after several walks found it large and without a
+//     clickable element; a single clickable descendant forgets it. Walks that do not reach
+//     the subtree, or find it small, count neither way
+//   - Aging: A skip decision expires after a while, so the subtree is walked again to
+//     confirm it; entries that are not confirmed are dropped
+//   - Bounded Memory: Each application keeps a fixed number of entries, oldest dropped first
+//   - Persistence: The store can be saved to and loaded from a JSON file between restarts
+//
+// The package has no platform dependencies; the accessibility package computes signatures
+// during its walks and reports what each walk observed.
+package pruning
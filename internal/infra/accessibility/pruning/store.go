@@ -0,0 +1,269 @@
+package pruning
+
+import (
+	"errors"
+	"fmt"
+	"hash/fnv"
+	"image"
+	"sync"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/persist"
+)
+
+const (
+	// DefaultMinObservations is how many walks must find a subtree barren, with none finding
+	// a clickable element in between, before it is skipped.
+	DefaultMinObservations = 3
+	// DefaultMaxAge is how long a skip decision holds before the subtree is walked again.
+	DefaultMaxAge = 30 * time.Minute
+	// MinSubtreeNodes is the smallest barren subtree worth learning; skipping smaller
+	// ones saves less than the lookups cost.
+	MinSubtreeNodes = 16
+
+	// frameBucket is the granularity, in points, of the frame part of a signature.
+	frameBucket = 64
+	// maxEntriesPerApp bounds the entries kept for one application.
+	maxEntriesPerApp = 1024
+	// forgetAfter is how many max ages an entry survives without being observed.
+	forgetAfter = 48
+	// fileVersion is the version of the persisted format.
+	fileVersion = 1
+)
+
+// errUnsupportedVersion is returned when loading a file written by another format version.
+var errUnsupportedVersion = errors.New("unsupported pruning file version")
+
+// Signature identifies a subtree by its role path and coarse frame.
+type Signature uint64
+
+// Path extends the role path of a parent with the role of a child. The root's path is
+// Path(0, role).
+func Path(parent uint64, role string) uint64 {
+	hash := fnv.New64a()
+	var buffer [8]byte
+	for index := range buffer {
+		buffer[index] = byte(parent >> (8 * index))
+	}
+	_, _ = hash.Write(buffer[:])
+	_, _ = hash.Write([]byte(role))
+	return hash.Sum64()
+}
+
+// Sign combines a role path with a subtree root's frame, given relative to the window origin.
+func Sign(path uint64, frame image.Rectangle) Signature {
+	buckets := [4]int{
+		floorDiv(frame.Min.X, frameBucket),
+		floorDiv(frame.Min.Y, frameBucket),
+		floorDiv(frame.Dx(), frameBucket),
+		floorDiv(frame.Dy(), frameBucket),
+	}
+
+	signature := path
+	for _, bucket := range buckets {
+		// FNV-1a style mixing of each bucket into the path hash
+		signature ^= uint64(int64(bucket))
+		signature *= 1099511628211
+	}
+	return Signature(signature)
+}
+
+// Observation is what one walk saw below a subtree root.
+// Nodes counts the root and its descendants; Clickables counts the clickable ones among them.
+type Observation struct {
+	Signature  Signature
+	Nodes      int
+	Clickables int
+}
+
+// entry is the learned state of one signature.
+type entry struct {
+	// Barren counts the walks that found the subtree large and without clickable elements
+	// since one last found a clickable element in it.
+	Barren int `json:"barren"`
+	// Seen is the Unix time in seconds of the last walk that observed the subtree.
+	Seen int64 `json:"seen"`
+}
+
+// Store holds the learned skip lists of all applications, keyed by bundle ID.
+// It is safe for concurrent use.
+type Store struct {
+	mu              sync.Mutex
+	apps            map[string]map[Signature]*entry
+	minObservations int
+	maxAge          time.Duration
+	dirty           bool
+}
+
+// NewStore creates an empty store. A subtree is skipped once minObservations walks found it
+// barren without one finding a clickable element in between, for at most maxAge after the
+// last of them.
+func NewStore(minObservations int, maxAge time.Duration) *Store {
+	if minObservations <= 0 {
+		minObservations = DefaultMinObservations
+	}
+	if maxAge <= 0 {
+		maxAge = DefaultMaxAge
+	}
+	return &Store{
+		apps:            make(map[string]map[Signature]*entry),
+		minObservations: minObservations,
+		maxAge:          maxAge,
+	}
+}
+
+// Skips returns the signatures of the application's subtrees that walks should skip now.
+// The returned set is a snapshot owned by the caller, so lookups during a walk take no lock.
+func (s *Store) Skips(bundleID string, now time.Time) map[Signature]struct{} {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	entries := s.apps[bundleID]
+	skips := make(map[Signature]struct{}, len(entries))
+	cutoff := now.Add(-s.maxAge).Unix()
+	for signature, learned := range entries {
+		if learned.Barren >= s.minObservations && learned.Seen > cutoff {
+			skips[signature] = struct{}{}
+		}
+	}
+	return skips
+}
+
+// Observe records what a complete walk of the application saw. Subtrees with a clickable
+// element are forgotten; large barren subtrees move closer to being skipped.
+func (s *Store) Observe(bundleID string, observations []Observation, now time.Time) {
+	if bundleID == "" || len(observations) == 0 {
+		return
+	}
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	entries := s.apps[bundleID]
+	for _, observation := range observations {
+		if observation.Clickables > 0 {
+			if _, ok := entries[observation.Signature]; ok {
+				delete(entries, observation.Signature)
+				s.dirty = true
+			}
+			continue
+		}
+		if observation.Nodes < MinSubtreeNodes {
+			continue
+		}
+
+		if entries == nil {
+			entries = make(map[Signature]*entry)
+			s.apps[bundleID] = entries
+		}
+		learned := entries[observation.Signature]
+		if learned == nil {
+			learned = &entry{}
+			entries[observation.Signature] = learned
+		}
+		learned.Barren++
+		learned.Seen = now.Unix()
+		s.dirty = true
+	}
+
+	persist.Trim(entries, maxEntriesPerApp, seenAt)
+}
+
+// Forget drops everything learned about the application, or about all applications when
+// bundleID is empty.
+func (s *Store) Forget(bundleID string) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if bundleID == "" {
+		clear(s.apps)
+	} else {
+		delete(s.apps, bundleID)
+	}
+	s.dirty = true
+}
+
+// storeFile is the persisted form of a Store.
+type storeFile struct {
+	Version int                             `json:"version"`
+	Apps    map[string]map[Signature]*entry `json:"apps"`
+}
+
+// Load replaces the store's contents with the file at path, dropping entries that
+// expired while the file was on disk. A missing file leaves the store empty.
+func (s *Store) Load(path string, now time.Time) error {
+	var file storeFile
+	found, err := persist.ReadJSON(path, &file)
+	if err != nil {
+		return fmt.Errorf("failed to load pruning file: %w", err)
+	}
+	if !found {
+		return nil
+	}
+	if file.Version != fileVersion {
+		return fmt.Errorf("%w: %d", errUnsupportedVersion, file.Version)
+	}
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	s.apps = make(map[string]map[Signature]*entry, len(file.Apps))
+	for bundleID, entries := range file.Apps {
+		for signature, learned := range entries {
+			if learned == nil {
+				delete(entries, signature)
+			}
+		}
+		if entries != nil {
+			s.apps[bundleID] = entries
+		}
+	}
+	s.expireLocked(now)
+	s.dirty = false
+	return nil
+}
+
+// Save writes the store to path if it changed since the last Load or Save. The file is
+// replaced atomically.
+func (s *Store) Save(path string, now time.Time) error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if !s.dirty {
+		return nil
+	}
+	s.expireLocked(now)
+
+	err := persist.WriteJSON(path, storeFile{Version: fileVersion, Apps: s.apps})
+	if err != nil {
+		return fmt.Errorf("failed to save pruning file: %w", err)
+	}
+
+	s.dirty = false
+	return nil
+}
+
+// expireLocked drops entries that were not observed for forgetAfter max ages.
+func (s *Store) expireLocked(now time.Time) {
+	cutoff := now.Add(-forgetAfter * s.maxAge).Unix()
+	for bundleID, entries := range s.apps {
+		persist.Expire(entries, cutoff, seenAt)
+		if len(entries) == 0 {
+			delete(s.apps, bundleID)
+		}
+	}
+}
+
+// seenAt returns when the entry was last observed, in Unix seconds.
+func seenAt(learned *entry) int64 {
+	return learned.Seen
+}
+
+// floorDiv divides rounding towards negative infinity, so buckets do not straddle zero.
+func floorDiv(value, divisor int) int {
+	quotient := value / divisor
+	if value%divisor != 0 && value < 0 {
+		quotient--
+	}
+	return quotient
+}
@@ -0,0 +1,119 @@
+package accessibility
+
+import (
+	"fmt"
+	"strings"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// PrintTree outputs the accessibility tree structure to the log for debugging purposes.
+func PrintTree(node *TreeNode, depth int) {
+	if node == nil || node.Info == nil {
+		return
+	}
+	var indent strings.Builder
+	for range depth {
+		indent.WriteString("  ")
+	}
+
+	// Titles are not part of ElementInfo; fetch them only for the dump
+	var title string
+	attributes, err := node.Element.GetAttributes()
+	if err == nil {
+		title = attributes.Title
+	}
+
+	logger.Info(fmt.Sprintf("%sRole: %s, Title: %s, Size: %dx%d",
+		indent.String(), node.Info.Role, title, node.Info.Size.X, node.Info.Size.Y))
+
+	for _, child := range node.Children {
+		PrintTree(child, depth+1)
+	}
+}
+
+// GetMenuBarClickableElements retrieves clickable UI elements from the focused application's menu bar.
+func GetMenuBarClickableElements() ([]*TreeNode, error) {
+	logger.Debug("Getting clickable elements for menu bar")
+
+	cacheOnce.Do(func() {
+		globalCache = NewInfoCache(5 * time.Second)
+	})
+
+	app := GetFocusedApplication()
+	if app == nil {
+		logger.Debug("No focused application found")
+		return []*TreeNode{}, nil
+	}
+	defer app.Release()
+
+	key := sourceKey{pid: app.key.pid, menubar: true}
+	if elements, ok := cachedSource(key); ok {
+		logger.Debug("Using cached menu bar clickable elements", zap.Int("count", len(elements)))
+		return elements, nil
+	}
+
+	menubar := app.GetMenuBar()
+	if menubar == nil {
+		logger.Debug("No menu bar found")
+		return []*TreeNode{}, nil
+	}
+	defer menubar.Release()
+
+	opts := DefaultTreeOptions()
+	opts.Cache = globalCache
+	tuneOptions(&opts, menubar.key.pid)
+
+	elements, err := findClickableFlat(menubar, opts)
+	if err != nil {
+		logger.Error("Failed to build tree for menu bar", zap.Error(err))
+		return nil, err
+	}
+	logger.Debug("Found menu bar clickable elements", zap.Int("count", len(elements)))
+	storeSource(key, app.GetBundleIdentifier(), menubar, elements)
+	return elements, nil
+}
+
+// GetClickableElementsFromBundleID retrieves clickable UI elements from the application identified by bundle ID.
+func GetClickableElementsFromBundleID(bundleID string) ([]*TreeNode, error) {
+	logger.Debug("Getting clickable elements for bundle ID", zap.String("bundle_id", bundleID))
+
+	cacheOnce.Do(func() {
+		globalCache = NewInfoCache(5 * time.Second)
+	})
+
+	app := GetApplicationByBundleID(bundleID)
+	if app == nil {
+		logger.Debug("Application not found for bundle ID", zap.String("bundle_id", bundleID))
+		return []*TreeNode{}, nil
+	}
+	defer app.Release()
+
+	key := sourceKey{pid: app.key.pid}
+	if elements, ok := cachedSource(key); ok {
+		logger.Debug("Using cached clickable elements for application",
+			zap.String("bundle_id", bundleID),
+			zap.Int("count", len(elements)))
+		return elements, nil
+	}
+
+	opts := DefaultTreeOptions()
+	opts.Cache = globalCache
+	opts.IncludeOutOfBounds = true
+	tuneOptions(&opts, app.key.pid)
+
+	elements, err := findClickableFlat(app, opts)
+	if err != nil {
+		logger.Error("Failed to build tree for application",
+			zap.String("bundle_id", bundleID),
+			zap.Error(err))
+		return nil, err
+	}
+	logger.Debug("Found clickable elements for application",
+		zap.String("bundle_id", bundleID),
+		zap.Int("count", len(elements)))
+	storeSource(key, bundleID, app, elements)
+	return elements, nil
+}
@@ -0,0 +1,18 @@
+//go:build neru_debug
+
+package accessibility
+
+import "sync/atomic"
+
+// liveRefs counts the element references wrapped by Go that have not been released yet.
+var liveRefs atomic.Int64
+
+// trackRefs adjusts the live reference counter.
+func trackRefs(delta int) {
+	liveRefs.Add(int64(delta))
+}
+
+// LiveElementRefs returns the number of element references wrapped by Go and not released.
+func LiveElementRefs() int64 {
+	return liveRefs.Load()
+}
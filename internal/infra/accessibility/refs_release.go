@@ -0,0 +1,12 @@
+//go:build !neru_debug
+
+package accessibility
+
+// trackRefs is a no-op outside of neru_debug builds.
+func trackRefs(int) {}
+
+// LiveElementRefs returns the number of element references wrapped by Go and not released.
+// It is only tracked in builds with the neru_debug tag and is -1 otherwise.
+func LiveElementRefs() int64 {
+	return -1
+}
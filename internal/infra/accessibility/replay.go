@@ -0,0 +1,169 @@
+package accessibility
+
+import (
+	"image"
+	"time"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+	"github.com/y3owk1n/neru/internal/infra/accessibility/snapshot"
+)
+
+// ReplayProvider serves a recorded snapshot, so scans of a real application's tree can be
+// reproduced and benchmarked offline. Element references point into the mapped file; no node
+// is copied until a walk reads it.
+type ReplayProvider struct {
+	file *snapshot.File
+	// roles and names resolve the file's role indices once.
+	roles []RoleID
+	names []string
+}
+
+// OpenReplay opens the snapshot at path. The provider must be closed once no element from it
+// is used anymore.
+func OpenReplay(path string) (*ReplayProvider, error) {
+	file, err := snapshot.Open(path)
+	if err != nil {
+		return nil, err
+	}
+
+	provider := &ReplayProvider{
+		file:  file,
+		roles: make([]RoleID, file.RoleCount()),
+		names: make([]string, file.RoleCount()),
+	}
+	for role := range provider.roles {
+		provider.roles[role] = InternRole(file.RoleName(role))
+		provider.names[role] = provider.roles[role].String()
+	}
+	return provider, nil
+}
+
+// Close unmaps the snapshot.
+func (p *ReplayProvider) Close() error {
+	return p.file.Close()
+}
+
+// Len returns the number of recorded elements, the window included.
+func (p *ReplayProvider) Len() int {
+	return p.file.Len()
+}
+
+// BundleID returns the bundle identifier of the recorded application.
+func (p *ReplayProvider) BundleID() string {
+	return p.file.BundleID()
+}
+
+// FrontmostWindow returns the recorded window, the root of the tree.
+func (p *ReplayProvider) FrontmostWindow() *Element {
+	trackRefs(1)
+	return p.element(0)
+}
+
+// Info returns the recorded frame and role of the element.
+func (p *ReplayProvider) Info(element *Element) (*ElementInfo, error) {
+	info := p.info(p.file.Index(element.ref))
+	return &info, nil
+}
+
+// ChildrenWithInfo returns the recorded children of the element.
+func (p *ReplayProvider) ChildrenWithInfo(
+	element *Element,
+	_ RoleID,
+) ([]*Element, []*ElementInfo, bool) {
+	first, count := p.file.Children(p.file.Index(element.ref))
+	if count == 0 {
+		return nil, nil, false
+	}
+
+	elements := make([]*Element, count)
+	infos := make([]*ElementInfo, count)
+	elementBacking := make([]Element, count)
+	infoBacking := make([]ElementInfo, count)
+	for i := range int(count) {
+		child := int(first) + i
+		elementBacking[i].ref, elementBacking[i].key = p.reference(child)
+		elements[i] = &elementBacking[i]
+		infoBacking[i] = p.info(child)
+		infos[i] = &infoBacking[i]
+	}
+	trackRefs(int(count))
+
+	return elements, infos, false
+}
+
+// ClickAction returns the click action recorded for the element. Elements recorded as
+// clickable if visible are resolved against the recorded windows.
+func (p *ReplayProvider) ClickAction(element *Element) ClickAction {
+	return ClickAction(p.file.Action(p.file.Index(element.ref)))
+}
+
+// BundleIdentifier returns the bundle identifier of the recorded application.
+func (p *ReplayProvider) BundleIdentifier(*Element) string {
+	return p.file.BundleID()
+}
+
+// Title returns the recorded title of the element.
+func (p *ReplayProvider) Title(element *Element) string {
+	return p.file.Title(p.file.Index(element.ref))
+}
+
+// Equal compares the elements pairwise by reference.
+func (p *ReplayProvider) Equal(first, second []*Element) []bool {
+	equal := make([]bool, len(first))
+	for i := range first {
+		equal[i] = first[i].ref == second[i].ref
+	}
+	return equal
+}
+
+// Retain returns ref; recorded elements live as long as the provider.
+func (p *ReplayProvider) Retain(ref unsafe.Pointer) unsafe.Pointer {
+	return ref
+}
+
+// Release does nothing; recorded elements live as long as the provider.
+func (p *ReplayProvider) Release([]unsafe.Pointer) {}
+
+// Windows returns the on-screen windows at the time of recording.
+func (p *ReplayProvider) Windows() []occlusion.Window {
+	return p.file.Windows()
+}
+
+// ActiveScreenBounds returns the active screen at the time of recording.
+func (p *ReplayProvider) ActiveScreenBounds() image.Rectangle {
+	return p.file.Screen()
+}
+
+// SetMessagingTimeout does nothing; recorded replies never time out.
+func (p *ReplayProvider) SetMessagingTimeout(int, time.Duration) {}
+
+// Observe returns nil; recorded trees never change.
+func (p *ReplayProvider) Observe(int) func() {
+	return nil
+}
+
+// element wraps the node at index. The key's hash is unique per node and never 0.
+func (p *ReplayProvider) element(index int) *Element {
+	element := &Element{}
+	element.ref, element.key = p.reference(index)
+	return element
+}
+
+// reference returns the reference and identity of the node at index.
+func (p *ReplayProvider) reference(index int) (unsafe.Pointer, elementKey) {
+	return p.file.Ref(index), elementKey{hash: uint64(index) + 1, pid: p.file.PID()}
+}
+
+// info returns the ElementInfo of the node at index.
+func (p *ReplayProvider) info(index int) ElementInfo {
+	frame := p.file.Frame(index)
+	role := p.file.Role(index)
+	return ElementInfo{
+		Position: frame.Min,
+		Size:     frame.Size(),
+		Role:     p.names[role],
+		RoleID:   p.roles[role],
+		PID:      p.file.PID(),
+	}
+}
@@ -0,0 +1,132 @@
+package accessibility
+
+import (
+	"math"
+	"math/bits"
+	"sync"
+)
+
+// RoleID is a compact identifier for an accessibility role name.
+// IDs below the bridge's ElementRoleCount are shared with the Objective-C bridge; other
+// roles are assigned IDs on first use. IDs stay valid for the lifetime of the process.
+type RoleID uint16
+
+// RoleUnknown is the ID of the empty role.
+const RoleUnknown RoleID = 0
+
+var internedRoles = newRoleTable()
+
+// roleNames holds the interned role names and their IDs.
+type roleNames struct {
+	mu    sync.RWMutex
+	ids   map[string]RoleID
+	names []string
+}
+
+// newRoleTable seeds the table with the platform's known roles, so roles known to the bridge
+// have the same IDs on both sides.
+func newRoleTable() *roleNames {
+	known := knownRoles()
+	table := &roleNames{
+		ids:   make(map[string]RoleID, len(known)*2),
+		names: make([]string, len(known), len(known)*2),
+	}
+
+	for id, name := range known {
+		table.names[id] = name
+		table.ids[name] = RoleID(id)
+	}
+
+	return table
+}
+
+// InternRole returns the ID of a role name, assigning a new one if needed.
+func InternRole(name string) RoleID {
+	internedRoles.mu.RLock()
+	id, ok := internedRoles.ids[name]
+	internedRoles.mu.RUnlock()
+	if ok {
+		return id
+	}
+
+	internedRoles.mu.Lock()
+	defer internedRoles.mu.Unlock()
+	return internedRoles.addLocked(name)
+}
+
+// String returns the role name the ID was interned from.
+func (r RoleID) String() string {
+	internedRoles.mu.RLock()
+	defer internedRoles.mu.RUnlock()
+
+	if int(r) < len(internedRoles.names) {
+		return internedRoles.names[r]
+	}
+	return ""
+}
+
+// addLocked interns a name. Callers must hold the write lock.
+func (t *roleNames) addLocked(name string) RoleID {
+	if id, ok := t.ids[name]; ok {
+		return id
+	}
+	if len(t.names) > math.MaxUint16 {
+		return RoleUnknown
+	}
+
+	id := RoleID(len(t.names))
+	t.ids[name] = id
+	t.names = append(t.names, name)
+	return id
+}
+
+// RoleSet is an immutable bitset of role IDs.
+type RoleSet struct {
+	bits []uint64
+}
+
+// NewRoleSet interns the given role names and returns the set containing them.
+func NewRoleSet(names ...string) RoleSet {
+	var set RoleSet
+	for _, name := range names {
+		id := InternRole(name)
+		if id == RoleUnknown {
+			continue
+		}
+
+		word := int(id) / 64
+		for len(set.bits) <= word {
+			set.bits = append(set.bits, 0)
+		}
+		set.bits[word] |= 1 << (uint(id) % 64)
+	}
+	return set
+}
+
+// Has reports whether the set contains the role.
+func (s RoleSet) Has(id RoleID) bool {
+	word := int(id) / 64
+	return word < len(s.bits) && s.bits[word]&(1<<(uint(id)%64)) != 0
+}
+
+// Len returns the number of roles in the set.
+func (s RoleSet) Len() int {
+	count := 0
+	for _, word := range s.bits {
+		count += bits.OnesCount64(word)
+	}
+	return count
+}
+
+// Names returns the role names in the set, ordered by ID.
+func (s RoleSet) Names() []string {
+	names := make([]string, 0, s.Len())
+	for word, value := range s.bits {
+		for value != 0 {
+			bit := bits.TrailingZeros64(value)
+			names = append(names, RoleID(word*64+bit).String())
+			value &= value - 1
+		}
+	}
+	return names
+}
@@ -0,0 +1,50 @@
+package accessibility
+
+/*
+#cgo CFLAGS: -x objective-c
+#include "../bridge/accessibility.h"
+#include <string.h>
+*/
+import "C"
+
+import "unsafe"
+
+// knownRoles returns the bridge's role table, indexed by role ID; ID 0 is the empty role.
+func knownRoles() []string {
+	count := int(C.ElementRoleCount)
+	names := make([]string, count)
+	for id := 1; id < count; id++ {
+		names[id] = C.GoString(C.roleNameForID(C.int(id)))
+	}
+	return names
+}
+
+// roleFromC resolves the role of a bridge ElementInfo. Known roles arrive as an ID only;
+// other role names are looked up without copying, so a role is allocated once per process.
+func roleFromC(cInfo *C.ElementInfo) (RoleID, string) {
+	if cInfo.roleID != C.ElementRoleUnknown {
+		id := RoleID(cInfo.roleID)
+		return id, id.String()
+	}
+	if cInfo.role == nil {
+		return RoleUnknown, ""
+	}
+
+	raw := unsafe.Slice((*byte)(unsafe.Pointer(cInfo.role)), int(C.strlen(cInfo.role)))
+
+	internedRoles.mu.RLock()
+	id, ok := internedRoles.ids[string(raw)]
+	var name string
+	if ok {
+		name = internedRoles.names[id]
+	}
+	internedRoles.mu.RUnlock()
+	if ok {
+		return id, name
+	}
+
+	internedRoles.mu.Lock()
+	defer internedRoles.mu.Unlock()
+	id = internedRoles.addLocked(string(raw))
+	return id, internedRoles.names[id]
+}
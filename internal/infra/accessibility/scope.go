@@ -0,0 +1,223 @@
+package accessibility
+
+import (
+	"sync"
+	"sync/atomic"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// Scope owns the accessibility references wrapped while it is active: tree nodes, children,
+// windows and applications of one mode activation. Closing the scope releases all of them
+// with a single bridge call. Elements that must outlive the scope are opted out with Keep.
+//
+// Traversals run inside the scope given in their TreeOptions and hold it while their workers
+// run. Without one, returned elements belong to the caller, and elements dropped by the
+// traversal filters are never released.
+type Scope struct {
+	mu       sync.Mutex
+	elements []*Element
+	// holds counts running traversals; closing waits for them so no element is released
+	// while a worker still uses it.
+	holds   int
+	closing bool
+	closed  bool
+}
+
+// activeScope owns the elements wrapped outside of traversals, such as windows and
+// applications looked up by an activation. Traversals hand their elements to the scope in
+// their TreeOptions instead. It stays set after EndScope; a closed scope owns nothing.
+var activeScope atomic.Pointer[Scope]
+
+// BeginScope makes a new scope active and closes the previous one.
+func BeginScope() *Scope {
+	scope := &Scope{elements: make([]*Element, 0, 1024)}
+	if previous := activeScope.Swap(scope); previous != nil {
+		previous.Close()
+	}
+	return scope
+}
+
+// EndScope closes the active scope, if any.
+func EndScope() {
+	if scope := activeScope.Load(); scope != nil {
+		scope.Close()
+	}
+}
+
+// Close releases every element the scope still owns, once the traversals holding it have
+// finished. Elements of a closed scope must no longer be used.
+func (s *Scope) Close() {
+	s.mu.Lock()
+	if s.closed || s.closing {
+		s.mu.Unlock()
+		return
+	}
+	s.closing = true
+	if s.holds > 0 {
+		s.mu.Unlock()
+		return
+	}
+	s.releaseLocked()
+}
+
+// releaseLocked releases the owned elements and unlocks the scope. No traversal holds the
+// scope anymore, so no worker still reads the references it clears.
+func (s *Scope) releaseLocked() {
+	refs := make([]unsafe.Pointer, 0, len(s.elements))
+	for _, element := range s.elements {
+		// Elements kept or handed to another scope since are no longer ours to release
+		if !element.owner.CompareAndSwap(s, nil) {
+			continue
+		}
+		if element.ref == nil {
+			continue
+		}
+		refs = append(refs, element.ref)
+		element.ref = nil
+	}
+	s.elements = nil
+	s.closed = true
+	s.mu.Unlock()
+
+	releaseRefs(refs)
+
+	logger.Debug("Element scope closed",
+		zap.Int("released", len(refs)),
+		zap.Int64("live_refs", LiveElementRefs()))
+}
+
+// Keep opts the element out of the scope that owns it, so it stays valid until the caller
+// releases it. It returns the element for convenience.
+func (e *Element) Keep() *Element {
+	KeepElements([]*Element{e})
+	return e
+}
+
+// KeepElements opts several elements out of their scopes.
+func KeepElements(elements []*Element) {
+	var locked *Scope
+	for _, element := range elements {
+		if element == nil {
+			continue
+		}
+		// The owner only changes under its own lock, so retry if it changed before we locked it
+		for owner := element.owner.Load(); owner != nil; owner = element.owner.Load() {
+			if owner != locked {
+				if locked != nil {
+					locked.mu.Unlock()
+				}
+				locked = owner
+				locked.mu.Lock()
+			}
+			if element.owner.CompareAndSwap(owner, nil) {
+				break
+			}
+		}
+	}
+	if locked != nil {
+		locked.mu.Unlock()
+	}
+}
+
+// ReleaseElements releases several elements with a single bridge call.
+func ReleaseElements(elements []*Element) {
+	refs := make([]unsafe.Pointer, 0, len(elements))
+	for _, element := range elements {
+		if element == nil || element.ref == nil {
+			continue
+		}
+		refs = append(refs, element.ref)
+		element.ref = nil
+	}
+	releaseRefs(refs)
+}
+
+// hold keeps the scope from releasing its elements until the returned function is called.
+// Every traversal holds the scope owning its elements while its workers run, so one that
+// outlives the activation, such as a streaming scan, never reads a released reference. A nil
+// or closed scope has nothing to hold.
+func (s *Scope) hold() func() {
+	if s == nil {
+		return func() {}
+	}
+
+	s.mu.Lock()
+	if s.closed {
+		s.mu.Unlock()
+		return func() {}
+	}
+	s.holds++
+	s.mu.Unlock()
+
+	return s.unhold
+}
+
+// unhold drops a hold taken by hold and finishes a close that waited for it.
+func (s *Scope) unhold() {
+	s.mu.Lock()
+	s.holds--
+	if s.holds == 0 && s.closing {
+		s.releaseLocked()
+		return
+	}
+	s.mu.Unlock()
+}
+
+// beginBackgroundScope returns a new scope for a walk no activation asked for, unless an
+// activation's scope is still open. The scope never becomes the active one: the walk passes
+// it explicitly, so an activation starting meanwhile keeps its own. It is returned held; the
+// walk releases the hold before closing it.
+func beginBackgroundScope() (*Scope, func()) {
+	if current := activeScope.Load(); current != nil {
+		current.mu.Lock()
+		open := !current.closed && !current.closing
+		current.mu.Unlock()
+		if open {
+			return nil, nil
+		}
+	}
+
+	scope := &Scope{elements: make([]*Element, 0, 1024), holds: 1}
+	return scope, scope.unhold
+}
+
+// own hands elements, fresh or owned by another scope, to s. It reports false, leaving the
+// elements to the caller, when s is nil or closed.
+func (s *Scope) own(elements []*Element) bool {
+	if s == nil {
+		return false
+	}
+	KeepElements(elements)
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	if s.closed {
+		return false
+	}
+	for _, element := range elements {
+		element.owner.Store(s)
+	}
+	s.elements = append(s.elements, elements...)
+	return true
+}
+
+// retire releases kept elements that an activation may still be using: they are handed to
+// the active scope if it is open, and released right away otherwise.
+func retire(elements []*Element) {
+	if !activeScope.Load().own(elements) {
+		ReleaseElements(elements)
+	}
+}
+
+// releaseRefs releases raw references with one provider call.
+func releaseRefs(refs []unsafe.Pointer) {
+	if len(refs) == 0 {
+		return
+	}
+	currentProvider().Release(refs)
+	trackRefs(-len(refs))
+}
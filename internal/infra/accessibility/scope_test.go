@@ -0,0 +1,110 @@
+package accessibility
+
+import (
+	"context"
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestWalkElementsBelongToTheWalkScope(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	walkScope := &Scope{}
+	activation := BeginScope()
+	t.Cleanup(EndScope)
+
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 4, scope: walkScope}
+	root, err := BuildTree(provider.FrontmostWindow(), opts)
+	if err != nil {
+		t.Fatalf("BuildTree() error = %v", err)
+	}
+
+	elements := collectSubtree(root)[1:]
+	for _, element := range elements {
+		if owner := element.owner.Load(); owner != walkScope {
+			t.Fatalf("element owned by %p, want the walk's scope %p", owner, walkScope)
+		}
+	}
+
+	// Closing the activation leaves the walk's elements alone
+	activation.Close()
+	for _, element := range elements {
+		if element.ref == nil {
+			t.Fatal("closing another scope released an element of the walk")
+		}
+	}
+
+	walkScope.Close()
+	for _, element := range elements {
+		if element.ref != nil || element.owner.Load() != nil {
+			t.Fatal("closing the walk's scope left an element owned")
+		}
+	}
+}
+
+func TestKeepElementsWhileScopeCloses(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	scope := &Scope{}
+
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 2, scope: scope}
+	root, err := BuildTree(provider.FrontmostWindow(), opts)
+	if err != nil {
+		t.Fatalf("BuildTree() error = %v", err)
+	}
+	elements := collectSubtree(root)[1:]
+	kept := elements[:len(elements)/2]
+
+	var waitGroup sync.WaitGroup
+	waitGroup.Add(2)
+	go func() {
+		defer waitGroup.Done()
+		KeepElements(kept)
+	}()
+	go func() {
+		defer waitGroup.Done()
+		scope.Close()
+	}()
+	waitGroup.Wait()
+
+	// Every element was either kept, and stays valid, or released by the scope
+	for _, element := range elements {
+		if element.owner.Load() != nil {
+			t.Fatal("element still owned by a closed scope")
+		}
+	}
+	for _, element := range elements[len(kept):] {
+		if element.ref != nil {
+			t.Fatal("closed scope did not release an element it owned")
+		}
+	}
+}
+
+func TestPrefetchLeavesTheActiveScope(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	SetPrefetchMaxAge(time.Minute)
+	t.Cleanup(func() { SetPrefetchMaxAge(0) })
+
+	// Between activations the last scope stays active, closed
+	BeginScope().Close()
+	idle := activeScope.Load()
+
+	err := PrefetchClickableElements(context.Background())
+	if err != nil {
+		t.Fatalf("PrefetchClickableElements() error = %v", err)
+	}
+	if activeScope.Load() != idle {
+		t.Fatal("the background walk replaced the active scope")
+	}
+
+	activation := BeginScope()
+	t.Cleanup(EndScope)
+	nodes, ok := takePrefetched(provider.FrontmostWindow(), false)
+	if !ok || len(nodes) == 0 {
+		t.Fatalf("takePrefetched() = %d nodes, %v; want the prefetched elements", len(nodes), ok)
+	}
+	for _, node := range nodes {
+		if node.Element.ref == nil || node.Element.owner.Load() != activation {
+			t.Fatal("prefetched element not handed to the activation's scope")
+		}
+	}
+}
@@ -0,0 +1,193 @@
+package accessibility
+
+import (
+	"os"
+	"path/filepath"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/pruning"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// learnedPruning is the store of learned subtree skips together with the file it persists to.
+type learnedPruning struct {
+	store *pruning.Store
+	path  string
+}
+
+var (
+	// activePruning is nil while learned subtree pruning is disabled.
+	activePruning atomic.Pointer[learnedPruning]
+
+	// fullWalkRequested makes the next frontmost-window scan walk everything.
+	fullWalkRequested atomic.Bool
+)
+
+// SetSubtreePruning enables or disables learned subtree pruning. Enabling loads what was
+// learned before the last restart; disabling saves it first.
+func SetSubtreePruning(enabled bool) {
+	if !enabled {
+		previous := activePruning.Swap(nil)
+		if previous != nil {
+			savePruning(previous)
+			logger.Debug("Subtree pruning disabled")
+		}
+		return
+	}
+
+	if activePruning.Load() != nil {
+		return
+	}
+
+	learned := &learnedPruning{
+		store: pruning.NewStore(pruning.DefaultMinObservations, pruning.DefaultMaxAge),
+		path:  pruningFilePath(),
+	}
+	if learned.path != "" {
+		err := learned.store.Load(learned.path, time.Now())
+		if err != nil {
+			logger.Warn("Failed to load learned subtree pruning", zap.Error(err))
+		}
+	}
+	if activePruning.CompareAndSwap(nil, learned) {
+		logger.Debug("Subtree pruning enabled", zap.String("path", learned.path))
+	}
+}
+
+// SaveSubtreePruning persists what was learned so far. It does nothing while pruning is
+// disabled or nothing changed.
+func SaveSubtreePruning() {
+	if learned := activePruning.Load(); learned != nil {
+		savePruning(learned)
+	}
+}
+
+// RequestFullWalk makes the next scan of the frontmost window walk every subtree, ignoring
+// learned skips and any tracked tree, and drops the cached sources. The walk still feeds what
+// it finds back into learning.
+func RequestFullWalk() {
+	fullWalkRequested.Store(true)
+	InvalidateSourceCache("")
+}
+
+// contentHostRoles show content that changes without their subtree moving, like a web page
+// navigating, so a signature inside or around one does not tell its contents. Walks learn
+// nothing about the subtrees holding such content.
+var contentHostRoles = NewRoleSet("AXWebArea")
+
+// subtreeSkips applies and learns one application's skips during a single walk.
+// Methods are safe on a nil receiver, which skips and learns nothing.
+type subtreeSkips struct {
+	store    *pruning.Store
+	bundleID string
+	skip     map[pruning.Signature]struct{}
+	skipped  atomic.Int64
+
+	mu           sync.Mutex
+	observations []pruning.Observation
+}
+
+// newSubtreeSkips prepares the skips for a walk of the given window. It returns nil when
+// pruning is disabled or the window's application is unknown; full walks ignore the skips
+// but still learn.
+func newSubtreeSkips(window *Element, full bool) *subtreeSkips {
+	learned := activePruning.Load()
+	if learned == nil {
+		return nil
+	}
+
+	bundleID := window.GetBundleIdentifier()
+	if bundleID == "" {
+		return nil
+	}
+
+	skips := &subtreeSkips{
+		store:    learned.store,
+		bundleID: bundleID,
+	}
+	if !full {
+		skips.skip = learned.store.Skips(bundleID, time.Now())
+	}
+	return skips
+}
+
+// has reports whether the subtree should be skipped.
+func (s *subtreeSkips) has(signature pruning.Signature) bool {
+	if s == nil || len(s.skip) == 0 {
+		return false
+	}
+	_, ok := s.skip[signature]
+	if ok {
+		s.skipped.Add(1)
+	}
+	return ok
+}
+
+// observe records the number of nodes and clickable elements found in a subtree. Walks do not
+// report subtrees holding content, so no subtree in or around a content host is learned.
+func (s *subtreeSkips) observe(signature pruning.Signature, nodes, clickables int) {
+	// Leaves carry nothing to learn; small barren subtrees are not worth an entry
+	if s == nil || nodes <= 1 || (clickables == 0 && nodes < pruning.MinSubtreeNodes) {
+		return
+	}
+
+	s.mu.Lock()
+	s.observations = append(s.observations, pruning.Observation{
+		Signature:  signature,
+		Nodes:      nodes,
+		Clickables: clickables,
+	})
+	s.mu.Unlock()
+}
+
+// commit hands the observations of a complete walk to the store.
+func (s *subtreeSkips) commit() {
+	if s == nil {
+		return
+	}
+
+	s.mu.Lock()
+	observations := s.observations
+	s.observations = nil
+	s.mu.Unlock()
+
+	s.store.Observe(s.bundleID, observations, time.Now())
+	logger.Debug("Learned subtree pruning",
+		zap.String("bundle_id", s.bundleID),
+		zap.Int("skip_entries", len(s.skip)),
+		zap.Int64("skipped", s.skipped.Load()),
+		zap.Int("observations", len(observations)))
+}
+
+// commitSkips hands the observations of a walk to the store. Truncated walks may have
+// missed clickable elements, so they teach nothing.
+func (o TreeOptions) commitSkips() {
+	if o.walk.truncated() {
+		return
+	}
+	o.skips.commit()
+}
+
+// savePruning writes the learned skips to their file.
+func savePruning(learned *learnedPruning) {
+	if learned.path == "" {
+		return
+	}
+	err := learned.store.Save(learned.path, time.Now())
+	if err != nil {
+		logger.Warn("Failed to save learned subtree pruning", zap.Error(err))
+	}
+}
+
+// pruningFilePath returns the file learned skips persist to, or "" if there is no cache directory.
+func pruningFilePath() string {
+	dir, err := os.UserCacheDir()
+	if err != nil {
+		logger.Warn("No cache directory for learned subtree pruning", zap.Error(err))
+		return ""
+	}
+	return filepath.Join(dir, "neru", "subtree-pruning.json")
+}
@@ -0,0 +1,76 @@
+package accessibility
+
+import "testing"
+
+// contentTreeSpec holds a web area showing nothing clickable next to a toolbar with a button.
+var contentTreeSpec = SyntheticSpec{
+	PID:      42,
+	BundleID: "com.example.synthetic",
+	Tree: []*SyntheticNode{
+		{
+			Role:  "AXToolbar",
+			Frame: SyntheticFrame{Width: 1440, Height: 40},
+			Children: []*SyntheticNode{{
+				Role:  "AXGroup",
+				Frame: SyntheticFrame{Width: 200, Height: 40},
+				Children: []*SyntheticNode{{
+					Role:      "AXButton",
+					Frame:     SyntheticFrame{Width: 40, Height: 40},
+					Clickable: true,
+				}},
+			}},
+		},
+		{
+			Role:  "AXGroup",
+			Frame: SyntheticFrame{Y: 40, Width: 1440, Height: 860},
+			Children: []*SyntheticNode{{
+				Role:  "AXWebArea",
+				Frame: SyntheticFrame{Y: 40, Width: 1440, Height: 860},
+				Children: []*SyntheticNode{{
+					Role:  "AXGroup",
+					Frame: SyntheticFrame{Y: 40, Width: 1440, Height: 100},
+					Children: []*SyntheticNode{
+						{Role: "AXStaticText", Frame: SyntheticFrame{Y: 40, Width: 100, Height: 20}},
+						{Role: "AXStaticText", Frame: SyntheticFrame{Y: 60, Width: 100, Height: 20}},
+					},
+				}},
+			}},
+		},
+	},
+}
+
+// TestLearningLeavesContentOut checks that neither walker reports a subtree holding a content
+// host, whatever it shows, while the subtrees beside it are still learned.
+func TestLearningLeavesContentOut(t *testing.T) {
+	provider := useSyntheticTree(t, contentTreeSpec)
+	window := provider.FrontmostWindow()
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 2}
+
+	root, err := BuildTree(window, opts)
+	if err != nil {
+		t.Fatalf("BuildTree() error = %v", err)
+	}
+	flat, err := BuildFlatTree(window, opts, NewTreeArena())
+	if err != nil {
+		t.Fatalf("BuildFlatTree() error = %v", err)
+	}
+
+	linked := &subtreeSkips{}
+	root.findClickable(linked)
+	arena := &subtreeSkips{}
+	flat.findClickable(arena)
+
+	// Only the toolbar and its group hold more than one node outside the web area
+	for name, skips := range map[string]*subtreeSkips{"linked": linked, "flat": arena} {
+		if len(skips.observations) != 2 {
+			t.Errorf("%s walk observed %d subtrees, want the toolbar and its group",
+				name, len(skips.observations))
+		}
+		for _, observation := range skips.observations {
+			if observation.Clickables != 1 {
+				t.Errorf("%s walk observed %d clickables in a subtree, want 1",
+					name, observation.Clickables)
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+package accessibility
+
+import (
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/snapshot"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// maxSnapshotNodes bounds recorded trees; larger trees are cut off breadth first.
+const maxSnapshotNodes = 1 << 20
+
+// CaptureSnapshot records the complete tree of the frontmost window together with the
+// on-screen windows and the active screen. Unlike a scan, nothing is pruned or filtered,
+// so replaying the snapshot runs the same filters on the same input. Every node costs a
+// request for its title and click action besides its children, so capturing is much slower
+// than scanning.
+func CaptureSnapshot() (*snapshot.Snapshot, error) {
+	provider := currentProvider()
+	window := provider.FrontmostWindow()
+	if window == nil {
+		return nil, errNoFrontmostWindow
+	}
+
+	// Every element is released here, whatever scope is active
+	elements := []*Element{window}
+	KeepElements(elements)
+	defer func() { ReleaseElements(elements) }()
+
+	info, err := provider.Info(window)
+	if err != nil {
+		return nil, err
+	}
+
+	start := time.Now()
+	snap := &snapshot.Snapshot{
+		PID:      info.PID,
+		BundleID: provider.BundleIdentifier(window),
+		Screen:   provider.ActiveScreenBounds(),
+		Windows:  provider.Windows(),
+		Nodes:    []snapshot.Node{snapshotNode(provider, window, info)},
+	}
+	roles := []RoleID{info.RoleID}
+
+	truncated := false
+	for index := 0; index < len(elements); index++ {
+		children, infos, _ := provider.ChildrenWithInfo(elements[index], roles[index])
+		KeepElements(children)
+		children, infos = dropUnresolved(children, infos)
+		if room := maxSnapshotNodes - len(elements); len(children) > room {
+			ReleaseElements(children[room:])
+			children = children[:room]
+			truncated = true
+		}
+		if len(children) > 0 {
+			snap.Nodes[index].First = int32(len(elements))
+			snap.Nodes[index].Count = int32(len(children))
+		}
+		for childIndex, child := range children {
+			elements = append(elements, child)
+			roles = append(roles, infos[childIndex].RoleID)
+			snap.Nodes = append(snap.Nodes, snapshotNode(provider, child, infos[childIndex]))
+		}
+		if truncated {
+			break
+		}
+	}
+
+	logger.Debug("Captured accessibility snapshot",
+		zap.String("bundle_id", snap.BundleID),
+		zap.Int("nodes", len(snap.Nodes)),
+		zap.Bool("truncated", truncated),
+		zap.Duration("duration", time.Since(start)))
+
+	return snap, nil
+}
+
+// dropUnresolved releases the children whose info could not be fetched and returns the rest.
+func dropUnresolved(children []*Element, infos []*ElementInfo) ([]*Element, []*ElementInfo) {
+	kept := 0
+	var dropped []*Element
+	for index, child := range children {
+		if infos[index] == nil {
+			dropped = append(dropped, child)
+			continue
+		}
+		children[kept] = child
+		infos[kept] = infos[index]
+		kept++
+	}
+	ReleaseElements(dropped)
+	return children[:kept], infos[:kept]
+}
+
+// snapshotNode records one element; its children are linked in by the caller.
+func snapshotNode(provider Provider, element *Element, info *ElementInfo) snapshot.Node {
+	return snapshot.Node{
+		Role:   info.Role,
+		Title:  provider.Title(element),
+		Frame:  rectFromInfo(info),
+		Action: uint8(provider.ClickAction(element)),
+	}
+}
@@ -0,0 +1,20 @@
+// Package snapshot stores recorded accessibility trees in a compact binary file, so a slow or
+// misbehaving application can be reproduced offline and real-world trees can be kept as a
+// benchmark corpus.
+//
+// A snapshot holds the frontmost window's complete tree in breadth-first order, the children
+// of every node in one consecutive block, together with the on-screen windows and the active
+// screen at the time of recording. Each node is a fixed-size record of its frame, its first
+// child and child count, its role and its click action; roles and titles are indices into
+// one deduplicated string table.
+//
+// Key Features:
+//   - Compact Format: Fixed-size little-endian records, no per-node allocations when read
+//   - Memory Mapped: Files are mapped rather than read, so large trees load instantly and
+//     several processes share the pages
+//   - Validated: Every index is checked when a file is opened, so a damaged or hostile file
+//     fails to open instead of failing during a walk
+//
+// The package has no platform dependencies; the accessibility package records snapshots
+// through its provider and replays them with a provider backed by a File.
+package snapshot
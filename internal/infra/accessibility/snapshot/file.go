@@ -0,0 +1,210 @@
+package snapshot
+
+import (
+	"encoding/binary"
+	"fmt"
+	"image"
+	"os"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+)
+
+// File is an opened snapshot. Its accessors read the mapped file directly and are safe for
+// concurrent use until Close.
+type File struct {
+	unmap func() error
+
+	pid       int
+	bundleID  string
+	screen    image.Rectangle
+	windows   []occlusion.Window
+	nodeCount int
+	roleCount int
+	nodes     []byte
+	offsets   []byte
+	strings   []byte
+}
+
+// Open maps the snapshot at path and validates it.
+func Open(path string) (*File, error) {
+	data, unmap, err := mapFile(path)
+	if err != nil {
+		return nil, fmt.Errorf("failed to open snapshot: %w", err)
+	}
+
+	file, err := parse(data)
+	if err != nil {
+		_ = unmap()
+		return nil, fmt.Errorf("failed to open snapshot %s: %w", path, err)
+	}
+	file.unmap = unmap
+	return file, nil
+}
+
+// Close unmaps the file. Nothing read from it may be used afterwards, including node
+// references.
+func (f *File) Close() error {
+	if f.unmap == nil {
+		return nil
+	}
+	unmap := f.unmap
+	f.unmap = nil
+	f.nodes, f.offsets, f.strings = nil, nil, nil
+	return unmap()
+}
+
+// PID returns the process ID of the recorded application.
+func (f *File) PID() int { return f.pid }
+
+// BundleID returns the bundle identifier of the recorded application.
+func (f *File) BundleID() string { return f.bundleID }
+
+// Screen returns the active screen at the time of recording.
+func (f *File) Screen() image.Rectangle { return f.screen }
+
+// Windows returns the on-screen windows at the time of recording, front to back.
+func (f *File) Windows() []occlusion.Window { return f.windows }
+
+// Len returns the number of nodes.
+func (f *File) Len() int { return f.nodeCount }
+
+// RoleCount returns the number of distinct roles; RoleName resolves them.
+func (f *File) RoleCount() int { return f.roleCount }
+
+// RoleName returns the name of a role index below RoleCount.
+func (f *File) RoleName(role int) string { return f.stringAt(uint32(role)) }
+
+// Frame returns the frame of a node.
+func (f *File) Frame(index int) image.Rectangle {
+	return getRect(f.node(index))
+}
+
+// Children returns the first child and the child count of a node.
+func (f *File) Children(index int) (int32, int32) {
+	node := f.node(index)
+	first := int32(binary.LittleEndian.Uint32(node[16:]))
+	count := int32(binary.LittleEndian.Uint32(node[20:]))
+	return first, count
+}
+
+// Role returns the role index of a node.
+func (f *File) Role(index int) int {
+	return int(binary.LittleEndian.Uint16(f.node(index)[24:]))
+}
+
+// Action returns the recorded click action of a node.
+func (f *File) Action(index int) uint8 {
+	return f.node(index)[26]
+}
+
+// Title returns the title of a node.
+func (f *File) Title(index int) string {
+	return f.stringAt(binary.LittleEndian.Uint32(f.node(index)[28:]))
+}
+
+// Ref returns a stable pointer identifying a node, for use as an element reference. It
+// points into the mapping and is valid until Close.
+func (f *File) Ref(index int) unsafe.Pointer {
+	return unsafe.Pointer(&f.nodes[index*nodeSize])
+}
+
+// Index returns the node identified by a pointer returned by Ref.
+func (f *File) Index(ref unsafe.Pointer) int {
+	return int((uintptr(ref) - uintptr(unsafe.Pointer(&f.nodes[0]))) / nodeSize)
+}
+
+func (f *File) node(index int) []byte {
+	return f.nodes[index*nodeSize : (index+1)*nodeSize]
+}
+
+func (f *File) stringAt(index uint32) string {
+	start := binary.LittleEndian.Uint32(f.offsets[index*offsetSize:])
+	end := binary.LittleEndian.Uint32(f.offsets[(index+1)*offsetSize:])
+	return string(f.strings[start:end])
+}
+
+// parse checks the header and every index in data, so the accessors need no bounds checks
+// of their own beyond Go's.
+func parse(data []byte) (*File, error) {
+	if len(data) < headerSize || [8]byte(data[:8]) != magic {
+		return nil, errBadMagic
+	}
+	version := binary.LittleEndian.Uint32(data[8:])
+	if version != Version {
+		return nil, fmt.Errorf("%w: %d", errBadVersion, version)
+	}
+
+	windowCount := uint64(binary.LittleEndian.Uint32(data[36:]))
+	nodeCount := uint64(binary.LittleEndian.Uint32(data[40:]))
+	roleCount := uint64(binary.LittleEndian.Uint32(data[44:]))
+	stringCount := uint64(binary.LittleEndian.Uint32(data[48:]))
+	stringBytes := uint64(binary.LittleEndian.Uint32(data[52:]))
+
+	windowsEnd := headerSize + windowCount*windowSize
+	nodesEnd := windowsEnd + nodeCount*nodeSize
+	offsetsEnd := nodesEnd + (stringCount+1)*offsetSize
+	if nodeCount == 0 || stringCount == 0 || roleCount == 0 || roleCount > stringCount ||
+		roleCount > maxRoles || offsetsEnd+stringBytes != uint64(len(data)) {
+		return nil, fmt.Errorf("%w: bad section sizes", errCorrupt)
+	}
+
+	file := &File{
+		pid:       int(int32(binary.LittleEndian.Uint32(data[12:]))),
+		screen:    getRect(data[20:]),
+		windows:   make([]occlusion.Window, windowCount),
+		nodeCount: int(nodeCount),
+		roleCount: int(roleCount),
+		nodes:     data[windowsEnd:nodesEnd],
+		offsets:   data[nodesEnd:offsetsEnd],
+		strings:   data[offsetsEnd:],
+	}
+
+	for index := range file.windows {
+		record := data[headerSize+index*windowSize:]
+		file.windows[index] = occlusion.Window{
+			PID:    int(int32(binary.LittleEndian.Uint32(record))),
+			Bounds: getRect(record[4:]),
+		}
+	}
+
+	previous := uint32(0)
+	for index := range int(stringCount) + 1 {
+		offset := binary.LittleEndian.Uint32(file.offsets[index*offsetSize:])
+		if offset < previous || uint64(offset) > stringBytes {
+			return nil, fmt.Errorf("%w: bad string offset %d", errCorrupt, index)
+		}
+		previous = offset
+	}
+
+	bundleID := binary.LittleEndian.Uint32(data[16:])
+	if uint64(bundleID) >= stringCount {
+		return nil, fmt.Errorf("%w: bad bundle identifier", errCorrupt)
+	}
+	file.bundleID = file.stringAt(bundleID)
+
+	// Children must follow their parent and stay in bounds, so every walk terminates
+	for index := range file.nodeCount {
+		first, count := file.Children(index)
+		if count < 0 ||
+			(count > 0 && (int(first) <= index || uint64(first)+uint64(count) > nodeCount)) {
+			return nil, fmt.Errorf("%w: bad children of node %d", errCorrupt, index)
+		}
+		node := file.node(index)
+		if uint64(binary.LittleEndian.Uint16(node[24:])) >= roleCount ||
+			uint64(binary.LittleEndian.Uint32(node[28:])) >= stringCount {
+			return nil, fmt.Errorf("%w: bad strings of node %d", errCorrupt, index)
+		}
+	}
+
+	return file, nil
+}
+
+// readFile is the fallback for platforms without memory mapping.
+func readFile(path string) ([]byte, func() error, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, nil, err
+	}
+	return data, func() error { return nil }, nil
+}
@@ -0,0 +1,8 @@
+//go:build !unix
+
+package snapshot
+
+// mapFile reads the file at path; this platform has no memory mapping.
+func mapFile(path string) ([]byte, func() error, error) {
+	return readFile(path)
+}
@@ -0,0 +1,224 @@
+package snapshot
+
+import (
+	"bufio"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"image"
+	"io"
+	"math"
+	"os"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+)
+
+// Version is the format version written by this package.
+const Version = 1
+
+// File layout. All integers are little-endian. The header is followed by the windows, the
+// nodes, the string offsets and the string bytes, without padding.
+const (
+	headerSize = 64
+	windowSize = 20
+	nodeSize   = 32
+	offsetSize = 4
+
+	// maxRoles bounds the distinct roles; node records store the role in 16 bits.
+	maxRoles = math.MaxUint16 + 1
+)
+
+// magic starts every snapshot file.
+var magic = [8]byte{'N', 'E', 'R', 'U', 'S', 'N', 'A', 'P'}
+
+var (
+	errNoNodes    = errors.New("snapshot has no nodes")
+	errTooMany    = errors.New("snapshot too large")
+	errBadMagic   = errors.New("not a snapshot file")
+	errBadVersion = errors.New("unsupported snapshot version")
+	errCorrupt    = errors.New("corrupt snapshot")
+)
+
+// Snapshot is a recorded accessibility tree. Nodes are in breadth-first order with node 0
+// the window; the children of a node are the Count nodes starting at First.
+type Snapshot struct {
+	PID      int
+	BundleID string
+	Screen   image.Rectangle
+	// Windows are the on-screen windows, front to back.
+	Windows []occlusion.Window
+	Nodes   []Node
+}
+
+// Node is one element of a snapshot.
+type Node struct {
+	Role  string
+	Title string
+	Frame image.Rectangle
+	// Action is the element's click action as classified by the accessibility package.
+	Action uint8
+	First  int32
+	Count  int32
+}
+
+// WriteTo encodes the snapshot. Strings are deduplicated; roles come first in the string
+// table, so they can be resolved once when the file is opened.
+func (s *Snapshot) WriteTo(w io.Writer) (int64, error) {
+	if len(s.Nodes) == 0 {
+		return 0, errNoNodes
+	}
+	if len(s.Nodes) > math.MaxInt32 || len(s.Windows) > math.MaxInt32 {
+		return 0, errTooMany
+	}
+
+	table := newStringTable()
+	for _, node := range s.Nodes {
+		table.add(node.Role)
+	}
+	roleCount := len(table.strings)
+	if roleCount > maxRoles {
+		return 0, fmt.Errorf("%w: %d roles", errTooMany, roleCount)
+	}
+	bundleID := table.add(s.BundleID)
+	titles := make([]uint32, len(s.Nodes))
+	for index, node := range s.Nodes {
+		titles[index] = table.add(node.Title)
+	}
+	if table.size > math.MaxUint32 {
+		return 0, fmt.Errorf("%w: %d bytes of strings", errTooMany, table.size)
+	}
+
+	counter := &countingWriter{writer: w}
+	buffered := bufio.NewWriter(counter)
+	record := make([]byte, headerSize)
+
+	copy(record, magic[:])
+	binary.LittleEndian.PutUint32(record[8:], Version)
+	binary.LittleEndian.PutUint32(record[12:], uint32(int32(s.PID)))
+	binary.LittleEndian.PutUint32(record[16:], bundleID)
+	putRect(record[20:], s.Screen)
+	binary.LittleEndian.PutUint32(record[36:], uint32(len(s.Windows)))
+	binary.LittleEndian.PutUint32(record[40:], uint32(len(s.Nodes)))
+	binary.LittleEndian.PutUint32(record[44:], uint32(roleCount))
+	binary.LittleEndian.PutUint32(record[48:], uint32(len(table.strings)))
+	binary.LittleEndian.PutUint32(record[52:], uint32(table.size))
+	_, _ = buffered.Write(record)
+
+	record = record[:windowSize]
+	for _, window := range s.Windows {
+		binary.LittleEndian.PutUint32(record, uint32(int32(window.PID)))
+		putRect(record[4:], window.Bounds)
+		_, _ = buffered.Write(record)
+	}
+
+	record = record[:nodeSize]
+	for index, node := range s.Nodes {
+		putRect(record, node.Frame)
+		binary.LittleEndian.PutUint32(record[16:], uint32(node.First))
+		binary.LittleEndian.PutUint32(record[20:], uint32(node.Count))
+		binary.LittleEndian.PutUint16(record[24:], uint16(table.index[node.Role]))
+		record[26] = node.Action
+		record[27] = 0
+		binary.LittleEndian.PutUint32(record[28:], titles[index])
+		_, _ = buffered.Write(record)
+	}
+
+	record = record[:offsetSize]
+	offset := uint32(0)
+	for _, value := range table.strings {
+		binary.LittleEndian.PutUint32(record, offset)
+		_, _ = buffered.Write(record)
+		offset += uint32(len(value))
+	}
+	binary.LittleEndian.PutUint32(record, offset)
+	_, _ = buffered.Write(record)
+
+	for _, value := range table.strings {
+		_, _ = buffered.WriteString(value)
+	}
+
+	// bufio keeps the first write error and reports it on Flush
+	err := buffered.Flush()
+	if err != nil {
+		return counter.written, fmt.Errorf("failed to write snapshot: %w", err)
+	}
+	return counter.written, nil
+}
+
+// Save writes the snapshot to path, replacing any existing file.
+func (s *Snapshot) Save(path string) error {
+	file, err := os.Create(path)
+	if err != nil {
+		return fmt.Errorf("failed to create snapshot file: %w", err)
+	}
+
+	_, err = s.WriteTo(file)
+	closeErr := file.Close()
+	if err != nil {
+		return err
+	}
+	if closeErr != nil {
+		return fmt.Errorf("failed to close snapshot file: %w", closeErr)
+	}
+	return nil
+}
+
+// stringTable deduplicates strings in insertion order. The empty string is always entry 0.
+type stringTable struct {
+	strings []string
+	index   map[string]uint32
+	size    int
+}
+
+func newStringTable() *stringTable {
+	return &stringTable{
+		strings: []string{""},
+		index:   map[string]uint32{"": 0},
+	}
+}
+
+// add returns the index of value, appending it if it is new.
+func (t *stringTable) add(value string) uint32 {
+	if index, ok := t.index[value]; ok {
+		return index
+	}
+	index := uint32(len(t.strings))
+	t.strings = append(t.strings, value)
+	t.index[value] = index
+	t.size += len(value)
+	return index
+}
+
+// countingWriter counts the bytes written through it.
+type countingWriter struct {
+	writer  io.Writer
+	written int64
+}
+
+func (w *countingWriter) Write(data []byte) (int, error) {
+	n, err := w.writer.Write(data)
+	w.written += int64(n)
+	return n, err
+}
+
+// putRect encodes a rectangle as four int32 values.
+func putRect(data []byte, rect image.Rectangle) {
+	binary.LittleEndian.PutUint32(data, uint32(int32(rect.Min.X)))
+	binary.LittleEndian.PutUint32(data[4:], uint32(int32(rect.Min.Y)))
+	binary.LittleEndian.PutUint32(data[8:], uint32(int32(rect.Max.X)))
+	binary.LittleEndian.PutUint32(data[12:], uint32(int32(rect.Max.Y)))
+}
+
+// getRect decodes a rectangle written by putRect.
+func getRect(data []byte) image.Rectangle {
+	return image.Rectangle{
+		Min: image.Point{
+			X: int(int32(binary.LittleEndian.Uint32(data))),
+			Y: int(int32(binary.LittleEndian.Uint32(data[4:]))),
+		},
+		Max: image.Point{
+			X: int(int32(binary.LittleEndian.Uint32(data[8:]))),
+			Y: int(int32(binary.LittleEndian.Uint32(data[12:]))),
+		},
+	}
+}
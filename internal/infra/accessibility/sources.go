@@ -0,0 +1,259 @@
+package accessibility
+
+import (
+	"slices"
+	"sync"
+	"sync/atomic"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/incremental"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// sourceKey identifies a cached source: the menubar of an application, or an application as
+// a whole, such as the Dock or Notification Center.
+type sourceKey struct {
+	pid     int
+	menubar bool
+}
+
+// sourceEntry is the clickable elements of one source. Its elements belong to no scope.
+type sourceEntry struct {
+	bundleID string
+	nodes    []*TreeNode
+	roles    []string
+	// keys are the elements whose notifications make the entry stale; nil means any
+	// notification of the process does.
+	keys  map[incremental.Key]struct{}
+	stale bool
+}
+
+// sourceCache keeps the clickable elements of the menubar, the Dock and Notification Center
+// between activations. These change rarely, so a walk is only repeated once the process
+// reports a change, the clickable roles change, or an application launches or quits.
+type sourceCache struct {
+	// mu guards the maps. Notifications take it, so it is never held during bridge calls.
+	mu      sync.Mutex
+	entries map[sourceKey]*sourceEntry
+	// observers holds the function stopping each observed process's notifications.
+	observers map[int]func()
+}
+
+// activeSources is nil while the source cache is disabled.
+var activeSources atomic.Pointer[sourceCache]
+
+// SetSourceCache enables or disables the source cache. Disabling drops all cached sources
+// and their observers.
+func SetSourceCache(enabled bool) {
+	if enabled {
+		cache := &sourceCache{
+			entries:   make(map[sourceKey]*sourceEntry),
+			observers: make(map[int]func()),
+		}
+		if activeSources.CompareAndSwap(nil, cache) {
+			logger.Debug("Source cache enabled")
+		}
+		return
+	}
+
+	if cache := activeSources.Swap(nil); cache != nil {
+		cache.invalidate(func(*sourceEntry) bool { return true })
+		cache.sweep()
+		logger.Debug("Source cache disabled")
+	}
+}
+
+// InvalidateSourceCache drops the cached sources of the application and every
+// application-wide source: launching or quitting an application changes the Dock. An empty
+// bundleID drops every source, for example after the screens changed.
+func InvalidateSourceCache(bundleID string) {
+	cache := activeSources.Load()
+	if cache == nil {
+		return
+	}
+	cache.invalidate(func(entry *sourceEntry) bool {
+		return bundleID == "" || entry.keys == nil || entry.bundleID == bundleID
+	})
+}
+
+// cachedSource returns the cached elements of the source, if the cache is enabled and they
+// are still current.
+func cachedSource(key sourceKey) ([]*TreeNode, bool) {
+	cache := activeSources.Load()
+	if cache == nil {
+		return nil, false
+	}
+	cache.sweep()
+
+	roles := GetClickableRoles()
+	cache.mu.Lock()
+	defer cache.mu.Unlock()
+
+	entry := cache.entries[key]
+	if entry == nil || entry.stale || !slices.Equal(entry.roles, roles) {
+		return nil, false
+	}
+	return entry.nodes, true
+}
+
+// storeSource caches the elements found for the source. root is the element the walk
+// started at; for menubars, only notifications about root and the found elements make the
+// entry stale. Sources of processes that cannot be observed are not cached.
+func storeSource(key sourceKey, bundleID string, root *Element, nodes []*TreeNode) {
+	cache := activeSources.Load()
+	if cache == nil || !cache.ensureObserver(key.pid) {
+		return
+	}
+
+	entry := &sourceEntry{
+		bundleID: bundleID,
+		nodes:    nodes,
+		roles:    GetClickableRoles(),
+	}
+	if key.menubar {
+		entry.keys = make(map[incremental.Key]struct{}, len(nodes)+1)
+		entry.keys[root.identity()] = struct{}{}
+		for _, node := range nodes {
+			entry.keys[node.Element.identity()] = struct{}{}
+		}
+	}
+
+	// Cached elements outlive the activation; the cache releases them when they go stale
+	KeepElements(entry.elements())
+
+	cache.mu.Lock()
+	previous := cache.entries[key]
+	cache.entries[key] = entry
+	cache.mu.Unlock()
+
+	if previous != nil {
+		retire(previous.elements())
+	}
+}
+
+// ensureObserver starts observing the process if needed and reports whether its
+// notifications are delivered.
+func (c *sourceCache) ensureObserver(pid int) bool {
+	c.mu.Lock()
+	_, ok := c.observers[pid]
+	c.mu.Unlock()
+	if ok {
+		return true
+	}
+
+	stop := currentProvider().Observe(pid)
+	if stop == nil {
+		logger.Debug("Source observer unavailable, not caching", zap.Int("pid", pid))
+		return false
+	}
+
+	c.mu.Lock()
+	if _, ok := c.observers[pid]; ok {
+		c.mu.Unlock()
+		stop()
+		return true
+	}
+	c.observers[pid] = stop
+	c.mu.Unlock()
+	return true
+}
+
+// invalidate marks the entries matching drop as stale.
+func (c *sourceCache) invalidate(drop func(*sourceEntry) bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	for _, entry := range c.entries {
+		if drop(entry) {
+			entry.stale = true
+		}
+	}
+}
+
+// dispatch marks the entries affected by a notification as stale. It runs on the main run
+// loop and must stay cheap; the elements are released by the next sweep.
+func (c *sourceCache) dispatch(event incremental.Event) {
+	if event.Kind == incremental.EventValueChanged ||
+		event.Kind == incremental.EventFocusedWindowChanged {
+		return
+	}
+	pid := event.Element.PID
+	if pid == 0 {
+		pid = event.Parent.PID
+	}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	for key, entry := range c.entries {
+		if key.pid != pid || entry.stale {
+			continue
+		}
+		if entry.keys == nil {
+			entry.stale = true
+			continue
+		}
+		// A created element of unknown parent may belong to any source
+		if event.Kind == incremental.EventCreated && event.Parent.IsZero() {
+			entry.stale = true
+			continue
+		}
+		_, element := entry.keys[event.Element]
+		_, parent := entry.keys[event.Parent]
+		entry.stale = element || parent
+	}
+}
+
+// sweep drops stale entries and stops observing processes without entries.
+func (c *sourceCache) sweep() {
+	var stale []*sourceEntry
+	var stops []func()
+
+	c.mu.Lock()
+	for key, entry := range c.entries {
+		if entry.stale {
+			stale = append(stale, entry)
+			delete(c.entries, key)
+		}
+	}
+	if len(stale) > 0 {
+		for pid, stop := range c.observers {
+			if !c.observesLocked(pid) {
+				stops = append(stops, stop)
+				delete(c.observers, pid)
+			}
+		}
+	}
+	c.mu.Unlock()
+
+	for _, entry := range stale {
+		retire(entry.elements())
+	}
+	for _, stop := range stops {
+		stop()
+	}
+	if len(stale) > 0 {
+		logger.Debug("Dropped stale sources",
+			zap.Int("sources", len(stale)),
+			zap.Int("observers_stopped", len(stops)))
+	}
+}
+
+// observesLocked reports whether an entry of the process is cached. It runs with c.mu held.
+func (c *sourceCache) observesLocked(pid int) bool {
+	for key := range c.entries {
+		if key.pid == pid {
+			return true
+		}
+	}
+	return false
+}
+
+// elements returns the elements of the entry's nodes.
+func (e *sourceEntry) elements() []*Element {
+	elements := make([]*Element, len(e.nodes))
+	for index, node := range e.nodes {
+		elements[index] = node.Element
+	}
+	return elements
+}
@@ -0,0 +1,298 @@
+package accessibility
+
+import (
+	"context"
+	"errors"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/pruning"
+	"github.com/y3owk1n/neru/internal/infra/accessibility/traversal"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// offscreenPriority ranks every node outside the viewport behind all visible nodes.
+const offscreenPriority = 1 << 16
+
+// StreamClickableElements walks the frontmost window and sends its clickable nodes to out as
+// they are discovered. Nodes on the active screen are visited before
+// off-screen ones, and shallow nodes before deep ones, so the first results are the ones the
+// user is most likely to look at. It returns the number of nodes sent once the walk finishes
+// or ctx is done; out is not closed. The activation scope is held until the walk's workers
+// have stopped, even if ctx was cancelled earlier.
+func StreamClickableElements(ctx context.Context, out chan<- *TreeNode) (int, error) {
+	cancelPrefetch()
+	release := activeScope.Load().hold()
+	defer release()
+
+	cacheOnce.Do(func() {
+		globalCache = NewInfoCache(5 * time.Second)
+	})
+
+	window := GetFrontmostWindow()
+	if window == nil {
+		logger.Warn("No frontmost window found")
+		return 0, errNoFrontmostWindow
+	}
+	defer window.Release()
+
+	snapshotWindows()
+
+	full := fullWalkRequested.Swap(false)
+	opts := DefaultTreeOptions()
+	opts.Cache = globalCache
+	opts.skips = newSubtreeSkips(window, full)
+	tuneOptions(&opts, window.key.pid)
+
+	if tracker := activeTracker.Load(); tracker != nil {
+		if full {
+			tracker.invalidate(window)
+		}
+		return streamTracked(ctx, tracker, window, opts, out)
+	}
+
+	if elements, ok := takePrefetched(window, full); ok {
+		return sendNodes(ctx, out, elements)
+	}
+	return streamClickable(ctx, window, opts, out)
+}
+
+// streamClickable walks the tree below root in priority order and sends clickable nodes.
+func streamClickable(
+	ctx context.Context,
+	root *Element,
+	opts TreeOptions,
+	out chan<- *TreeNode,
+) (int, error) {
+	release := opts.scope.hold()
+	defer release()
+
+	info, err := rootInfo(root, opts.Cache)
+	if err != nil {
+		return 0, err
+	}
+
+	screen := currentProvider().ActiveScreenBounds()
+
+	start := time.Now()
+	var sent atomic.Int64
+	var visited atomic.Int64
+
+	// Every visited node needs an element, info, depth and its branch; TreeNode links are
+	// not kept. counts is only tracked while learning subtree pruning.
+	type pendingNode struct {
+		element *Element
+		info    *ElementInfo
+		depth   int
+		branch  walkBranch
+		counts  *subtreeCounts
+	}
+	var countsMu sync.Mutex
+	var allCounts []*subtreeCounts
+
+	queue := traversal.NewPriorityQueue(opts.Workers)
+	var visit func(node pendingNode) traversal.PriorityTask
+	visit = func(node pendingNode) traversal.PriorityTask {
+		return func(queue *traversal.PriorityQueue) {
+			if ctx.Err() != nil {
+				return
+			}
+			visited.Add(1)
+
+			clickable := node.element.isClickable(node.info)
+			if node.counts != nil {
+				node.counts.add(clickable, node.branch.content)
+			}
+			if clickable {
+				select {
+				case out <- &TreeNode{
+					Element:   node.element,
+					Info:      node.info,
+					Signature: node.branch.signature(node.info),
+				}:
+					if sent.Add(1) == 1 {
+						logger.Debug("First clickable element streamed",
+							zap.Duration("elapsed", time.Since(start)))
+					}
+				case <-ctx.Done():
+					return
+				}
+			}
+
+			children, infos, validCount := resolveChildren(
+				node.element,
+				node.info,
+				node.depth+1,
+				opts,
+				node.branch,
+			)
+			if validCount == 0 {
+				return
+			}
+			// What survives the clip is visible in the window; the screen may still cut it off
+			viewport := node.branch.clip.Intersect(screen)
+			for index, child := range children {
+				if infos[index] == nil {
+					continue
+				}
+				priority := int64(node.depth + 1)
+				if !rectFromInfo(infos[index]).Overlaps(viewport) {
+					priority += offscreenPriority
+				}
+				branch := node.branch.child(infos[index])
+				var counts *subtreeCounts
+				if node.counts != nil {
+					counts = &subtreeCounts{
+						parent:    node.counts,
+						signature: branch.signature(infos[index]),
+					}
+					countsMu.Lock()
+					allCounts = append(allCounts, counts)
+					countsMu.Unlock()
+				}
+				queue.Push(priority, visit(pendingNode{
+					element: child,
+					info:    infos[index],
+					depth:   node.depth + 1,
+					branch:  branch,
+					counts:  counts,
+				}))
+			}
+		}
+	}
+
+	branch := rootBranch(info)
+	var rootCounts *subtreeCounts
+	if opts.skips != nil {
+		rootCounts = &subtreeCounts{signature: branch.signature(info)}
+		allCounts = append(allCounts, rootCounts)
+	}
+	queue.Push(0, visit(pendingNode{
+		element: root,
+		info:    info,
+		depth:   0,
+		branch:  branch,
+		counts:  rootCounts,
+	}))
+	err = queue.Run(ctx)
+
+	if err == nil {
+		opts.walk.finish()
+	}
+
+	// Only a complete walk shows that a subtree holds nothing clickable
+	if err == nil && opts.skips != nil {
+		for _, counts := range allCounts {
+			if counts.content.Load() {
+				continue
+			}
+			opts.skips.observe(
+				counts.signature,
+				int(counts.nodes.Load()),
+				int(counts.clickables.Load()),
+			)
+		}
+		opts.commitSkips()
+	}
+
+	logger.Debug("Streaming traversal finished",
+		zap.Int64("visited", visited.Load()),
+		zap.Int64("sent", sent.Load()),
+		zap.Duration("duration", time.Since(start)),
+		zap.Bool("cancelled", err != nil))
+
+	return int(sent.Load()), err
+}
+
+// streamTracked brings the tracked tree of window up to date and sends its clickable nodes.
+// Nodes the build walks are sent as they are found, the unchanged rest once the tree is up
+// to date. A cancelled build leaves the tracked tree dirty and returns ctx's error.
+func streamTracked(
+	ctx context.Context,
+	tracker *treeTracker,
+	window *Element,
+	opts TreeOptions,
+	out chan<- *TreeNode,
+) (int, error) {
+	var sent atomic.Int64
+	var foundMu sync.Mutex
+	found := make(map[*TreeNode]struct{})
+
+	opts.walk.ctx = ctx
+	opts.found = func(node *TreeNode, branch walkBranch) {
+		foundMu.Lock()
+		found[node] = struct{}{}
+		foundMu.Unlock()
+
+		// The tracked node is signed later; consumers get a copy of their own
+		select {
+		case out <- &TreeNode{
+			Element:   node.Element,
+			Info:      node.Info,
+			Signature: branch.signature(node.Info),
+		}:
+			sent.Add(1)
+		case <-ctx.Done():
+		}
+	}
+
+	tree, err := tracker.build(window, opts)
+	if errors.Is(err, errWalkCancelled) || (err == nil && opts.walk.cancelled()) {
+		logger.Debug("Tracked walk cancelled", zap.Int64("sent", sent.Load()))
+		return int(sent.Load()), ctx.Err()
+	}
+	if err != nil {
+		logger.Error("Failed to build tree for frontmost window", zap.Error(err))
+		return int(sent.Load()), err
+	}
+
+	elements := tree.findClickable(opts.skips)
+	opts.commitSkips()
+
+	rest := make([]*TreeNode, 0, len(elements))
+	for _, element := range elements {
+		if _, ok := found[element]; !ok {
+			rest = append(rest, element)
+		}
+	}
+	count, err := sendNodes(ctx, out, rest)
+	return int(sent.Load()) + count, err
+}
+
+// subtreeCounts accumulates the nodes and clickable elements found below one streamed node.
+type subtreeCounts struct {
+	parent     *subtreeCounts
+	signature  pruning.Signature
+	nodes      atomic.Int32
+	clickables atomic.Int32
+	// content is set once the subtree is known to hold content.
+	content atomic.Bool
+}
+
+// add counts a visited node in its own subtree and in those of all its ancestors. content
+// tells whether the node is content, which its subtree and those of its ancestors then hold.
+func (c *subtreeCounts) add(clickable, content bool) {
+	for counts := c; counts != nil; counts = counts.parent {
+		counts.nodes.Add(1)
+		if clickable {
+			counts.clickables.Add(1)
+		}
+		if content {
+			counts.content.Store(true)
+		}
+	}
+}
+
+// sendNodes sends already collected nodes until ctx is done.
+func sendNodes(ctx context.Context, out chan<- *TreeNode, nodes []*TreeNode) (int, error) {
+	for index, node := range nodes {
+		select {
+		case out <- node:
+		case <-ctx.Done():
+			return index, ctx.Err()
+		}
+	}
+	return len(nodes), nil
+}
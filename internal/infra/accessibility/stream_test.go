@@ -0,0 +1,80 @@
+package accessibility
+
+import (
+	"context"
+	"errors"
+	"testing"
+)
+
+// TestStreamHonorsMaxDepthLikeBuildTree checks that both walkers count depth the same way, so
+// a depth cap or skip reaches the same nodes whichever of them walks.
+func TestStreamHonorsMaxDepthLikeBuildTree(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	window := provider.FrontmostWindow()
+
+	for _, maxDepth := range []int{1, 2, 3, 0} {
+		opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 2, MaxDepth: maxDepth}
+
+		root, err := BuildTree(window, opts)
+		if err != nil {
+			t.Fatalf("BuildTree(MaxDepth=%d) error = %v", maxDepth, err)
+		}
+		want := len(root.FindClickableElements())
+
+		out := make(chan *TreeNode, provider.Len())
+		got, err := streamClickable(context.Background(), window, opts, out)
+		if err != nil {
+			t.Fatalf("streamClickable(MaxDepth=%d) error = %v", maxDepth, err)
+		}
+		if got != want {
+			t.Errorf("streamClickable(MaxDepth=%d) sent %d elements, BuildTree() found %d",
+				maxDepth, got, want)
+		}
+	}
+}
+
+// TestStreamTrackedSendsEachClickableOnce checks that a tracked build streams what it walks and
+// sends the rest afterwards without repeating a node, and that cancelling it is clean.
+func TestStreamTrackedSendsEachClickableOnce(t *testing.T) {
+	provider := useSyntheticTree(t, flatTreeSpec)
+	window := provider.FrontmostWindow()
+	tracker := newTreeTracker()
+
+	opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: 2}
+	root, err := BuildTree(window, opts)
+	if err != nil {
+		t.Fatalf("BuildTree() error = %v", err)
+	}
+	want := len(root.FindClickableElements())
+
+	for range 2 {
+		opts.walk = &walkStats{pid: flatTreeSpec.PID}
+		out := make(chan *TreeNode, provider.Len())
+		got, err := streamTracked(context.Background(), tracker, window, opts, out)
+		if err != nil {
+			t.Fatalf("streamTracked() error = %v", err)
+		}
+		close(out)
+
+		seen := make(map[*Element]bool, got)
+		for node := range out {
+			if seen[node.Element] {
+				t.Fatalf("streamTracked() sent %v twice", node.Info.Role)
+			}
+			seen[node.Element] = true
+		}
+		if got != want || len(seen) != want {
+			t.Errorf("streamTracked() sent %d elements (%d distinct), BuildTree() found %d",
+				got, len(seen), want)
+		}
+	}
+
+	ctx, cancel := context.WithCancel(context.Background())
+	cancel()
+	tracker.invalidate(window)
+	opts.walk = &walkStats{pid: flatTreeSpec.PID}
+	_, err = streamTracked(ctx, tracker, window, opts, make(chan *TreeNode, provider.Len()))
+	if !errors.Is(err, context.Canceled) {
+		t.Errorf("cancelled streamTracked() error = %v, want context.Canceled", err)
+	}
+}
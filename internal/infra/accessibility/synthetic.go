@@ -0,0 +1,392 @@
+package accessibility
+
+import (
+	"encoding/json"
+	"fmt"
+	"image"
+	"math/rand"
+	"os"
+	"time"
+	"unsafe"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/occlusion"
+)
+
+// DefaultSyntheticMaxNodes bounds generated trees when a spec sets no limit.
+const DefaultSyntheticMaxNodes = 1 << 20
+
+// DefaultSyntheticRoles is the role mix of generated trees when a spec names none.
+var DefaultSyntheticRoles = []SyntheticRole{
+	{Name: "AXGroup", Weight: 6},
+	{Name: "AXButton", Weight: 3, Leaf: true, Clickable: true},
+	{Name: "AXStaticText", Weight: 3, Leaf: true},
+	{Name: "AXLink", Weight: 1, Leaf: true, Clickable: true},
+	{Name: "AXCheckBox", Weight: 1, Leaf: true, Clickable: true},
+	{Name: "AXImage", Weight: 1, Leaf: true},
+}
+
+// SyntheticSpec describes an accessibility tree generated in memory. The same spec always
+// yields the same tree, so runs on different machines are comparable. A spec either gives
+// an explicit Tree or lets the tree be generated from FanOut, Depth and the role mix.
+type SyntheticSpec struct {
+	// Seed drives the role mix of generated trees.
+	Seed int64 `json:"seed"`
+	// PID and BundleID identify the synthetic application.
+	PID      int    `json:"pid"`
+	BundleID string `json:"bundle_id"`
+	// Window is the window's frame; an empty frame is a 1440x900 window at the origin.
+	Window SyntheticFrame `json:"window"`
+	// Screen is the active screen; an empty frame is the window's.
+	Screen SyntheticFrame `json:"screen"`
+	// FanOut is the number of children of every generated container, down to Depth levels
+	// below the window.
+	FanOut int `json:"fan_out"`
+	Depth  int `json:"depth"`
+	// MaxNodes bounds the tree; 0 uses DefaultSyntheticMaxNodes.
+	MaxNodes int `json:"max_nodes"`
+	// Roles is the weighted role mix; empty uses DefaultSyntheticRoles.
+	Roles []SyntheticRole `json:"roles"`
+	// Tree is an explicit tree below the window, used instead of generating one.
+	Tree []*SyntheticNode `json:"tree,omitempty"`
+	// Occluders are windows of other processes stacked above the window, front to back.
+	Occluders []SyntheticFrame `json:"occluders"`
+	// CallLatencyUs is slept in every children call to simulate the application's replies.
+	CallLatencyUs int `json:"call_latency_us"`
+}
+
+// SyntheticFrame is a frame in screen coordinates.
+type SyntheticFrame struct {
+	X      int `json:"x"`
+	Y      int `json:"y"`
+	Width  int `json:"width"`
+	Height int `json:"height"`
+}
+
+// SyntheticRole is one role of a generated tree's role mix.
+type SyntheticRole struct {
+	Name string `json:"name"`
+	// Weight is the role's share of generated nodes relative to the other roles.
+	Weight int `json:"weight"`
+	// Leaf roles have no children.
+	Leaf bool `json:"leaf"`
+	// Clickable roles report a click action.
+	Clickable bool `json:"clickable"`
+}
+
+// SyntheticNode is one element of an explicit synthetic tree.
+type SyntheticNode struct {
+	Role      string           `json:"role"`
+	Frame     SyntheticFrame   `json:"frame"`
+	Clickable bool             `json:"clickable"`
+	Children  []*SyntheticNode `json:"children,omitempty"`
+}
+
+// SyntheticProvider is a Provider over a tree generated in memory. Its elements need no
+// releasing, its windows never change and it sends no notifications, so incremental trees
+// fall back to full walks. Roles are only collected if they are configured as clickable
+// with SetClickableRoles, as with the bridge.
+type SyntheticProvider struct {
+	pid       int
+	bundleID  string
+	screen    image.Rectangle
+	occluders []image.Rectangle
+	latency   time.Duration
+	// nodes are stored breadth first, so the children of a node are contiguous.
+	nodes []syntheticElement
+}
+
+// syntheticElement is one node of the flattened tree. Element references point at it.
+type syntheticElement struct {
+	index  int32
+	first  int32
+	count  int32
+	action ClickAction
+	role   RoleID
+	name   string
+	frame  image.Rectangle
+}
+
+// LoadSyntheticSpec reads a spec from a JSON fixture.
+func LoadSyntheticSpec(path string) (SyntheticSpec, error) {
+	var spec SyntheticSpec
+
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return spec, fmt.Errorf("failed to read synthetic tree: %w", err)
+	}
+
+	err = json.Unmarshal(data, &spec)
+	if err != nil {
+		return spec, fmt.Errorf("failed to parse synthetic tree %s: %w", path, err)
+	}
+	return spec, nil
+}
+
+// NewSyntheticProvider builds the tree the spec describes.
+func NewSyntheticProvider(spec SyntheticSpec) *SyntheticProvider {
+	window := spec.Window.rect()
+	if window.Empty() {
+		window = image.Rect(0, 0, 1440, 900)
+	}
+	screen := spec.Screen.rect()
+	if screen.Empty() {
+		screen = window
+	}
+	maxNodes := spec.MaxNodes
+	if maxNodes <= 0 {
+		maxNodes = DefaultSyntheticMaxNodes
+	}
+
+	provider := &SyntheticProvider{
+		pid:      spec.PID,
+		bundleID: spec.BundleID,
+		screen:   screen,
+		latency:  time.Duration(spec.CallLatencyUs) * time.Microsecond,
+		nodes:    make([]syntheticElement, 0, min(maxNodes, 1<<12)),
+	}
+	for _, occluder := range spec.Occluders {
+		provider.occluders = append(provider.occluders, occluder.rect())
+	}
+
+	provider.add("AXWindow", window, false)
+	if len(spec.Tree) > 0 {
+		provider.addExplicit(spec.Tree, maxNodes)
+	} else {
+		provider.generate(spec, maxNodes)
+	}
+
+	return provider
+}
+
+// Len returns the number of elements in the tree, the window included.
+func (p *SyntheticProvider) Len() int {
+	return len(p.nodes)
+}
+
+// FrontmostWindow returns the window, the root of the tree.
+func (p *SyntheticProvider) FrontmostWindow() *Element {
+	trackRefs(1)
+	return p.element(0)
+}
+
+// Info returns the frame and role of the element.
+func (p *SyntheticProvider) Info(element *Element) (*ElementInfo, error) {
+	node := (*syntheticElement)(element.ref)
+	info := p.info(node)
+	return &info, nil
+}
+
+// ChildrenWithInfo returns the children of the element after the simulated latency.
+func (p *SyntheticProvider) ChildrenWithInfo(
+	element *Element,
+	_ RoleID,
+) ([]*Element, []*ElementInfo, bool) {
+	if p.latency > 0 {
+		time.Sleep(p.latency)
+	}
+
+	node := (*syntheticElement)(element.ref)
+	count := int(node.count)
+	if count == 0 {
+		return nil, nil, false
+	}
+
+	elements := make([]*Element, count)
+	infos := make([]*ElementInfo, count)
+	elementBacking := make([]Element, count)
+	infoBacking := make([]ElementInfo, count)
+	for i := range count {
+		child := &p.nodes[int(node.first)+i]
+		elementBacking[i].ref, elementBacking[i].key = p.reference(child.index)
+		elements[i] = &elementBacking[i]
+		infoBacking[i] = p.info(child)
+		infos[i] = &infoBacking[i]
+	}
+	trackRefs(count)
+
+	return elements, infos, false
+}
+
+// ClickAction returns the click action the element was generated with.
+func (p *SyntheticProvider) ClickAction(element *Element) ClickAction {
+	return (*syntheticElement)(element.ref).action
+}
+
+// BundleIdentifier returns the spec's bundle identifier.
+func (p *SyntheticProvider) BundleIdentifier(*Element) string {
+	return p.bundleID
+}
+
+// Title returns ""; synthetic elements have no titles.
+func (p *SyntheticProvider) Title(*Element) string {
+	return ""
+}
+
+// Equal compares the elements pairwise by reference.
+func (p *SyntheticProvider) Equal(first, second []*Element) []bool {
+	equal := make([]bool, len(first))
+	for i := range first {
+		equal[i] = first[i].ref == second[i].ref
+	}
+	return equal
+}
+
+// Retain returns ref; synthetic elements live as long as the provider.
+func (p *SyntheticProvider) Retain(ref unsafe.Pointer) unsafe.Pointer {
+	return ref
+}
+
+// Release does nothing; synthetic elements live as long as the provider.
+func (p *SyntheticProvider) Release([]unsafe.Pointer) {}
+
+// Windows returns the occluders, front to back, followed by the window. Occluders belong
+// to processes other than the synthetic application.
+func (p *SyntheticProvider) Windows() []occlusion.Window {
+	windows := make([]occlusion.Window, 0, len(p.occluders)+1)
+	for _, occluder := range p.occluders {
+		windows = append(windows, occlusion.Window{PID: p.pid + 1, Bounds: occluder})
+	}
+	return append(windows, occlusion.Window{PID: p.pid, Bounds: p.nodes[0].frame})
+}
+
+// ActiveScreenBounds returns the spec's screen.
+func (p *SyntheticProvider) ActiveScreenBounds() image.Rectangle {
+	return p.screen
+}
+
+// SetMessagingTimeout does nothing; synthetic replies never time out.
+func (p *SyntheticProvider) SetMessagingTimeout(int, time.Duration) {}
+
+// Observe returns nil; synthetic trees never change.
+func (p *SyntheticProvider) Observe(int) func() {
+	return nil
+}
+
+// element wraps the node at index. The key's hash is unique per node and never 0.
+func (p *SyntheticProvider) element(index int32) *Element {
+	element := &Element{}
+	element.ref, element.key = p.reference(index)
+	return element
+}
+
+// reference returns the reference and identity of the node at index.
+func (p *SyntheticProvider) reference(index int32) (unsafe.Pointer, elementKey) {
+	return unsafe.Pointer(&p.nodes[index]), elementKey{hash: uint64(index) + 1, pid: p.pid}
+}
+
+// info returns the ElementInfo of a node.
+func (p *SyntheticProvider) info(node *syntheticElement) ElementInfo {
+	return ElementInfo{
+		Position: node.frame.Min,
+		Size:     node.frame.Size(),
+		Role:     node.name,
+		RoleID:   node.role,
+		PID:      p.pid,
+	}
+}
+
+// add appends a node without children and returns its index.
+func (p *SyntheticProvider) add(role string, frame image.Rectangle, clickable bool) int32 {
+	index := int32(len(p.nodes))
+	id := InternRole(role)
+	action := ClickActionNone
+	if clickable {
+		action = ClickActionPresent
+	}
+	p.nodes = append(p.nodes, syntheticElement{
+		index:  index,
+		action: action,
+		role:   id,
+		name:   id.String(),
+		frame:  frame,
+	})
+	return index
+}
+
+// addExplicit appends an explicit tree below the window, breadth first.
+func (p *SyntheticProvider) addExplicit(tree []*SyntheticNode, maxNodes int) {
+	pending := [][]*SyntheticNode{tree}
+	for parent := 0; parent < len(pending) && parent < len(p.nodes); parent++ {
+		children := pending[parent]
+		if len(p.nodes)+len(children) > maxNodes {
+			return
+		}
+
+		p.nodes[parent].first = int32(len(p.nodes))
+		p.nodes[parent].count = int32(len(children))
+		for _, child := range children {
+			p.add(child.Role, child.Frame.rect(), child.Clickable)
+			pending = append(pending, child.Children)
+		}
+	}
+}
+
+// generate appends a tree shaped by the spec below the window, breadth first. Children
+// split their parent's frame into equal slices along its longer side.
+func (p *SyntheticProvider) generate(spec SyntheticSpec, maxNodes int) {
+	roles := spec.Roles
+	if len(roles) == 0 {
+		roles = DefaultSyntheticRoles
+	}
+	totalWeight := 0
+	for _, role := range roles {
+		totalWeight += max(role.Weight, 0)
+	}
+	if spec.FanOut <= 0 || spec.Depth <= 0 || totalWeight == 0 {
+		return
+	}
+
+	random := rand.New(rand.NewSource(spec.Seed))
+	depths := []int{0}
+	for parent := 0; parent < len(p.nodes); parent++ {
+		if depths[parent] >= spec.Depth {
+			continue
+		}
+		if len(p.nodes)+spec.FanOut > maxNodes {
+			return
+		}
+
+		p.nodes[parent].first = int32(len(p.nodes))
+		p.nodes[parent].count = int32(spec.FanOut)
+		frame := p.nodes[parent].frame
+		for slice := range spec.FanOut {
+			role := pickRole(roles, random.Intn(totalWeight))
+			p.add(role.Name, sliceFrame(frame, slice, spec.FanOut), role.Clickable)
+
+			// Leaves stay childless by sitting at the depth limit
+			depth := depths[parent] + 1
+			if role.Leaf {
+				depth = spec.Depth
+			}
+			depths = append(depths, depth)
+		}
+	}
+}
+
+// pickRole returns the role a weighted draw in [0, total weight) falls on.
+func pickRole(roles []SyntheticRole, draw int) SyntheticRole {
+	for _, role := range roles {
+		if draw < role.Weight {
+			return role
+		}
+		draw -= max(role.Weight, 0)
+	}
+	return roles[len(roles)-1]
+}
+
+// sliceFrame returns slice index of count equal slices of frame along its longer side.
+func sliceFrame(frame image.Rectangle, index, count int) image.Rectangle {
+	if frame.Dx() >= frame.Dy() {
+		width := frame.Dx() / count
+		x := frame.Min.X + index*width
+		return image.Rect(x, frame.Min.Y, x+width, frame.Max.Y)
+	}
+	height := frame.Dy() / count
+	y := frame.Min.Y + index*height
+	return image.Rect(frame.Min.X, y, frame.Max.X, y+height)
+}
+
+// rect converts the frame to a rectangle.
+func (f SyntheticFrame) rect() image.Rectangle {
+	return image.Rect(f.X, f.Y, f.X+f.Width, f.Y+f.Height)
+}
@@ -0,0 +1,363 @@
+package accessibility
+
+import (
+	"errors"
+	"sync"
+	"sync/atomic"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/incremental"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// errWalkCancelled is returned for a background walk that was cancelled before it finished.
+var errWalkCancelled = errors.New("walk cancelled")
+
+// windowTree is the persistent tree of one window together with an identity index into it.
+type windowTree struct {
+	window *Element
+	root   *TreeNode
+	nodes  map[incremental.Key]*TreeNode
+}
+
+// treeTracker keeps the trees of recently scanned windows alive between activations and
+// re-walks only the subtrees that accessibility notifications reported as changed.
+type treeTracker struct {
+	// mu serializes activations. Notifications never take it; they only touch set.
+	mu      sync.Mutex
+	set     *incremental.Set
+	windows map[incremental.Key]*windowTree
+	// observers holds the function stopping each observed process's notifications.
+	observers map[int]func()
+}
+
+// activeTracker receives observer callbacks; it is nil while incremental trees are disabled.
+var activeTracker atomic.Pointer[treeTracker]
+
+// SetIncrementalTree enables or disables persistent, notification-driven window trees.
+// Disabling drops all tracked trees and observers.
+func SetIncrementalTree(enabled bool) {
+	if enabled {
+		if activeTracker.Load() == nil {
+			tracker := newTreeTracker()
+			if !activeTracker.CompareAndSwap(nil, tracker) {
+				return
+			}
+			logger.Debug("Incremental tree enabled")
+		}
+		return
+	}
+
+	tracker := activeTracker.Swap(nil)
+	if tracker != nil {
+		tracker.mu.Lock()
+		tracker.set.Clear()
+		tracker.mu.Unlock()
+		logger.Debug("Incremental tree disabled")
+	}
+}
+
+func newTreeTracker() *treeTracker {
+	tracker := &treeTracker{
+		windows:   make(map[incremental.Key]*windowTree),
+		observers: make(map[int]func()),
+	}
+	tracker.set = incremental.NewSet(incremental.DefaultMaxTrees, tracker.evict)
+	return tracker
+}
+
+// build returns the up-to-date tree of window, re-walking only dirty subtrees when a
+// previous tree of the same window is available. A tree from a truncated walk is returned
+// but marked dirty, so the next build walks the whole window again.
+func (t *treeTracker) build(window *Element, opts TreeOptions) (root *TreeNode, err error) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	// Subtree rewalks wrap elements into the walk's scope just like a full walk
+	release := opts.scope.hold()
+	defer release()
+
+	key := window.identity()
+	defer func() {
+		// Depth caps, quarantine and timeouts leave elements out that no notification reports
+		if err == nil && opts.walk.truncated() {
+			t.set.With(key, func(tree *incremental.Tree) {
+				tree.Invalidate()
+			})
+			logger.Debug("Truncated walk, tracked tree marked dirty", zap.Int("pid", key.PID))
+		}
+	}()
+
+	// A recycled hash must not resurrect another window's tree
+	if existing := t.windows[key]; existing != nil &&
+		!elementsEqual([]*Element{existing.window}, []*Element{window})[0] {
+		t.set.Remove(key)
+	}
+
+	observed := t.ensureObserver(key.PID)
+
+	var roots []incremental.Key
+	var full bool
+	t.set.With(key, func(tree *incremental.Tree) {
+		if !observed {
+			tree.Invalidate()
+		}
+		roots, full = tree.TakeDirty()
+	})
+
+	current := t.windows[key]
+	if current == nil || full {
+		return t.rebuild(key, window, opts)
+	}
+
+	walked := 0
+	for _, dirtyKey := range roots {
+		node := current.nodes[dirtyKey]
+		if node == nil {
+			continue
+		}
+
+		node = t.rewalk(current, node, opts)
+		if node == nil {
+			// The change reached the window itself
+			return t.rebuild(key, window, opts)
+		}
+		walked++
+
+		t.set.With(key, func(tree *incremental.Tree) {
+			tree.RecordSubtree(
+				node.Element.identity(),
+				func(record func(incremental.Key, []incremental.Key)) {
+					recordNode(node, record)
+				},
+			)
+		})
+	}
+
+	logger.Debug("Incremental tree updated",
+		zap.Int("dirty_subtrees", len(roots)),
+		zap.Int("walked_subtrees", walked),
+		zap.Int("nodes", len(current.nodes)))
+
+	return current.root, nil
+}
+
+// rebuild walks the whole window and replaces its tracked tree.
+func (t *treeTracker) rebuild(
+	key incremental.Key,
+	window *Element,
+	opts TreeOptions,
+) (*TreeNode, error) {
+	retained := window.retain()
+
+	root, err := BuildTree(retained, opts)
+	if err != nil {
+		retained.Release()
+		t.set.Remove(key)
+		return nil, err
+	}
+	if opts.walk.cancelled() {
+		// Keep the previous tree, if any, for the next build to replace; the partial walk's
+		// elements stay with the walk's scope
+		retained.Release()
+		t.set.With(key, func(tree *incremental.Tree) {
+			tree.Invalidate()
+		})
+		return nil, errWalkCancelled
+	}
+
+	// Tracked trees outlive the activation scope that wrapped their elements
+	KeepElements(collectSubtree(root)[1:])
+	if previous := t.windows[key]; previous != nil {
+		previous.release()
+	}
+
+	current := &windowTree{
+		window: retained,
+		root:   root,
+		nodes:  make(map[incremental.Key]*TreeNode, 256),
+	}
+	indexNode(current.nodes, root)
+	t.windows[key] = current
+
+	t.set.With(key, func(tree *incremental.Tree) {
+		tree.RecordSubtree(key, func(record func(incremental.Key, []incremental.Key)) {
+			recordNode(root, record)
+		})
+	})
+
+	logger.Debug("Incremental tree rebuilt",
+		zap.Int("pid", key.PID),
+		zap.Int("nodes", len(current.nodes)))
+
+	return root, nil
+}
+
+// invalidate makes the next build of window walk the whole window again.
+func (t *treeTracker) invalidate(window *Element) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.set.With(window.identity(), func(tree *incremental.Tree) {
+		tree.Invalidate()
+	})
+}
+
+// rewalk refreshes node and replaces its subtree. If node no longer exists or no longer
+// passes the filters, its parent is walked instead. It returns the node that was walked,
+// or nil when the walk would have to start at the window.
+func (t *treeTracker) rewalk(
+	current *windowTree,
+	node *TreeNode,
+	opts TreeOptions,
+) *TreeNode {
+	// Scrolling only reports a value change on the scroll bar, while the content it reveals
+	// was pruned by the scroll area's clip; walk the scroll area instead
+	if node.Info != nil && node.Info.RoleID == scrollBarRole && node.Parent != nil &&
+		clippingRoles.Has(node.Parent.Info.RoleID) {
+		node = node.Parent
+	}
+
+	for node != nil && node.Parent != nil {
+		stale := collectSubtree(node)
+		opts.Cache.Remove(stale)
+
+		parentBranch := node.Parent.walkBranch()
+		info, err := node.Element.GetInfo()
+		if err == nil && shouldIncludeElement(info, opts, parentBranch.clip) {
+			for _, element := range stale[1:] {
+				key := element.identity()
+				if indexed := current.nodes[key]; indexed != nil && indexed.Element == element {
+					delete(current.nodes, key)
+				}
+			}
+
+			opts.Cache.Set(node.Element, info)
+			node.Info = info
+			node.Children = nil
+			buildTreeRecursive(node, node.depth()+1, opts, parentBranch.child(info))
+			KeepElements(collectSubtree(node)[1:])
+			ReleaseElements(stale[1:])
+			indexNode(current.nodes, node)
+			return node
+		}
+
+		node = node.Parent
+	}
+
+	return nil
+}
+
+// ensureObserver starts observing the process if needed and reports whether
+// notifications for it are being delivered.
+func (t *treeTracker) ensureObserver(pid int) bool {
+	if _, ok := t.observers[pid]; ok {
+		return true
+	}
+
+	stop := currentProvider().Observe(pid)
+	if stop == nil {
+		logger.Debug("Element observer unavailable, falling back to full walks", zap.Int("pid", pid))
+		return false
+	}
+
+	t.observers[pid] = stop
+	logger.Debug("Element observer created", zap.Int("pid", pid))
+	return true
+}
+
+// evict releases the resources of a dropped window tree. It runs with t.mu held.
+func (t *treeTracker) evict(root incremental.Key, lastOfPID bool) {
+	if current := t.windows[root]; current != nil {
+		current.release()
+		delete(t.windows, root)
+	}
+
+	if !lastOfPID {
+		return
+	}
+	if stop, ok := t.observers[root.PID]; ok {
+		stop()
+		delete(t.observers, root.PID)
+		logger.Debug("Element observer destroyed", zap.Int("pid", root.PID))
+	}
+}
+
+// release drops the references held by the tree. The root node wraps the retained window.
+func (w *windowTree) release() {
+	ReleaseElements(collectSubtree(w.root)[1:])
+	w.window.Release()
+}
+
+// identity returns the key under which incremental trees know the element.
+func (e *Element) identity() incremental.Key {
+	return incremental.Key{PID: e.key.pid, Hash: e.key.hash}
+}
+
+// depth returns the number of ancestors of the node; the tree root has none.
+func (n *TreeNode) depth() int {
+	depth := 0
+	for parent := n.Parent; parent != nil; parent = parent.Parent {
+		depth++
+	}
+	return depth
+}
+
+// walkBranch returns the node's position in a walk from the tree root, folding the branches
+// of its ancestors down as the tree walk does.
+func (n *TreeNode) walkBranch() walkBranch {
+	if n.Parent == nil {
+		return rootBranch(n.Info)
+	}
+	return n.Parent.walkBranch().child(n.Info)
+}
+
+// collectSubtree returns the elements of node and all of its descendants, node first.
+func collectSubtree(node *TreeNode) []*Element {
+	elements := make([]*Element, 0, 16)
+	pending := []*TreeNode{node}
+	for len(pending) > 0 {
+		last := len(pending) - 1
+		current := pending[last]
+		pending = pending[:last]
+
+		elements = append(elements, current.Element)
+		pending = append(pending, current.Children...)
+	}
+	return elements
+}
+
+// indexNode adds node and its descendants to the identity index.
+func indexNode(nodes map[incremental.Key]*TreeNode, node *TreeNode) {
+	nodes[node.Element.identity()] = node
+	for _, child := range node.Children {
+		indexNode(nodes, child)
+	}
+}
+
+// recordNode reports the structure below node to an incremental tree.
+func recordNode(node *TreeNode, record func(incremental.Key, []incremental.Key)) {
+	children := make([]incremental.Key, len(node.Children))
+	for index, child := range node.Children {
+		children[index] = child.Element.identity()
+	}
+	record(node.Element.identity(), children)
+
+	for _, child := range node.Children {
+		recordNode(child, record)
+	}
+}
+
+// dispatchElementEvent forwards an observer notification to the active tracker and source
+// cache. It runs on the bridge's serial event queue and must stay cheap.
+func dispatchElementEvent(event incremental.Event) {
+	if sources := activeSources.Load(); sources != nil {
+		sources.dispatch(event)
+	}
+
+	tracker := activeTracker.Load()
+	if tracker == nil {
+		return
+	}
+	tracker.set.Dispatch(event)
+}
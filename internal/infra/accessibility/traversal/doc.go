@@ -0,0 +1,23 @@
+// Package traversal provides the bounded work-stealing scheduler used to walk
+// accessibility trees in parallel.
+//
+// A Scheduler runs a fixed number of workers, sized from GOMAXPROCS by default. Each
+// worker owns a deque of tasks: it pushes and pops its own work at the bottom, which keeps
+// a depth-first walk cache-friendly, while idle workers steal from the top of other deques,
+// where the oldest and usually largest subtrees sit. The number of goroutines therefore
+// stays constant no matter how wide or deep the tree is.
+//
+// The scheduler does not order results. Callers keep output deterministic by writing each
+// task's result into a slot chosen before the task was spawned, as the tree builder does
+// with child node slices.
+//
+// PriorityQueue serves progressive walks instead: its workers always take the most
+// important pending task, such as an on-screen node close to the root, and it stops
+// handing out work as soon as its context is cancelled.
+//
+// Limiter bounds the in-flight requests to each application, and LatencyTracker measures
+// how long each application takes to answer, so callers can raise or lower those bounds
+// per application.
+//
+// The package has no platform dependencies.
+package traversal
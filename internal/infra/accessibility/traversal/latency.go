@@ -0,0 +1,132 @@
+package traversal
+
+import (
+	"slices"
+	"sync"
+	"time"
+)
+
+const (
+	// latencyWindow is the number of recent samples per key that percentiles are taken from.
+	latencyWindow = 256
+	// latencyAlpha weighs the newest sample in the moving average.
+	latencyAlpha = 0.2
+	// maxLatencyKeys bounds the keys tracked; the least recently measured one is dropped.
+	maxLatencyKeys = 64
+)
+
+// LatencySummary describes the measured call latency of one key.
+type LatencySummary struct {
+	Calls uint64
+	EWMA  time.Duration
+	P50   time.Duration
+	P90   time.Duration
+	P99   time.Duration
+}
+
+// latencySamples holds the measurements of one key.
+type latencySamples struct {
+	calls    uint64
+	ewma     float64
+	ring     [latencyWindow]time.Duration
+	recorded uint64
+}
+
+// LatencyTracker measures call latency per key: an exponentially weighted moving average
+// over all calls and percentiles over the most recent ones. The accessibility layer keys
+// it by process ID. It is safe for concurrent use.
+type LatencyTracker struct {
+	mu       sync.Mutex
+	keys     map[int]*latencySamples
+	sequence uint64
+}
+
+// NewLatencyTracker creates an empty tracker.
+func NewLatencyTracker() *LatencyTracker {
+	return &LatencyTracker{keys: make(map[int]*latencySamples)}
+}
+
+// Record adds one call duration for key.
+func (t *LatencyTracker) Record(key int, duration time.Duration) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	samples, ok := t.keys[key]
+	if !ok {
+		if len(t.keys) >= maxLatencyKeys {
+			t.evictLocked()
+		}
+		samples = &latencySamples{ewma: float64(duration)}
+		t.keys[key] = samples
+	}
+
+	samples.ring[samples.calls%latencyWindow] = duration
+	samples.calls++
+	samples.ewma += latencyAlpha * (float64(duration) - samples.ewma)
+	t.sequence++
+	samples.recorded = t.sequence
+}
+
+// Summary returns the latency of key; ok is false when no call was recorded.
+func (t *LatencyTracker) Summary(key int) (LatencySummary, bool) {
+	t.mu.Lock()
+	samples, ok := t.keys[key]
+	if !ok {
+		t.mu.Unlock()
+		return LatencySummary{}, false
+	}
+	calls := samples.calls
+	ewma := samples.ewma
+	recent := slices.Clone(samples.ring[:min(calls, latencyWindow)])
+	t.mu.Unlock()
+
+	slices.Sort(recent)
+	return LatencySummary{
+		Calls: calls,
+		EWMA:  time.Duration(ewma),
+		P50:   percentile(recent, 50),
+		P90:   percentile(recent, 90),
+		P99:   percentile(recent, 99),
+	}, true
+}
+
+// Keys returns the keys with recorded calls, in ascending order.
+func (t *LatencyTracker) Keys() []int {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	keys := make([]int, 0, len(t.keys))
+	for key := range t.keys {
+		keys = append(keys, key)
+	}
+	slices.Sort(keys)
+	return keys
+}
+
+// Forget drops the measurements of key.
+func (t *LatencyTracker) Forget(key int) {
+	t.mu.Lock()
+	delete(t.keys, key)
+	t.mu.Unlock()
+}
+
+// evictLocked drops the least recently measured key.
+func (t *LatencyTracker) evictLocked() {
+	oldestKey, oldest := 0, uint64(0)
+	found := false
+	for key, samples := range t.keys {
+		if !found || samples.recorded < oldest {
+			oldestKey, oldest, found = key, samples.recorded, true
+		}
+	}
+	delete(t.keys, oldestKey)
+}
+
+// percentile returns the given percentile of sorted samples using the nearest-rank method.
+func percentile(sorted []time.Duration, rank int) time.Duration {
+	if len(sorted) == 0 {
+		return 0
+	}
+	index := (len(sorted)*rank + 99) / 100
+	return sorted[max(index, 1)-1]
+}
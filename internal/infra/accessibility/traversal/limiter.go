@@ -0,0 +1,112 @@
+package traversal
+
+import "sync"
+
+// Limiter caps the number of concurrent holders per key.
+// The accessibility layer keys it by process ID: an application answers accessibility
+// requests serially on its main thread, so extra in-flight requests only add contention.
+// Only keys with holders or a limit of their own are remembered, so keys of processes that
+// are gone do not accumulate.
+type Limiter struct {
+	limit int
+	mu    sync.Mutex
+	freed *sync.Cond
+	slots map[int]*keySlots
+}
+
+// keySlots tracks the holders of one key.
+type keySlots struct {
+	limit int
+	inUse int
+}
+
+// NewLimiter creates a limiter allowing limit concurrent holders per key by default.
+// A non-positive limit disables limiting.
+func NewLimiter(limit int) *Limiter {
+	limiter := &Limiter{
+		limit: limit,
+		slots: make(map[int]*keySlots),
+	}
+	limiter.freed = sync.NewCond(&limiter.mu)
+	return limiter
+}
+
+// Acquire blocks until a slot for key is free and returns the function releasing it.
+func (l *Limiter) Acquire(key int) func() {
+	if l.limit <= 0 {
+		return func() {}
+	}
+
+	l.mu.Lock()
+	slots := l.slotsLocked(key)
+	for slots.inUse >= slots.limit {
+		l.freed.Wait()
+		// The slots may have been forgotten and recreated while waiting
+		slots = l.slotsLocked(key)
+	}
+	slots.inUse++
+	l.mu.Unlock()
+
+	return func() {
+		l.mu.Lock()
+		slots.inUse--
+		l.pruneLocked(key, slots)
+		l.mu.Unlock()
+		l.freed.Broadcast()
+	}
+}
+
+// SetLimit changes the number of concurrent holders allowed for key; a non-positive limit
+// restores the default and forgets key once it has no holders. Holders beyond a lowered
+// limit keep their slots until they release them.
+func (l *Limiter) SetLimit(key, limit int) {
+	if l.limit <= 0 {
+		return
+	}
+	if limit <= 0 {
+		limit = l.limit
+	}
+
+	l.mu.Lock()
+	slots := l.slotsLocked(key)
+	slots.limit = limit
+	l.pruneLocked(key, slots)
+	l.mu.Unlock()
+	l.freed.Broadcast()
+}
+
+// Limit returns the number of concurrent holders allowed for key.
+func (l *Limiter) Limit(key int) int {
+	l.mu.Lock()
+	defer l.mu.Unlock()
+
+	if slots, ok := l.slots[key]; ok {
+		return slots.limit
+	}
+	return l.limit
+}
+
+// Len returns the number of keys the limiter remembers.
+func (l *Limiter) Len() int {
+	l.mu.Lock()
+	defer l.mu.Unlock()
+	return len(l.slots)
+}
+
+// pruneLocked forgets key when slots are still its slots and have no holders and the default
+// limit.
+func (l *Limiter) pruneLocked(key int, slots *keySlots) {
+	if l.slots[key] == slots && slots.inUse == 0 && slots.limit == l.limit {
+		delete(l.slots, key)
+	}
+}
+
+// slotsLocked returns the slots of key, creating them with the default limit.
+func (l *Limiter) slotsLocked(key int) *keySlots {
+	slots, ok := l.slots[key]
+	if !ok {
+		slots = &keySlots{limit: l.limit}
+		l.slots[key] = slots
+	}
+	return slots
+}
@@ -0,0 +1,73 @@
+package traversal
+
+import (
+	"runtime"
+	"sync"
+	"testing"
+)
+
+func TestLimiterForgetsIdleKeys(t *testing.T) {
+	limiter := NewLimiter(2)
+
+	for pid := range 100 {
+		release := limiter.Acquire(pid)
+		release()
+	}
+	if limiter.Len() != 0 {
+		t.Errorf("Len() = %d after every slot was released, want 0", limiter.Len())
+	}
+
+	limiter.SetLimit(7, 4)
+	limiter.Acquire(7)()
+	if limiter.Limit(7) != 4 || limiter.Len() != 1 {
+		t.Errorf("Limit(7) = %d, Len() = %d; want a remembered limit of 4",
+			limiter.Limit(7), limiter.Len())
+	}
+
+	release := limiter.Acquire(7)
+	limiter.SetLimit(7, 0)
+	if limiter.Len() != 1 {
+		t.Errorf("Len() = %d while 7 has a holder, want 1", limiter.Len())
+	}
+	release()
+	if limiter.Len() != 0 {
+		t.Errorf("Len() = %d after 7 was reset and released, want 0", limiter.Len())
+	}
+}
+
+func TestLimiterNeverExceedsTheLimit(t *testing.T) {
+	const limit = 1
+	limiter := NewLimiter(limit)
+
+	var mu sync.Mutex
+	holders, peak := 0, 0
+	var wg sync.WaitGroup
+	for range 16 {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for range 200 {
+				release := limiter.Acquire(1)
+				mu.Lock()
+				holders++
+				peak = max(peak, holders)
+				mu.Unlock()
+
+				runtime.Gosched()
+
+				mu.Lock()
+				holders--
+				mu.Unlock()
+				release()
+			}
+		}()
+	}
+	wg.Wait()
+
+	if peak > limit {
+		t.Errorf("peak of %d concurrent holders, want at most %d", peak, limit)
+	}
+	if limiter.Len() != 0 {
+		t.Errorf("Len() = %d after every slot was released, want 0", limiter.Len())
+	}
+}
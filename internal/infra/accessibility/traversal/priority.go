@@ -0,0 +1,138 @@
+package traversal
+
+import (
+	"container/heap"
+	"context"
+	"runtime"
+	"sync"
+)
+
+// PriorityTask is a unit of work for a PriorityQueue. It may push further tasks.
+type PriorityTask func(queue *PriorityQueue)
+
+// PriorityQueue runs tasks on a fixed pool of workers, always starting the pending task with
+// the lowest priority value next. Tasks of equal priority run in the order they were pushed.
+// Unlike Scheduler it can be cancelled: once its context is done, queued tasks are dropped
+// and only the tasks already running finish.
+type PriorityQueue struct {
+	workers int
+
+	mu      sync.Mutex
+	wake    *sync.Cond
+	tasks   taskHeap
+	running int
+	pushed  uint64
+	stopped bool
+}
+
+// NewPriorityQueue creates a queue with the given number of workers.
+// A non-positive count uses GOMAXPROCS.
+func NewPriorityQueue(workers int) *PriorityQueue {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	queue := &PriorityQueue{workers: workers}
+	queue.wake = sync.NewCond(&queue.mu)
+	return queue
+}
+
+// Push queues a task. It is safe to call from running tasks.
+func (q *PriorityQueue) Push(priority int64, task PriorityTask) {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+
+	if q.stopped {
+		return
+	}
+	heap.Push(&q.tasks, queuedTask{priority: priority, sequence: q.pushed, run: task})
+	q.pushed++
+	q.wake.Signal()
+}
+
+// Run executes the queued tasks and every task they push, returning once none are left or
+// ctx is done. In the latter case it still waits for running tasks and returns ctx.Err().
+func (q *PriorityQueue) Run(ctx context.Context) error {
+	stop := context.AfterFunc(ctx, func() {
+		q.mu.Lock()
+		q.stopped = true
+		q.tasks = q.tasks[:0]
+		q.mu.Unlock()
+		q.wake.Broadcast()
+	})
+	defer stop()
+
+	var waitGroup sync.WaitGroup
+	waitGroup.Add(q.workers)
+	for range q.workers {
+		go func() {
+			defer waitGroup.Done()
+			q.work()
+		}()
+	}
+	waitGroup.Wait()
+
+	return ctx.Err()
+}
+
+// work runs tasks until the queue drains or is stopped.
+func (q *PriorityQueue) work() {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+
+	for {
+		for len(q.tasks) == 0 && q.running > 0 && !q.stopped {
+			q.wake.Wait()
+		}
+		if len(q.tasks) == 0 || q.stopped {
+			// Nothing left and nothing running that could push more
+			q.wake.Broadcast()
+			return
+		}
+
+		task, _ := heap.Pop(&q.tasks).(queuedTask)
+		q.running++
+		q.mu.Unlock()
+		task.run(q)
+		q.mu.Lock()
+		q.running--
+
+		if len(q.tasks) == 0 && q.running == 0 {
+			q.wake.Broadcast()
+		}
+	}
+}
+
+// queuedTask is a pending task with its ordering keys.
+type queuedTask struct {
+	priority int64
+	sequence uint64
+	run      PriorityTask
+}
+
+// taskHeap is a min-heap of queued tasks ordered by priority, then push order.
+type taskHeap []queuedTask
+
+func (h taskHeap) Len() int { return len(h) }
+
+func (h taskHeap) Less(i, j int) bool {
+	if h[i].priority != h[j].priority {
+		return h[i].priority < h[j].priority
+	}
+	return h[i].sequence < h[j].sequence
+}
+
+func (h taskHeap) Swap(i, j int) { h[i], h[j] = h[j], h[i] }
+
+func (h *taskHeap) Push(value any) {
+	task, _ := value.(queuedTask)
+	*h = append(*h, task)
+}
+
+func (h *taskHeap) Pop() any {
+	old := *h
+	last := len(old) - 1
+	task := old[last]
+	old[last] = queuedTask{}
+	*h = old[:last]
+	return task
+}
@@ -0,0 +1,185 @@
+package traversal
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+)
+
+// Task is a unit of work. It may spawn further tasks through the worker running it.
+type Task func(worker *Worker)
+
+// Scheduler executes a task graph on a fixed pool of work-stealing workers.
+type Scheduler struct {
+	workers int
+}
+
+// NewScheduler creates a scheduler with the given number of workers.
+// A non-positive count uses GOMAXPROCS; a count of 1 runs every task on the caller's goroutine.
+func NewScheduler(workers int) *Scheduler {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	return &Scheduler{workers: workers}
+}
+
+// Workers returns the size of the worker pool.
+func (s *Scheduler) Workers() int {
+	return s.workers
+}
+
+// Run executes root and every task spawned from it, returning once all of them finished.
+func (s *Scheduler) Run(root Task) {
+	if s.workers == 1 {
+		s.runInline(root)
+		return
+	}
+
+	run := &execution{
+		deques: make([]deque, s.workers),
+		wake:   make(chan struct{}, s.workers),
+		done:   make(chan struct{}),
+	}
+	run.pending.Store(1)
+	run.deques[0].push(root)
+
+	var waitGroup sync.WaitGroup
+	waitGroup.Add(s.workers)
+	for id := range s.workers {
+		go func() {
+			defer waitGroup.Done()
+			run.work(&Worker{id: id, run: run})
+		}()
+	}
+	waitGroup.Wait()
+}
+
+// runInline executes the task graph depth-first on the calling goroutine.
+func (s *Scheduler) runInline(root Task) {
+	run := &execution{deques: make([]deque, 1)}
+	worker := &Worker{id: 0, run: run}
+
+	run.deques[0].push(root)
+	for task := run.deques[0].pop(); task != nil; task = run.deques[0].pop() {
+		task(worker)
+	}
+}
+
+// Worker is the handle a running task uses to spawn more work.
+type Worker struct {
+	id  int
+	run *execution
+}
+
+// ID returns the index of the worker within its scheduler.
+func (w *Worker) ID() int {
+	return w.id
+}
+
+// Spawn queues a task on this worker's deque, where idle workers may steal it.
+func (w *Worker) Spawn(task Task) {
+	run := w.run
+	run.pending.Add(1)
+	run.deques[w.id].push(task)
+
+	if run.wake != nil {
+		select {
+		case run.wake <- struct{}{}:
+		default:
+		}
+	}
+}
+
+// execution is the state shared by the workers of one Run.
+type execution struct {
+	deques  []deque
+	pending atomic.Int64
+	wake    chan struct{}
+	done    chan struct{}
+}
+
+// work runs tasks until the whole graph has completed.
+func (e *execution) work(worker *Worker) {
+	for {
+		task := e.next(worker.id)
+		if task != nil {
+			task(worker)
+			if e.pending.Add(-1) == 0 {
+				close(e.done)
+			}
+			continue
+		}
+
+		select {
+		case <-e.done:
+			return
+		case <-e.wake:
+		}
+	}
+}
+
+// next pops local work first and otherwise steals from the other workers in turn.
+func (e *execution) next(id int) Task {
+	if task := e.deques[id].pop(); task != nil {
+		return task
+	}
+
+	for offset := 1; offset < len(e.deques); offset++ {
+		victim := (id + offset) % len(e.deques)
+		if task := e.deques[victim].steal(); task != nil {
+			return task
+		}
+	}
+
+	return nil
+}
+
+// deque holds one worker's tasks. The owner uses the bottom, thieves the top.
+type deque struct {
+	mu    sync.Mutex
+	tasks []Task
+	head  int
+}
+
+func (d *deque) push(task Task) {
+	d.mu.Lock()
+	d.tasks = append(d.tasks, task)
+	d.mu.Unlock()
+}
+
+func (d *deque) pop() Task {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+
+	if len(d.tasks) == d.head {
+		return nil
+	}
+	last := len(d.tasks) - 1
+	task := d.tasks[last]
+	d.tasks[last] = nil
+	d.tasks = d.tasks[:last]
+	d.reset()
+	return task
+}
+
+func (d *deque) steal() Task {
+	d.mu.Lock()
+	defer d.mu.Unlock()
+
+	if len(d.tasks) == d.head {
+		return nil
+	}
+	task := d.tasks[d.head]
+	d.tasks[d.head] = nil
+	d.head++
+	d.reset()
+	return task
+}
+
+// reset reclaims the slice once it has been drained from both ends.
+func (d *deque) reset() {
+	if d.head == len(d.tasks) {
+		d.tasks = d.tasks[:0]
+		d.head = 0
+	}
+}
@@ -1,26 +1,27 @@
 package accessibility
 
-/*
-#cgo CFLAGS: -x objective-c
-#include "../bridge/accessibility.h"
-#include <stdlib.h>
-
-*/
-import "C"
-
 import (
 	"errors"
 	"image"
-	"sync"
+	"runtime"
+	"sync/atomic"
 	"time"
 
+	"github.com/y3owk1n/neru/internal/infra/accessibility/pruning"
+	"github.com/y3owk1n/neru/internal/infra/accessibility/traversal"
 	"github.com/y3owk1n/neru/internal/infra/logger"
 	"go.uber.org/zap"
 )
 
+// maxRequestsPerApp caps in-flight accessibility requests to a single process across all
+// concurrent walks; one extra slot overlaps Go-side processing with the app's reply.
+const maxRequestsPerApp = 2
+
 var (
 	treeLogger = logger.Get()
 
+	appLimiter = traversal.NewLimiter(maxRequestsPerApp)
+
 	// Pre-allocated common errors.
 	errRootElementNil = errors.New("root element is nil")
 )
@@ -31,6 +32,9 @@ type TreeNode struct {
 	Info     *ElementInfo
 	Children []*TreeNode
 	Parent   *TreeNode
+	// Signature identifies a clickable node across walks by its role path and frame in the
+	// window; it is zero when the walk did not sign it. See SetClickSignatures.
+	Signature pruning.Signature
 }
 
 // TreeOptions configures accessibility tree traversal behavior and filtering.
@@ -38,18 +42,34 @@ type TreeOptions struct {
 	FilterFunc         func(*ElementInfo) bool
 	IncludeOutOfBounds bool
 	Cache              *InfoCache
-	ParallelThreshold  int
-	MaxParallelDepth   int
+	// Workers bounds the goroutines walking the tree; 0 uses GOMAXPROCS, 1 walks sequentially.
+	Workers int
+	// MaxDepth stops the walk below the given depth, counting the window's children as depth
+	// 1; 0 walks the whole tree.
+	MaxDepth int
+
+	// skips applies and learns the subtrees of the walked application that are not worth
+	// enumerating; nil walks everything.
+	skips *subtreeSkips
+	// walk measures the walk for traversal tuning; nil measures nothing.
+	walk *walkStats
+	// scope owns the elements the walk wraps; nil leaves them to the caller.
+	scope *Scope
+	// found receives every clickable node below the root as the walk attaches it, together
+	// with the node's branch; nil reports nothing.
+	found func(node *TreeNode, branch walkBranch)
 }
 
 // DefaultTreeOptions returns the default configuration for accessibility tree traversal.
+// The walk's elements belong to the scope active when it is called.
 func DefaultTreeOptions() TreeOptions {
 	return TreeOptions{
 		FilterFunc:         nil,
 		IncludeOutOfBounds: false,
 		Cache:              NewInfoCache(5 * time.Second),
-		ParallelThreshold:  8, // Only parallelize if there are more than 8 elements
-		MaxParallelDepth:   4, // Don't parallelize deeper than 4 levels
+		Workers:            0,
+		MaxDepth:           0,
+		scope:              activeScope.Load(),
 	}
 }
 
@@ -60,288 +80,340 @@ func BuildTree(root *Element, opts TreeOptions) (*TreeNode, error) {
 		return nil, errRootElementNil
 	}
 
-	// Try to get from cache first
-	info := opts.Cache.Get(root)
-	if info == nil {
-		var err error
-		info, err = root.GetInfo()
-		if err != nil {
-			logger.Warn("Failed to get root element info", zap.Error(err))
-			return nil, err
-		}
-		opts.Cache.Set(root, info)
+	release := opts.scope.hold()
+	defer release()
+
+	info, err := rootInfo(root, opts.Cache)
+	if err != nil {
+		return nil, err
 	}
 
 	logger.Debug("Building tree from root element",
 		zap.String("role", info.Role),
-		zap.String("title", info.Title),
 		zap.Int("pid", info.PID))
 
-	// Calculate window bounds for spatial filtering
-	windowBounds := rectFromInfo(info)
-
 	node := &TreeNode{
 		Element: root,
 		Info:    info,
 	}
 
-	buildTreeRecursive(node, 1, opts, windowBounds)
+	// Process-wide counter; a close approximation of this traversal's bridge crossings
+	cgoCallsBefore := runtime.NumCgoCall()
+
+	buildTreeRecursive(node, 1, opts, rootBranch(info))
+	opts.walk.finish()
 
 	logger.Debug("Tree building completed",
 		zap.String("root_role", info.Role),
-		zap.String("root_title", info.Title))
+		zap.Int64("cgo_calls", runtime.NumCgoCall()-cgoCallsBefore))
 
 	return node, nil
 }
 
-// Roles that typically don't contain interactive elements.
-var nonInteractiveRoles = map[string]bool{
-	"AXStaticText": true,
-	"AXImage":      true,
-	"AXHeading":    true,
+// rootInfo returns the info of a traversal root, preferring the cache.
+func rootInfo(root *Element, cache *InfoCache) (*ElementInfo, error) {
+	// Try to get from cache first
+	info := cache.Get(root)
+	if info == nil {
+		var err error
+		info, err = root.GetInfo()
+		if err != nil {
+			logger.Warn("Failed to get root element info", zap.Error(err))
+			return nil, err
+		}
+		cache.Set(root, info)
+	}
+	return info, nil
 }
 
+// Roles that typically don't contain interactive elements.
+var nonInteractiveRoles = NewRoleSet(
+	"AXStaticText",
+	"AXImage",
+	"AXHeading",
+)
+
+// scrollBarRole is the role whose value changes when a scroll area scrolls.
+var scrollBarRole = InternRole("AXScrollBar")
+
+// Roles that clip their content to their own frame.
+var clippingRoles = NewRoleSet(
+	"AXScrollArea",
+	"AXSplitGroup",
+	"AXWebArea",
+)
+
 // Roles that are themselves interactive (leaf nodes).
-var interactiveLeafRoles = map[string]bool{
-	"AXButton":             true,
-	"AXComboBox":           true,
-	"AXCheckBox":           true,
-	"AXRadioButton":        true,
-	"AXLink":               true,
-	"AXPopUpButton":        true,
-	"AXTextField":          true,
-	"AXSlider":             true,
-	"AXTabButton":          true,
-	"AXSwitch":             true,
-	"AXDisclosureTriangle": true,
-	"AXTextArea":           true,
-	"AXMenuButton":         true,
-	"AXMenuItem":           true,
-}
+var interactiveLeafRoles = NewRoleSet(
+	"AXButton",
+	"AXComboBox",
+	"AXCheckBox",
+	"AXRadioButton",
+	"AXLink",
+	"AXPopUpButton",
+	"AXTextField",
+	"AXSlider",
+	"AXTabButton",
+	"AXSwitch",
+	"AXDisclosureTriangle",
+	"AXTextArea",
+	"AXMenuButton",
+	"AXMenuItem",
+)
 
+// buildTreeRecursive walks the subtree below parent, whose children start at depth, on the
+// scheduler configured in opts. branch is parent's position in the walk.
+// Child order always follows the accessibility order, independent of how work is
+// distributed across workers.
 func buildTreeRecursive(
 	parent *TreeNode,
 	depth int,
 	opts TreeOptions,
-	windowBounds image.Rectangle,
+	branch walkBranch,
 ) {
-	// Early exit for roles that can't have interactive children
-	if nonInteractiveRoles[parent.Info.Role] {
-		logger.Debug("Skipping non-interactive role",
-			zap.String("role", parent.Info.Role),
-			zap.Int("depth", depth))
-		return
-	}
+	traversal.NewScheduler(opts.Workers).Run(func(worker *traversal.Worker) {
+		expandNode(worker, parent, depth, opts, branch)
+	})
+}
 
-	// Don't traverse deeper into interactive leaf elements
-	if interactiveLeafRoles[parent.Info.Role] {
-		logger.Debug("Stopping at interactive leaf role",
-			zap.String("role", parent.Info.Role),
-			zap.Int("depth", depth))
+// expandNode resolves the children of parent and spawns a task for each included child.
+// Children are attached in order before any of them is expanded, so tasks only ever write
+// to the node they own.
+func expandNode(
+	worker *traversal.Worker,
+	parent *TreeNode,
+	depth int,
+	opts TreeOptions,
+	branch walkBranch,
+) {
+	children, infos, validCount := resolveChildren(parent.Element, parent.Info, depth, opts, branch)
+	if validCount == 0 {
 		return
 	}
 
-	children, err := parent.Element.GetChildren()
-	if err != nil || len(children) == 0 {
-		if err != nil {
-			logger.Debug("No children found due to error",
-				zap.String("role", parent.Info.Role),
-				zap.Error(err),
-				zap.Int("depth", depth))
-		} else {
-			logger.Debug("No children found",
-				zap.String("role", parent.Info.Role),
-				zap.Int("depth", depth))
+	// One backing array for all child nodes of this parent
+	nodes := make([]TreeNode, validCount)
+	parent.Children = make([]*TreeNode, 0, validCount)
+	for index, child := range children {
+		info := infos[index]
+		if info == nil {
+			continue
 		}
-		return
+
+		childNode := &nodes[len(parent.Children)]
+		childNode.Element = child
+		childNode.Info = info
+		childNode.Parent = parent
+		childNode.Children = []*TreeNode{}
+		parent.Children = append(parent.Children, childNode)
 	}
 
-	// Decide whether to parallelize
-	shouldParallelize := depth <= opts.MaxParallelDepth &&
-		len(children) >= opts.ParallelThreshold
+	if opts.found != nil {
+		for _, childNode := range parent.Children {
+			if childNode.Element.isClickable(childNode.Info) {
+				opts.found(childNode, branch.child(childNode.Info))
+			}
+		}
+	}
 
 	logger.Debug("Processing children",
 		zap.String("parent_role", parent.Info.Role),
 		zap.Int("child_count", len(children)),
+		zap.Int("included_children", validCount),
 		zap.Int("depth", depth),
-		zap.Bool("parallel", shouldParallelize))
+		zap.Int("worker", worker.ID()))
 
-	if shouldParallelize {
-		buildChildrenParallel(parent, children, depth, opts, windowBounds)
-	} else {
-		buildChildrenSequential(parent, children, depth, opts, windowBounds)
+	for _, childNode := range parent.Children {
+		worker.Spawn(func(worker *traversal.Worker) {
+			expandNode(worker, childNode, depth+1, opts, branch.child(childNode.Info))
+		})
 	}
 }
 
-func buildChildrenSequential(
-	parent *TreeNode,
-	children []*Element,
+// resolveChildren fetches the children of an element together with their info. depth is the
+// depth of the children, 1 for those of the window. branch is the element's position in the
+// walk; children entirely outside its clip are filtered out before they are expanded. The
+// returned infos are index-aligned with children and nil for children that are filtered out;
+// validCount is the number of included children.
+func resolveChildren(
+	parent *Element,
+	parentInfo *ElementInfo,
 	depth int,
 	opts TreeOptions,
-	windowBounds image.Rectangle,
-) {
-	// First pass: count valid children and collect their info
-	type childData struct {
-		element *Element
-		info    *ElementInfo
+	branch walkBranch,
+) ([]*Element, []*ElementInfo, int) {
+	// Early exit for roles that can't have interactive children
+	if nonInteractiveRoles.Has(parentInfo.RoleID) {
+		logger.Debug("Skipping non-interactive role",
+			zap.String("role", parentInfo.Role),
+			zap.Int("depth", depth))
+		return nil, nil, 0
 	}
-	validChildren := make([]childData, 0, len(children))
 
-	for _, child := range children {
-		// Try cache first
-		info := opts.Cache.Get(child)
-		if info == nil {
-			var err error
-			info, err = child.GetInfo()
-			if err != nil {
-				logger.Debug("Failed to get child element info", zap.Error(err))
-				continue
-			}
-			opts.Cache.Set(child, info)
-		}
+	// Don't traverse deeper into interactive leaf elements
+	if interactiveLeafRoles.Has(parentInfo.RoleID) {
+		logger.Debug("Stopping at interactive leaf role",
+			zap.String("role", parentInfo.Role),
+			zap.Int("depth", depth))
+		return nil, nil, 0
+	}
 
-		if !shouldIncludeElement(info, opts, windowBounds) {
-			logger.Debug("Skipping child element (filtered out)",
-				zap.String("role", info.Role),
-				zap.String("title", info.Title))
-			continue
-		}
+	// The window itself is never skipped, only subtrees learned to hold nothing clickable
+	if depth > 1 && !branch.content && opts.skips.has(branch.signature(parentInfo)) {
+		logger.Debug("Skipping learned barren subtree",
+			zap.String("role", parentInfo.Role),
+			zap.Int("depth", depth))
+		return nil, nil, 0
+	}
 
-		validChildren = append(validChildren, childData{element: child, info: info})
+	if (opts.MaxDepth > 0 && depth > opts.MaxDepth) || opts.walk.stops(depth) {
+		return nil, nil, 0
+	}
+	opts.walk.expand(depth)
+
+	// Children and their info arrive together, so one bridge call covers this level
+	release := appLimiter.Acquire(parent.key.pid)
+	start := time.Now()
+	children, infos, timedOut := parent.childrenWithInfo(parentInfo.RoleID)
+	callLatency.Record(parent.key.pid, time.Since(start))
+	release()
+	opts.scope.own(children)
+
+	if timedOut {
+		opts.walk.timedOut(parent.key.pid)
 	}
 
-	// Pre-allocate with exact capacity
-	parent.Children = make([]*TreeNode, 0, len(validChildren))
+	if len(children) == 0 {
+		logger.Debug("No children found",
+			zap.String("role", parentInfo.Role),
+			zap.Int("depth", depth))
+		return nil, nil, 0
+	}
+	cacheChildInfos(children, infos, opts.Cache)
 
-	// Second pass: create nodes and recurse
-	for _, data := range validChildren {
-		childNode := &TreeNode{
-			Element:  data.element,
-			Info:     data.info,
-			Parent:   parent,
-			Children: []*TreeNode{},
+	validCount := 0
+	for index, info := range infos {
+		if info == nil {
+			continue
 		}
-
-		parent.Children = append(parent.Children, childNode)
-		buildTreeRecursive(childNode, depth+1, opts, windowBounds)
+		if !shouldIncludeElement(info, opts, branch.clip) {
+			logger.Debug("Skipping child element (filtered out)",
+				zap.String("role", info.Role))
+			infos[index] = nil
+			continue
+		}
+		validCount++
 	}
 
-	logger.Debug("Sequential child processing completed",
-		zap.String("parent_role", parent.Info.Role),
-		zap.Int("processed_children", len(validChildren)),
-		zap.Int("total_children", len(children)))
+	return children, infos, validCount
 }
 
-func buildChildrenParallel(
-	parent *TreeNode,
-	children []*Element,
-	depth int,
-	opts TreeOptions,
-	windowBounds image.Rectangle,
-) {
-	logger.Debug("Starting parallel child processing",
-		zap.String("parent_role", parent.Info.Role),
-		zap.Int("child_count", len(children)),
-		zap.Int("depth", depth))
-
-	// Pre-allocate result slice with exact capacity
-	type childResult struct {
-		node  *TreeNode
-		index int
+// cacheChildInfos stores the fetched infos of children in cache, so later activations and
+// lookups are served from it, and fills in from cache the infos that could not be fetched.
+// Children that stay without info are skipped by the walk. A nil cache does nothing.
+func cacheChildInfos(children []*Element, infos []*ElementInfo, cache *InfoCache) {
+	if cache == nil {
+		return
 	}
+	cache.SetMany(children, infos)
 
-	// Use buffered channel sized to number of children
-	results := make(chan childResult, len(children))
-	var waitGroup sync.WaitGroup
-
-	// Process children in parallel
-	for index, child := range children {
-		waitGroup.Add(1)
-		go func(idx int, elem *Element) {
-			defer waitGroup.Done()
-
-			// Try cache first (cache must be thread-safe!)
-			info := opts.Cache.Get(elem)
-			if info == nil {
-				var err error
-				info, err = elem.GetInfo()
-				if err != nil {
-					logger.Debug(
-						"Failed to get child element info in parallel processing",
-						zap.Error(err),
-					)
-					return
-				}
-				opts.Cache.Set(elem, info)
-			}
-
-			if !shouldIncludeElement(info, opts, windowBounds) {
-				logger.Debug("Skipping child element in parallel processing (filtered out)",
-					zap.String("role", info.Role),
-					zap.String("title", info.Title))
-				return
-			}
+	var failed []*Element
+	var failedIndices []int
+	for index, info := range infos {
+		if info == nil {
+			failed = append(failed, children[index])
+			failedIndices = append(failedIndices, index)
+		}
+	}
+	if len(failed) == 0 {
+		return
+	}
+	for position, info := range cache.GetMany(failed) {
+		infos[failedIndices[position]] = info
+	}
+}
 
-			childNode := &TreeNode{
-				Element:  elem,
-				Info:     info,
-				Parent:   parent,
-				Children: []*TreeNode{},
-			}
+// walkBranch is what a walk carries from a node down to its children.
+type walkBranch struct {
+	// clip is the visible region for the node's children.
+	clip image.Rectangle
+	// path is the role path from the window root to the node.
+	path uint64
+	// origin is the window origin that subtree frames are measured from.
+	origin image.Point
+	// content is set for a content host and everything inside it, whose subtrees change
+	// with what the host shows while their signatures stay the same.
+	content bool
+}
 
-			// Recursively build (this may spawn more goroutines at deeper levels)
-			buildTreeRecursive(childNode, depth+1, opts, windowBounds)
+// rootBranch returns the branch of a walk's root. Children are clipped to the root's frame,
+// and further to every clipping container below it.
+func rootBranch(info *ElementInfo) walkBranch {
+	return walkBranch{
+		clip:    clipFor(rectFromInfo(info), info),
+		path:    pruning.Path(0, info.Role),
+		origin:  info.Position,
+		content: contentHostRoles.Has(info.RoleID),
+	}
+}
 
-			results <- childResult{node: childNode, index: idx}
-		}(index, child)
+// child returns the branch of a child of the node, given the child's info.
+func (b walkBranch) child(info *ElementInfo) walkBranch {
+	return walkBranch{
+		clip:    clipFor(b.clip, info),
+		path:    pruning.Path(b.path, info.Role),
+		origin:  b.origin,
+		content: b.content || contentHostRoles.Has(info.RoleID),
 	}
+}
 
-	// Close results channel when all goroutines complete
-	go func() {
-		waitGroup.Wait()
-		close(results)
-	}()
+// signature identifies the subtree rooted at the node whose info is given.
+func (b walkBranch) signature(info *ElementInfo) pruning.Signature {
+	return pruning.Sign(b.path, rectFromInfo(info).Sub(b.origin))
+}
 
-	// Pre-allocate collection slice with exact capacity
-	collected := make([]*TreeNode, len(children))
-	validCount := 0
+// signClickables makes walks that learn no pruning follow branches to sign their clickable
+// nodes as well.
+var signClickables atomic.Bool
 
-	for result := range results {
-		collected[result.index] = result.node
-		validCount++
-	}
+// SetClickSignatures makes every walk sign the clickable nodes it returns, so callers can
+// recognize an element across activations. Streaming walks and walks learning pruning sign
+// them regardless.
+func SetClickSignatures(enabled bool) {
+	signClickables.Store(enabled)
+}
 
-	// Pre-allocate final children slice with exact valid count
-	parent.Children = make([]*TreeNode, 0, validCount)
-	for _, node := range collected {
-		if node != nil {
-			parent.Children = append(parent.Children, node)
-		}
+// clipFor returns the visible region for the children of a node, given the region that
+// applies to the node itself. Scroll areas, split groups and web areas only show the part
+// of their content inside their frame, so they narrow the region; other roles pass it on.
+func clipFor(clip image.Rectangle, info *ElementInfo) image.Rectangle {
+	if !clippingRoles.Has(info.RoleID) {
+		return clip
 	}
 
-	logger.Debug("Parallel child processing completed",
-		zap.String("parent_role", parent.Info.Role),
-		zap.Int("processed_children", validCount),
-		zap.Int("total_children", len(children)))
+	// Containers reporting no frame are common in broken hierarchies; don't hide their content
+	frame := rectFromInfo(info)
+	if frame.Empty() {
+		return clip
+	}
+	return clip.Intersect(frame)
 }
 
 // shouldIncludeElement combines all filtering logic into one function.
-
-// shouldIncludeElement combines all filtering logic into one function.
-func shouldIncludeElement(info *ElementInfo, opts TreeOptions, windowBounds image.Rectangle) bool {
+func shouldIncludeElement(info *ElementInfo, opts TreeOptions, clip image.Rectangle) bool {
 	if !opts.IncludeOutOfBounds {
 		elementRect := rectFromInfo(info)
 
 		// Filter out zero-sized interactive elements (they're broken/invalid)
 		if elementRect.Dx() == 0 || elementRect.Dy() == 0 {
-			if interactiveLeafRoles[info.Role] {
+			if interactiveLeafRoles.Has(info.RoleID) {
 				return false
 			}
 		}
 
-		// For non-zero sized elements, check if they overlap with window bounds
+		// For non-zero sized elements, check if they overlap the visible region
 		if elementRect.Dx() > 0 && elementRect.Dy() > 0 {
-			if !elementRect.Overlaps(windowBounds) {
+			if !elementRect.Overlaps(clip) {
 				return false
 			}
 		}
@@ -358,7 +430,7 @@ func shouldIncludeElement(info *ElementInfo, opts TreeOptions, windowBounds imag
 func (n *TreeNode) FindClickableElements() []*TreeNode {
 	var result []*TreeNode
 	n.walkTree(func(node *TreeNode) bool {
-		if node.Element.IsClickable() {
+		if node.Element.isClickable(node.Info) {
 			result = append(result, node)
 		}
 		return true
@@ -366,6 +438,39 @@ func (n *TreeNode) FindClickableElements() []*TreeNode {
 	return result
 }
 
+// findClickable finds all clickable elements in the tree, which must start at the window,
+// and reports what each subtree contained to skips. A nil skips learns nothing. Clickable
+// nodes are signed whenever the branches are followed.
+func (n *TreeNode) findClickable(skips *subtreeSkips) []*TreeNode {
+	if skips == nil && !signClickables.Load() {
+		return n.FindClickableElements()
+	}
+
+	var result []*TreeNode
+	var visit func(node *TreeNode, branch walkBranch) (int, int, bool)
+	visit = func(node *TreeNode, branch walkBranch) (int, int, bool) {
+		nodes, clickables, content := 1, 0, branch.content
+		if node.Element.isClickable(node.Info) {
+			node.Signature = branch.signature(node.Info)
+			result = append(result, node)
+			clickables++
+		}
+		for _, child := range node.Children {
+			childNodes, childClickables, childContent := visit(child, branch.child(child.Info))
+			nodes += childNodes
+			clickables += childClickables
+			content = content || childContent
+		}
+		if !content {
+			skips.observe(branch.signature(node.Info), nodes, clickables)
+		}
+		return nodes, clickables, content
+	}
+	visit(n, rootBranch(n.Info))
+
+	return result
+}
+
 // FindScrollableElements finds all scrollable elements in the tree
 
 // walkTree walks the tree and calls the visitor function for each node.
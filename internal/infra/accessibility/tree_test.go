@@ -0,0 +1,143 @@
+package accessibility
+
+import (
+	"fmt"
+	"os"
+	"runtime"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/logger"
+)
+
+func TestMain(m *testing.M) {
+	// Walks log every level at debug; keep benchmarks from measuring the console
+	err := logger.Init("error", "", false, true, 0, 0, 0)
+	if err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+	os.Exit(m.Run())
+}
+
+// benchmarkTree is the synthetic tree the traversal benchmarks walk: about 550 elements,
+// answering every children request after 20µs like a responsive application.
+var benchmarkTree = SyntheticSpec{
+	Seed:          7,
+	PID:           42,
+	BundleID:      "com.example.synthetic",
+	FanOut:        6,
+	Depth:         5,
+	CallLatencyUs: 20,
+}
+
+// useSyntheticTree installs a synthetic provider for spec until the test ends and returns it.
+func useSyntheticTree(tb testing.TB, spec SyntheticSpec) *SyntheticProvider {
+	tb.Helper()
+
+	SetClickableRoles([]string{"AXButton", "AXLink", "AXCheckBox"})
+	provider := NewSyntheticProvider(spec)
+	SetProvider(provider)
+	tb.Cleanup(func() { SetProvider(nil) })
+	return provider
+}
+
+// newBenchmarkCache returns an info cache stopped when the test ends.
+func newBenchmarkCache(tb testing.TB) *InfoCache {
+	tb.Helper()
+
+	cache := NewInfoCache(time.Minute)
+	tb.Cleanup(cache.Stop)
+	return cache
+}
+
+// goroutinePeak samples the number of goroutines until stopped.
+type goroutinePeak struct {
+	baseline int
+	peak     int
+	stop     chan struct{}
+	done     sync.WaitGroup
+}
+
+// startGoroutinePeak starts sampling.
+func startGoroutinePeak() *goroutinePeak {
+	baseline := runtime.NumGoroutine()
+	sampler := &goroutinePeak{baseline: baseline, peak: baseline, stop: make(chan struct{})}
+	sampler.done.Add(1)
+	go func() {
+		defer sampler.done.Done()
+		for {
+			select {
+			case <-sampler.stop:
+				return
+			default:
+			}
+			sampler.peak = max(sampler.peak, runtime.NumGoroutine())
+			time.Sleep(50 * time.Microsecond)
+		}
+	}()
+	return sampler
+}
+
+// Stop ends sampling and returns the most goroutines seen beyond those alive when sampling
+// started, the sampler excluded.
+func (s *goroutinePeak) Stop() int {
+	close(s.stop)
+	s.done.Wait()
+	return max(s.peak-s.baseline-1, 0)
+}
+
+func TestBuildTreeWorkersAgree(t *testing.T) {
+	provider := useSyntheticTree(t, benchmarkTree)
+	window := provider.FrontmostWindow()
+
+	var want int
+	for _, workers := range []int{1, 2, 8} {
+		opts := TreeOptions{Cache: newBenchmarkCache(t), Workers: workers}
+
+		root, err := BuildTree(window, opts)
+		if err != nil {
+			t.Fatalf("BuildTree(workers=%d) error = %v", workers, err)
+		}
+		got := countNodes(root)
+		if want == 0 {
+			want = got
+		}
+		if got != want || got < 2 {
+			t.Errorf("BuildTree(workers=%d) walked %d nodes, want %d", workers, got, want)
+		}
+	}
+}
+
+// countNodes returns the number of nodes in the subtree of node.
+func countNodes(node *TreeNode) int {
+	count := 1
+	for _, child := range node.Children {
+		count += countNodes(child)
+	}
+	return count
+}
+
+// BenchmarkBuildTreeWorkers reports the wall time of one full walk and the most goroutines
+// alive during the walks, per worker pool size.
+func BenchmarkBuildTreeWorkers(b *testing.B) {
+	provider := useSyntheticTree(b, benchmarkTree)
+	window := provider.FrontmostWindow()
+
+	for _, workers := range []int{1, 2, 4, 8} {
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			opts := TreeOptions{Cache: newBenchmarkCache(b), Workers: workers}
+
+			sampler := startGoroutinePeak()
+			for b.Loop() {
+				opts.Cache.Clear()
+				_, err := BuildTree(window, opts)
+				if err != nil {
+					b.Fatal(err)
+				}
+			}
+			b.ReportMetric(float64(sampler.Stop()), "peak-goroutines")
+		})
+	}
+}
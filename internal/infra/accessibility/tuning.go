@@ -0,0 +1,413 @@
+package accessibility
+
+import (
+	"context"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/y3owk1n/neru/internal/infra/accessibility/traversal"
+	"github.com/y3owk1n/neru/internal/infra/logger"
+	"go.uber.org/zap"
+)
+
+// Cost model inputs. Latencies are those of one children-with-info bridge call.
+const (
+	// minTuningCalls is how many calls must be measured before an app leaves the defaults.
+	minTuningCalls = 32
+	// slowCallLatency marks apps, typically Chromium and Electron, whose replies are slow
+	// enough that overlapping more requests hides part of the round trip.
+	slowCallLatency = 2 * time.Millisecond
+	// stalledCallLatency marks apps whose tail latency shows their main thread stalling;
+	// queued requests would only wait behind the stall.
+	stalledCallLatency = 50 * time.Millisecond
+	// slowAppRequests is the in-flight request limit for slow apps.
+	slowAppRequests = 4
+	// goSideCost estimates the Go-side processing of one level: decoding, filtering, spawning.
+	goSideCost = 50 * time.Microsecond
+	// walkBudget is the projected walk time above which the depth is capped.
+	walkBudget = 2 * time.Second
+	// minTunedDepth is the shallowest depth cap the cost model chooses.
+	minTunedDepth = 16
+	// uncappedWalkInterval is how often an app under a depth cap is walked in full anyway, so
+	// the elements below the cap are found again and the cap follows the app's size.
+	uncappedWalkInterval = 5 * time.Minute
+	// maxTrackedApps bounds the processes whose walks and timeouts are remembered.
+	maxTrackedApps = 64
+
+	// defaultMessagingTimeout bounds every accessibility request; the system default is 6s.
+	defaultMessagingTimeout = time.Second
+	// minMessagingTimeout is the shortest per-app timeout, also used for quarantined apps.
+	minMessagingTimeout = 100 * time.Millisecond
+	// timeoutLatencyFactor sets an app's timeout to this multiple of its p99 latency.
+	timeoutLatencyFactor = 8
+
+	// quarantineTimeouts timeouts within quarantineWindow put an app in quarantine.
+	quarantineTimeouts = 3
+	quarantineWindow   = 30 * time.Second
+	// quarantineCooldown is how long a quarantined app is only scanned shallowly.
+	quarantineCooldown = time.Minute
+	// quarantineDepth is how deep a quarantined app is scanned.
+	quarantineDepth = 6
+)
+
+// callLatency measures the latency of traversal bridge calls per process.
+var callLatency = traversal.NewLatencyTracker()
+
+// globalTimeout bounds requests to apps that have no timeout of their own yet.
+var globalTimeout sync.Once
+
+// appStates remembers the walks and timeouts of each process.
+var appStates = struct {
+	sync.Mutex
+	byPID map[int]*appState
+}{byPID: make(map[int]*appState)}
+
+// appState is what the cost model remembers about one process.
+type appState struct {
+	walk walkRecord
+	// timeouts counts every timed-out request; recent holds the times of the latest ones.
+	timeouts uint64
+	recent   [quarantineTimeouts]time.Time
+	// quarantinedUntil is the end of the current quarantine, if any.
+	quarantinedUntil time.Time
+	// appliedTimeout is the messaging timeout last handed to the provider.
+	appliedTimeout time.Duration
+	// cappedWalks counts walks that stopped at their depth cap; capWarned is set once one
+	// was logged since the last walk in full.
+	cappedWalks uint64
+	capWarned   bool
+	// uncappedAt is when the app was last walked without a depth cap.
+	uncappedAt time.Time
+}
+
+// walkRecord is the size of one complete walk.
+type walkRecord struct {
+	nodes   int64
+	deepest int
+}
+
+// AppTuning reports the measured latency of one application and the traversal settings
+// chosen from it.
+type AppTuning struct {
+	PID      int
+	BundleID string
+	Calls    uint64
+	EWMA     time.Duration
+	P50      time.Duration
+	P90      time.Duration
+	P99      time.Duration
+	// LastNodes and LastDepth describe the last complete walk.
+	LastNodes int64
+	LastDepth int
+	// Workers, InFlight, MaxDepth and Timeout are the settings the next walk uses; a
+	// MaxDepth of 0 means unlimited.
+	Workers  int
+	InFlight int
+	MaxDepth int
+	Timeout  time.Duration
+	// Timeouts counts requests the app did not answer in time.
+	Timeouts uint64
+	// CappedWalks counts walks that stopped at their depth cap, dropping deeper elements.
+	CappedWalks uint64
+	// QuarantineLeft is the remaining quarantine, during which the app is scanned shallowly.
+	QuarantineLeft time.Duration
+}
+
+// GetAppTunings returns the tuning of every application with measured calls, by process ID.
+func GetAppTunings() []AppTuning {
+	pids := callLatency.Keys()
+	tunings := make([]AppTuning, 0, len(pids))
+	for _, pid := range pids {
+		tuning := tuningFor(pid)
+		tuning.BundleID = bundleIDForPID(pid)
+		tunings = append(tunings, tuning)
+	}
+	return tunings
+}
+
+// IsQuarantined reports whether the process timed out so often recently that it is only
+// scanned shallowly.
+func IsQuarantined(pid int) bool {
+	appStates.Lock()
+	defer appStates.Unlock()
+
+	state := appStates.byPID[pid]
+	return state != nil && time.Now().Before(state.quarantinedUntil)
+}
+
+// tuneOptions applies the tuning of the process to a walk's options, hands its messaging
+// timeout to the provider and starts measuring the walk.
+func tuneOptions(opts *TreeOptions, pid int) {
+	globalTimeout.Do(func() {
+		currentProvider().SetMessagingTimeout(0, defaultMessagingTimeout)
+	})
+
+	tuning := tuningFor(pid)
+	if tuning.MaxDepth > 0 && tuning.QuarantineLeft == 0 && claimUncappedWalk(pid) {
+		logger.Debug("Walking past the depth cap to measure the whole app",
+			zap.Int("pid", pid),
+			zap.Int("max_depth", tuning.MaxDepth))
+		tuning.MaxDepth = 0
+	}
+	appLimiter.SetLimit(pid, tuning.InFlight)
+	applyTimeout(pid, tuning.Timeout)
+	opts.Workers = tuning.Workers
+	opts.MaxDepth = tuning.MaxDepth
+	opts.walk = &walkStats{pid: pid, maxDepth: tuning.MaxDepth}
+
+	if tuning.Calls >= minTuningCalls || tuning.QuarantineLeft > 0 {
+		logger.Debug("Tuned traversal",
+			zap.Int("pid", pid),
+			zap.Duration("p50", tuning.P50),
+			zap.Duration("p99", tuning.P99),
+			zap.Int("workers", tuning.Workers),
+			zap.Int("in_flight", tuning.InFlight),
+			zap.Int("max_depth", tuning.MaxDepth),
+			zap.Duration("timeout", tuning.Timeout),
+			zap.Duration("quarantine_left", tuning.QuarantineLeft))
+	}
+}
+
+// tuningFor runs the cost model for a process.
+func tuningFor(pid int) AppTuning {
+	tuning := AppTuning{
+		PID:      pid,
+		Workers:  0,
+		InFlight: maxRequestsPerApp,
+		Timeout:  defaultMessagingTimeout,
+	}
+
+	var walk walkRecord
+	appStates.Lock()
+	if state := appStates.byPID[pid]; state != nil {
+		walk = state.walk
+		tuning.Timeouts = state.timeouts
+		tuning.CappedWalks = state.cappedWalks
+		tuning.QuarantineLeft = max(time.Until(state.quarantinedUntil), 0)
+	}
+	appStates.Unlock()
+	tuning.LastNodes = walk.nodes
+	tuning.LastDepth = walk.deepest
+
+	// A quarantined app gets one request at a time, a short timeout and a shallow scan
+	if tuning.QuarantineLeft > 0 {
+		tuning.Workers = 1
+		tuning.InFlight = 1
+		tuning.MaxDepth = quarantineDepth
+		tuning.Timeout = minMessagingTimeout
+	}
+
+	summary, ok := callLatency.Summary(pid)
+	if !ok {
+		return tuning
+	}
+	tuning.Calls = summary.Calls
+	tuning.EWMA = summary.EWMA
+	tuning.P50 = summary.P50
+	tuning.P90 = summary.P90
+	tuning.P99 = summary.P99
+	if summary.Calls < minTuningCalls || summary.P50 <= 0 || tuning.QuarantineLeft > 0 {
+		return tuning
+	}
+
+	// Generous for the app's normal replies, but far below the system default for stalls
+	tuning.Timeout = min(
+		max(timeoutLatencyFactor*summary.P99, minMessagingTimeout),
+		defaultMessagingTimeout,
+	)
+
+	switch {
+	case summary.P99 >= stalledCallLatency:
+		tuning.InFlight = 1
+	case summary.P50 >= slowCallLatency:
+		tuning.InFlight = slowAppRequests
+	}
+
+	// Enough workers to keep every request slot busy while others process their replies
+	busy := (int64(tuning.InFlight)*int64(goSideCost) + int64(summary.P50) - 1) / int64(summary.P50)
+	tuning.Workers = min(tuning.InFlight+int(busy), runtime.GOMAXPROCS(0))
+
+	// Replies are serialized per app, so a walk costs about one reply per expanded node
+	if walk.nodes > 0 && walk.deepest > minTunedDepth {
+		projected := time.Duration(walk.nodes) * summary.EWMA / time.Duration(tuning.InFlight)
+		if projected > walkBudget {
+			depth := int(int64(walk.deepest) * int64(walkBudget) / int64(projected))
+			tuning.MaxDepth = max(depth, minTunedDepth)
+		}
+	}
+
+	return tuning
+}
+
+// claimUncappedWalk reports whether the next walk of the process should ignore its depth
+// cap, at most once per uncappedWalkInterval.
+func claimUncappedWalk(pid int) bool {
+	appStates.Lock()
+	defer appStates.Unlock()
+
+	state := appStateLocked(pid)
+	if time.Since(state.uncappedAt) < uncappedWalkInterval {
+		return false
+	}
+	state.uncappedAt = time.Now()
+	return true
+}
+
+// applyTimeout hands the messaging timeout of the process to the provider when it changed.
+func applyTimeout(pid int, timeout time.Duration) {
+	appStates.Lock()
+	state := appStateLocked(pid)
+	changed := state.appliedTimeout != timeout
+	state.appliedTimeout = timeout
+	appStates.Unlock()
+
+	if changed {
+		currentProvider().SetMessagingTimeout(pid, timeout)
+	}
+}
+
+// appStateLocked returns the state of the process, creating it if needed. Callers must
+// hold the appStates lock.
+func appStateLocked(pid int) *appState {
+	state := appStates.byPID[pid]
+	if state != nil {
+		return state
+	}
+
+	if len(appStates.byPID) >= maxTrackedApps {
+		// Processes come and go; drop one that is not quarantined to make room
+		for stalePID, stale := range appStates.byPID {
+			if time.Now().After(stale.quarantinedUntil) {
+				delete(appStates.byPID, stalePID)
+				currentProvider().SetMessagingTimeout(stalePID, 0)
+				appLimiter.SetLimit(stalePID, 0)
+				break
+			}
+		}
+	}
+	state = &appState{}
+	appStates.byPID[pid] = state
+	return state
+}
+
+// recordTimeout counts a timed-out request and reports whether it put the process in
+// quarantine.
+func recordTimeout(pid int) bool {
+	appStates.Lock()
+	defer appStates.Unlock()
+
+	now := time.Now()
+	state := appStateLocked(pid)
+	state.timeouts++
+	copy(state.recent[:], state.recent[1:])
+	state.recent[len(state.recent)-1] = now
+
+	if now.Before(state.quarantinedUntil) || now.Sub(state.recent[0]) > quarantineWindow {
+		return false
+	}
+	state.quarantinedUntil = now.Add(quarantineCooldown)
+	return true
+}
+
+// walkStats measures one walk for the cost model. Methods are safe on a nil receiver.
+type walkStats struct {
+	pid      int
+	maxDepth int
+	// ctx stops background walks early; nil for walks that always complete.
+	ctx         context.Context
+	nodes       atomic.Int64
+	deepest     atomic.Int32
+	timeouts    atomic.Int32
+	quarantined atomic.Bool
+}
+
+// expand counts a node whose children are resolved at depth.
+func (w *walkStats) expand(depth int) {
+	if w == nil {
+		return
+	}
+	w.nodes.Add(1)
+	for {
+		deepest := w.deepest.Load()
+		if int32(depth) <= deepest || w.deepest.CompareAndSwap(deepest, int32(depth)) {
+			return
+		}
+	}
+}
+
+// timedOut records that a request of the walk timed out. Once the app is quarantined, the
+// rest of the walk stays shallow too.
+func (w *walkStats) timedOut(pid int) {
+	if recordTimeout(pid) {
+		logger.Warn("Application keeps timing out, scanning it shallowly",
+			zap.Int("pid", pid),
+			zap.Duration("cooldown", quarantineCooldown))
+		if w != nil {
+			w.quarantined.Store(true)
+		}
+	}
+	if w != nil {
+		w.timeouts.Add(1)
+	}
+}
+
+// stops reports whether children at depth are out of reach for the rest of the walk.
+func (w *walkStats) stops(depth int) bool {
+	return w != nil && ((w.quarantined.Load() && depth > quarantineDepth) || w.cancelled())
+}
+
+// cancelled reports whether the walk was stopped before it finished.
+func (w *walkStats) cancelled() bool {
+	return w != nil && w.ctx != nil && w.ctx.Err() != nil
+}
+
+// capped reports whether the walk reached its depth cap, so elements below it were dropped.
+func (w *walkStats) capped() bool {
+	return w != nil && w.maxDepth > 0 && int(w.deepest.Load()) >= w.maxDepth
+}
+
+// truncated reports whether the walk may have missed elements: it hit its depth cap,
+// requests timed out, the app was quarantined during the walk, or it was cancelled.
+func (w *walkStats) truncated() bool {
+	if w == nil {
+		return false
+	}
+	return w.capped() || w.timeouts.Load() > 0 || w.quarantined.Load() || w.cancelled()
+}
+
+// finish records the size of a complete walk and counts walks stopped by their depth cap.
+// Truncated walks are not recorded; the periodic walk in full measures the app again.
+func (w *walkStats) finish() {
+	if w == nil {
+		return
+	}
+
+	appStates.Lock()
+	state := appStateLocked(w.pid)
+	warn := false
+	if w.capped() {
+		state.cappedWalks++
+		warn = !state.capWarned
+		state.capWarned = true
+	}
+	if !w.truncated() {
+		state.walk = walkRecord{
+			nodes:   w.nodes.Load(),
+			deepest: int(w.deepest.Load()),
+		}
+		if w.maxDepth == 0 {
+			state.uncappedAt = time.Now()
+			state.capWarned = false
+		}
+	}
+	appStates.Unlock()
+
+	if warn {
+		logger.Warn("Walk stopped at its depth cap, deeper elements get no hints",
+			zap.Int("pid", w.pid),
+			zap.Int("max_depth", w.maxDepth),
+			zap.Duration("full_walk_every", uncappedWalkInterval))
+	}
+}
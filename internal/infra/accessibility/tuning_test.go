@@ -0,0 +1,43 @@
+package accessibility
+
+import (
+	"testing"
+	"time"
+)
+
+func TestDepthCapIsCountedAndLiftedPeriodically(t *testing.T) {
+	useSyntheticTree(t, flatTreeSpec)
+	const pid = 4242
+	t.Cleanup(func() {
+		appStates.Lock()
+		delete(appStates.byPID, pid)
+		appStates.Unlock()
+		callLatency.Forget(pid)
+	})
+
+	// A large, slow app whose projected walk is far over budget
+	for range minTuningCalls {
+		callLatency.Record(pid, 10*time.Millisecond)
+	}
+	appStates.Lock()
+	appStateLocked(pid).walk = walkRecord{nodes: 10000, deepest: 4 * minTunedDepth}
+	appStates.Unlock()
+
+	var full TreeOptions
+	tuneOptions(&full, pid)
+	if full.MaxDepth != 0 {
+		t.Fatalf("first walk: MaxDepth = %d, want a walk in full", full.MaxDepth)
+	}
+
+	var capped TreeOptions
+	tuneOptions(&capped, pid)
+	if capped.MaxDepth == 0 {
+		t.Fatal("second walk: MaxDepth = 0, want the depth cap")
+	}
+	capped.walk.expand(capped.MaxDepth)
+	capped.walk.finish()
+
+	if got := tuningFor(pid).CappedWalks; got != 1 {
+		t.Errorf("CappedWalks = %d, want 1", got)
+	}
+}
@@ -58,6 +58,14 @@ func (w *Watcher) OnScreenParametersChanged(callback func()) {
 	w.screenChangeCallbacks = append(w.screenChangeCallbacks, callback)
 }
 
+// OnLaunch registers a callback for application launch events.
+// The callback is executed when a monitored application launches.
+func (w *Watcher) OnLaunch(callback AppCallback) {
+	w.mu.Lock()
+	defer w.mu.Unlock()
+	w.launchCallbacks = append(w.launchCallbacks, callback)
+}
+
 // OnTerminate registers a callback for application termination events.
 // The callback is executed when a monitored application terminates.
 func (w *Watcher) OnTerminate(callback AppCallback) {
@@ -11,19 +11,138 @@
 #import <ApplicationServices/ApplicationServices.h>
 #import <Foundation/Foundation.h>
 
+#pragma mark - Role Table
+
+/// Accessibility roles interned by the bridge. Go seeds its role table from roleNameForID,
+/// so these IDs are identical on both sides. Append new roles before ElementRoleCount.
+typedef enum {
+    ElementRoleUnknown = 0,
+    ElementRoleApplication,
+    ElementRoleWindow,
+    ElementRoleSheet,
+    ElementRoleDrawer,
+    ElementRoleGroup,
+    ElementRoleScrollArea,
+    ElementRoleScrollBar,
+    ElementRoleSplitGroup,
+    ElementRoleSplitter,
+    ElementRoleToolbar,
+    ElementRoleTabGroup,
+    ElementRoleWebArea,
+    ElementRoleList,
+    ElementRoleTable,
+    ElementRoleOutline,
+    ElementRoleBrowser,
+    ElementRoleRow,
+    ElementRoleColumn,
+    ElementRoleCell,
+    ElementRoleMenuBar,
+    ElementRoleMenuBarItem,
+    ElementRoleMenu,
+    ElementRoleMenuItem,
+    ElementRoleButton,
+    ElementRoleMenuButton,
+    ElementRolePopUpButton,
+    ElementRoleCheckBox,
+    ElementRoleRadioButton,
+    ElementRoleRadioGroup,
+    ElementRoleComboBox,
+    ElementRoleTextField,
+    ElementRoleTextArea,
+    ElementRoleStaticText,
+    ElementRoleImage,
+    ElementRoleHeading,
+    ElementRoleLink,
+    ElementRoleSlider,
+    ElementRoleSwitch,
+    ElementRoleTabButton,
+    ElementRoleDisclosureTriangle,
+    ElementRoleIncrementor,
+    ElementRoleValueIndicator,
+    ElementRoleProgressIndicator,
+    ElementRoleLayoutArea,
+    ElementRoleLayoutItem,
+    ElementRoleDockItem,
+    ElementRoleUnknownAX,
+    ElementRoleCount
+} ElementRole;
+
+/// Get the role name of a known role identifier
+/// @param roleID Role identifier
+/// @return Static role name, or NULL if roleID is not a known role
+const char *roleNameForID(int roleID);
+
 #pragma mark - Element Information
 
-/// Structure containing information about an accessibility element
+/// Structure containing the attributes of an accessibility element needed for traversal
+typedef struct {
+    CGPoint position; ///< Element position
+    CGSize size;      ///< Element size
+    char *role;       ///< Element role, NULL when roleID identifies a known role
+    int roleID;       ///< Known role identifier (ElementRole), ElementRoleUnknown otherwise
+    int pid;          ///< Process identifier
+    int axError;      ///< AXError of the attribute request, kAXErrorSuccess when the attributes were fetched;
+                      ///< kAXErrorCannotComplete when the request was not sent after an earlier one timed out
+} ElementInfo;
+
+/// Structure containing descriptive attributes of an accessibility element, fetched on demand
 typedef struct {
-    CGPoint position;      ///< Element position
-    CGSize size;           ///< Element size
     char *title;           ///< Element title
-    char *role;            ///< Element role
     char *roleDescription; ///< Element role description
     bool isEnabled;        ///< Whether element is enabled
     bool isFocused;        ///< Whether element is focused
-    int pid;               ///< Process identifier
-} ElementInfo;
+} ElementAttributes;
+
+/// Structure identifying an accessibility element independently of the reference holding it
+typedef struct {
+    unsigned long hash; ///< CFHash of the element
+    int pid;            ///< Process identifier
+} ElementIdentity;
+
+/// Children of an element with their identities and information, packed into one allocation
+typedef struct {
+    int count;                   ///< Number of children
+    void **elements;             ///< Retained child element references
+    ElementIdentity *identities; ///< Child identities, index-aligned with elements
+    ElementInfo *infos;          ///< Child information, index-aligned with elements
+} ElementChildren;
+
+/// How an element qualifies as clickable
+typedef enum {
+    ClickActionNone = 0,      ///< Not clickable
+    ClickActionPresent = 1,   ///< Clickable wherever it is
+    ClickActionIfVisible = 2, ///< Clickable only if its center is not covered by another application
+} ClickAction;
+
+/// An on-screen window as listed by the window server
+typedef struct {
+    int pid;       ///< Process identifier of the window's owner
+    int layer;     ///< Window layer, 0 for normal windows
+    CGRect bounds; ///< Window frame in screen coordinates, origin at the top left
+} WindowFrame;
+
+#pragma mark - Observer Types
+
+/// Accessibility notifications forwarded by an element observer
+typedef enum {
+    ElementEventCreated = 0,              ///< kAXUIElementCreatedNotification
+    ElementEventDestroyed = 1,            ///< kAXUIElementDestroyedNotification
+    ElementEventMoved = 2,                ///< kAXMovedNotification / kAXWindowMovedNotification
+    ElementEventResized = 3,              ///< kAXResizedNotification / kAXWindowResizedNotification
+    ElementEventValueChanged = 4,         ///< kAXValueChangedNotification
+    ElementEventFocusedWindowChanged = 5, ///< kAXFocusedWindowChangedNotification
+} ElementEventKind;
+
+/// Element observer callback type, invoked in notification order on a serial background queue
+/// @param kind Notification kind (ElementEventKind)
+/// @param element Identity of the element the notification refers to
+/// @param parent Identity of the element's parent, only set for ElementEventCreated; zero when
+/// the parent could not be looked up
+/// @param userData User data pointer
+typedef void (*ElementObserverCallback)(int kind, ElementIdentity element, ElementIdentity parent, void *userData);
+
+/// Element observer handle
+typedef void *ElementObserver;
 
 #pragma mark - Permission Functions
 
@@ -56,6 +175,25 @@ void *getApplicationByBundleId(const char *bundle_id);
 /// @return Menu bar reference
 void *getMenuBar(void *app);
 
+#pragma mark - Messaging Timeout Functions
+
+/// Set the messaging timeout of every accessibility request that has no more specific timeout
+/// @param seconds Timeout in seconds; 0 restores the system default
+/// @return 1 on success, 0 on failure
+int setGlobalMessagingTimeout(float seconds);
+
+/// Set the messaging timeout of requests sent through one element reference
+/// @param element Element reference
+/// @param seconds Timeout in seconds; 0 falls back to the global timeout
+/// @return 1 on success, 0 on failure
+int setElementMessagingTimeout(void *element, float seconds);
+
+/// Set the messaging timeout applied to the elements of an application before the element and traversal
+/// functions query them
+/// @param pid Process identifier
+/// @param seconds Timeout in seconds; 0 removes the application's timeout
+void setApplicationMessagingTimeout(int pid, float seconds);
+
 #pragma mark - Element Functions
 
 /// Get information about an element
@@ -67,6 +205,27 @@ ElementInfo *getElementInfo(void *element);
 /// @param info Element information structure
 void freeElementInfo(ElementInfo *info);
 
+/// Get descriptive attributes of an element
+/// @param element Element reference
+/// @return Element attributes structure (free with freeElementAttributes), or NULL on failure
+ElementAttributes *getElementAttributes(void *element);
+
+/// Free element attributes structure
+/// @param attributes Element attributes structure
+void freeElementAttributes(ElementAttributes *attributes);
+
+/// Get the children of an element together with their identities and information in a single call
+/// @param element Element reference
+/// @param roleID Known role identifier of the element; visible rows are returned for lists, tables and outlines
+/// @param outTimedOut Output parameter set to 1 when a request to the application timed out, 0 otherwise; the
+/// children after the first timed-out info request are not asked and carry kAXErrorCannotComplete
+/// @return Packed children structure (free with freeElementChildren), or NULL if the element has no children
+ElementChildren *getChildrenWithInfo(void *element, int roleID, int *outTimedOut);
+
+/// Free a packed children structure without releasing the element references it holds
+/// @param children Packed children structure
+void freeElementChildren(ElementChildren *children);
+
 /// Get element at screen position
 /// @param position Screen position
 /// @return Element reference
@@ -77,18 +236,6 @@ void *getElementAtPosition(CGPoint position);
 /// @return Number of children
 int getChildrenCount(void *element);
 
-/// Get child elements
-/// @param element Element reference
-/// @param count Output parameter for number of children
-/// @return Array of child element references
-void **getChildren(void *element, int *count);
-
-/// Get visible rows of an element
-/// @param element Element reference
-/// @param count Output parameter for number of rows
-/// @return Array of row element references
-void **getVisibleRows(void *element, int *count);
-
 /// Get center point of an element
 /// @param element Element reference
 /// @param outPoint Output parameter for center point
@@ -113,6 +260,11 @@ void moveMouseSmooth(CGPoint startPosition, CGPoint endPosition, int steps, int
 /// @return 1 if element is clickable, 0 otherwise
 int hasClickAction(void *element);
 
+/// Classify how an element qualifies as clickable without testing its visibility
+/// @param element Element reference
+/// @return ClickAction value; callers resolve ClickActionIfVisible against a window snapshot
+int getClickAction(void *element);
+
 /// Set focus to element
 /// @param element Element reference
 /// @return 1 on success, 0 on failure
@@ -132,6 +284,29 @@ void freeString(char *str);
 /// @param element Element reference
 void releaseElement(void *element);
 
+/// Release multiple element references
+/// @param elements Array of element references; NULL entries are skipped
+/// @param count Number of element references
+void releaseElements(void **elements, int count);
+
+/// Retain element reference
+/// @param element Element reference
+/// @return The same element reference with its retain count incremented
+void *retainElement(void *element);
+
+/// Get identities of multiple elements without messaging their applications
+/// @param elements Array of element references
+/// @param count Number of element references
+/// @param outIdentities Caller-provided array of at least count entries, filled in element order
+void getElementIdentities(void **elements, int count, ElementIdentity *outIdentities);
+
+/// Compare element references pairwise for identity
+/// @param first Array of element references
+/// @param second Array of element references compared against first
+/// @param count Number of pairs
+/// @param outEqual Caller-provided array of at least count entries, true where the pair denotes the same element
+void elementsEqualBatch(void **first, void **second, int count, bool *outEqual);
+
 #pragma mark - Window Functions
 
 /// Get all windows of focused application
@@ -153,6 +328,12 @@ char *getApplicationName(void *app);
 /// @return Bundle identifier string
 char *getBundleIdentifier(void *app);
 
+/// Get the on-screen windows that can cover application content, front to back
+/// @param outWindows Caller-provided array of at least maxWindows entries
+/// @param maxWindows Capacity of outWindows
+/// @return Number of windows written, or -1 if the window list is unavailable
+int getOnScreenWindows(WindowFrame *outWindows, int maxWindows);
+
 /// Set application attribute
 /// @param pid Process identifier
 /// @param attribute Attribute name
@@ -207,6 +388,19 @@ int performLeftMouseUpAtPosition(CGPoint position);
 /// @return 1 on success, 0 on failure
 int performLeftMouseUpAtCursor(void);
 
+#pragma mark - Observer Functions
+
+/// Create an observer delivering the tree-affecting notifications of an application
+/// @param pid Process identifier of the application
+/// @param callback Callback function
+/// @param userData User data pointer
+/// @return Observer handle, or NULL if the application cannot be observed
+ElementObserver createElementObserver(int pid, ElementObserverCallback callback, void *userData);
+
+/// Destroy an element observer
+/// @param observer Observer handle
+void destroyElementObserver(ElementObserver observer);
+
 #pragma mark - Screen Functions
 
 /// Check if Mission Control is active
@@ -7,7 +7,10 @@
 
 #import "accessibility.h"
 #import <Cocoa/Cocoa.h>
+#include <os/lock.h>
+#include <stdatomic.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #pragma mark - Permission Functions
@@ -22,6 +25,131 @@ int checkAccessibilityPermissions(void) {
     }
 }
 
+#pragma mark - Messaging Timeout Functions
+
+#define kMaxApplicationTimeouts 64
+#define kSystemMessagingTimeout 6.0f
+
+/// Messaging timeout of one application
+typedef struct {
+    pid_t pid;
+    float seconds;
+} ApplicationTimeout;
+
+static ApplicationTimeout applicationTimeouts[kMaxApplicationTimeouts];
+static int applicationTimeoutCount = 0;
+static int applicationTimeoutNext = 0;
+static os_unfair_lock applicationTimeoutsLock = OS_UNFAIR_LOCK_INIT;
+static _Atomic(float) globalMessagingTimeout = kSystemMessagingTimeout;
+
+/// Set the messaging timeout of every accessibility request that has no more specific timeout
+/// @param seconds Timeout in seconds; 0 restores the system default
+/// @return 1 on success, 0 on failure
+int setGlobalMessagingTimeout(float seconds) {
+    AXUIElementRef systemWide = AXUIElementCreateSystemWide();
+    if (!systemWide)
+        return 0;
+
+    // The timeout of the system-wide element applies to every element without its own
+    AXError error = AXUIElementSetMessagingTimeout(systemWide, seconds);
+    CFRelease(systemWide);
+    if (error != kAXErrorSuccess)
+        return 0;
+
+    atomic_store(&globalMessagingTimeout, seconds > 0 ? seconds : kSystemMessagingTimeout);
+    return 1;
+}
+
+/// Set the messaging timeout of requests sent through one element reference
+/// @param element Element reference
+/// @param seconds Timeout in seconds; 0 falls back to the global timeout
+/// @return 1 on success, 0 on failure
+int setElementMessagingTimeout(void *element, float seconds) {
+    if (!element)
+        return 0;
+
+    return (AXUIElementSetMessagingTimeout((AXUIElementRef)element, seconds) == kAXErrorSuccess) ? 1 : 0;
+}
+
+/// Set the messaging timeout applied to the elements of an application before they are queried
+/// @param pid Process identifier
+/// @param seconds Timeout in seconds; 0 removes the application's timeout
+void setApplicationMessagingTimeout(int pid, float seconds) {
+    os_unfair_lock_lock(&applicationTimeoutsLock);
+
+    int index = 0;
+    while (index < applicationTimeoutCount && applicationTimeouts[index].pid != pid)
+        index++;
+
+    if (seconds <= 0) {
+        if (index < applicationTimeoutCount) {
+            applicationTimeouts[index] = applicationTimeouts[applicationTimeoutCount - 1];
+            applicationTimeoutCount--;
+        }
+    } else if (index < applicationTimeoutCount) {
+        applicationTimeouts[index].seconds = seconds;
+    } else {
+        // A full table recycles its slots in turn; evicted apps fall back to the global timeout
+        if (applicationTimeoutCount < kMaxApplicationTimeouts) {
+            index = applicationTimeoutCount++;
+        } else {
+            index = applicationTimeoutNext;
+            applicationTimeoutNext = (applicationTimeoutNext + 1) % kMaxApplicationTimeouts;
+        }
+        applicationTimeouts[index].pid = pid;
+        applicationTimeouts[index].seconds = seconds;
+    }
+
+    os_unfair_lock_unlock(&applicationTimeoutsLock);
+}
+
+/// Look up the messaging timeout of an application
+/// @param pid Process identifier
+/// @return Timeout in seconds, or 0 if the application has none
+static float applicationTimeoutForPID(pid_t pid) {
+    float seconds = 0;
+    os_unfair_lock_lock(&applicationTimeoutsLock);
+    for (int i = 0; i < applicationTimeoutCount; i++) {
+        if (applicationTimeouts[i].pid == pid) {
+            seconds = applicationTimeouts[i].seconds;
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&applicationTimeoutsLock);
+    return seconds;
+}
+
+/// Apply the messaging timeout of the element's application to the element reference
+/// @param element Element reference
+/// @return Timeout in seconds that was applied, or 0 if the application has none
+static float applyApplicationTimeout(AXUIElementRef element) {
+    pid_t pid;
+    if (AXUIElementGetPid(element, &pid) != kAXErrorSuccess)
+        return 0;
+
+    float seconds = applicationTimeoutForPID(pid);
+    if (seconds > 0)
+        AXUIElementSetMessagingTimeout(element, seconds);
+    return seconds;
+}
+
+/// Tell whether a failed request ran out its messaging timeout; applications also answer kAXErrorCannotComplete
+/// right away, for instance while they tear down the element
+/// @param error Error of the request
+/// @param start Time the request was sent, from clock_gettime_nsec_np(CLOCK_UPTIME_RAW)
+/// @param timeout Messaging timeout of the request in seconds, 0 for the global timeout
+/// @return true if the request timed out
+static bool requestTimedOut(AXError error, uint64_t start, float timeout) {
+    if (error != kAXErrorCannotComplete)
+        return false;
+    if (timeout <= 0)
+        timeout = atomic_load(&globalMessagingTimeout);
+
+    // The timeout fires close to, not exactly at, its deadline
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    return (double)elapsed >= 0.9 * (double)timeout * NSEC_PER_SEC;
+}
+
 #pragma mark - Application Functions
 
 /// Set application attribute
@@ -93,40 +221,62 @@ static bool isPointVisible(CGPoint point, pid_t elementPid) {
     return isVisible;
 }
 
-/// Helper function to check if an element is occluded by checking multiple sample points
-/// @param elementRect Element bounds
-/// @param elementPid Process identifier of the element
-/// @return true if element is occluded, false otherwise
-static bool isElementOccluded(CGRect elementRect, pid_t elementPid) {
-    // Sample 5 points: center and 4 corners (slightly inset)
-    CGFloat inset = 2.0; // Inset from edges to avoid border issues
-
-    CGPoint samplePoints[5] = {
-        // Center
-        CGPointMake(elementRect.origin.x + elementRect.size.width / 2,
-                    elementRect.origin.y + elementRect.size.height / 2),
-        // Top-left
-        CGPointMake(elementRect.origin.x + inset, elementRect.origin.y + inset),
-        // Top-right
-        CGPointMake(elementRect.origin.x + elementRect.size.width - inset, elementRect.origin.y + inset),
-        // Bottom-left
-        CGPointMake(elementRect.origin.x + inset, elementRect.origin.y + elementRect.size.height - inset),
-        // Bottom-right
-        CGPointMake(elementRect.origin.x + elementRect.size.width - inset,
-                    elementRect.origin.y + elementRect.size.height - inset)};
-
-    // Element is considered visible if at least 2 sample points are visible
-    int visiblePoints = 0;
-    for (int i = 0; i < 5; i++) {
-        if (isPointVisible(samplePoints[i], elementPid)) {
-            visiblePoints++;
-            if (visiblePoints >= 2) {
-                return false; // Not occluded
-            }
-        }
+/// Get the on-screen windows that can cover application content, front to back
+/// @param outWindows Caller-provided array of at least maxWindows entries
+/// @param maxWindows Capacity of outWindows
+/// @return Number of windows written, or -1 if the window list is unavailable
+int getOnScreenWindows(WindowFrame *outWindows, int maxWindows) {
+    if (!outWindows || maxWindows <= 0)
+        return 0;
+
+    CFArrayRef windowList = CGWindowListCopyWindowInfo(
+        kCGWindowListOptionOnScreenOnly | kCGWindowListExcludeDesktopElements, kCGNullWindowID);
+    if (!windowList)
+        return -1;
+
+    pid_t selfPid = getpid();
+    int written = 0;
+    CFIndex count = CFArrayGetCount(windowList);
+    for (CFIndex i = 0; i < count && written < maxWindows; i++) {
+        CFDictionaryRef windowInfo = (CFDictionaryRef)CFArrayGetValueAtIndex(windowList, i);
+        if (!windowInfo)
+            continue;
+
+        int pid = 0, layer = 0;
+        CFNumberRef pidValue = (CFNumberRef)CFDictionaryGetValue(windowInfo, kCGWindowOwnerPID);
+        CFNumberRef layerValue = (CFNumberRef)CFDictionaryGetValue(windowInfo, kCGWindowLayer);
+        if (!pidValue || !CFNumberGetValue(pidValue, kCFNumberIntType, &pid) || pid == selfPid)
+            continue;
+        if (layerValue)
+            CFNumberGetValue(layerValue, kCFNumberIntType, &layer);
+
+        // The menu bar and status items sit above every app without hiding its elements; pop-up
+        // menus, alerts and panels above them do hide what is underneath
+        if (layer < 0 || layer == kCGMainMenuWindowLevel || layer == kCGStatusWindowLevel)
+            continue;
+
+        // Fully transparent windows do not hide anything
+        double alpha = 1.0;
+        CFNumberRef alphaValue = (CFNumberRef)CFDictionaryGetValue(windowInfo, kCGWindowAlpha);
+        if (alphaValue)
+            CFNumberGetValue(alphaValue, kCFNumberDoubleType, &alpha);
+        if (alpha <= 0.0)
+            continue;
+
+        CGRect bounds;
+        CFDictionaryRef boundsValue = (CFDictionaryRef)CFDictionaryGetValue(windowInfo, kCGWindowBounds);
+        if (!boundsValue || !CGRectMakeWithDictionaryRepresentation(boundsValue, &bounds) ||
+            CGRectIsEmpty(bounds))
+            continue;
+
+        outWindows[written].pid = pid;
+        outWindows[written].layer = layer;
+        outWindows[written].bounds = bounds;
+        written++;
     }
 
-    return true; // Occluded (less than 2 points visible)
+    CFRelease(windowList);
+    return written;
 }
 
 #pragma mark - Element Accessor Functions
@@ -233,6 +383,92 @@ char *cfStringToCString(CFStringRef cfStr) {
     return NULL;
 }
 
+#pragma mark - Role Table Functions
+
+/// Role names indexed by ElementRole
+static const char *const kElementRoleNames[ElementRoleCount] = {
+    [ElementRoleUnknown] = "",
+    [ElementRoleApplication] = "AXApplication",
+    [ElementRoleWindow] = "AXWindow",
+    [ElementRoleSheet] = "AXSheet",
+    [ElementRoleDrawer] = "AXDrawer",
+    [ElementRoleGroup] = "AXGroup",
+    [ElementRoleScrollArea] = "AXScrollArea",
+    [ElementRoleScrollBar] = "AXScrollBar",
+    [ElementRoleSplitGroup] = "AXSplitGroup",
+    [ElementRoleSplitter] = "AXSplitter",
+    [ElementRoleToolbar] = "AXToolbar",
+    [ElementRoleTabGroup] = "AXTabGroup",
+    [ElementRoleWebArea] = "AXWebArea",
+    [ElementRoleList] = "AXList",
+    [ElementRoleTable] = "AXTable",
+    [ElementRoleOutline] = "AXOutline",
+    [ElementRoleBrowser] = "AXBrowser",
+    [ElementRoleRow] = "AXRow",
+    [ElementRoleColumn] = "AXColumn",
+    [ElementRoleCell] = "AXCell",
+    [ElementRoleMenuBar] = "AXMenuBar",
+    [ElementRoleMenuBarItem] = "AXMenuBarItem",
+    [ElementRoleMenu] = "AXMenu",
+    [ElementRoleMenuItem] = "AXMenuItem",
+    [ElementRoleButton] = "AXButton",
+    [ElementRoleMenuButton] = "AXMenuButton",
+    [ElementRolePopUpButton] = "AXPopUpButton",
+    [ElementRoleCheckBox] = "AXCheckBox",
+    [ElementRoleRadioButton] = "AXRadioButton",
+    [ElementRoleRadioGroup] = "AXRadioGroup",
+    [ElementRoleComboBox] = "AXComboBox",
+    [ElementRoleTextField] = "AXTextField",
+    [ElementRoleTextArea] = "AXTextArea",
+    [ElementRoleStaticText] = "AXStaticText",
+    [ElementRoleImage] = "AXImage",
+    [ElementRoleHeading] = "AXHeading",
+    [ElementRoleLink] = "AXLink",
+    [ElementRoleSlider] = "AXSlider",
+    [ElementRoleSwitch] = "AXSwitch",
+    [ElementRoleTabButton] = "AXTabButton",
+    [ElementRoleDisclosureTriangle] = "AXDisclosureTriangle",
+    [ElementRoleIncrementor] = "AXIncrementor",
+    [ElementRoleValueIndicator] = "AXValueIndicator",
+    [ElementRoleProgressIndicator] = "AXProgressIndicator",
+    [ElementRoleLayoutArea] = "AXLayoutArea",
+    [ElementRoleLayoutItem] = "AXLayoutItem",
+    [ElementRoleDockItem] = "AXDockItem",
+    [ElementRoleUnknownAX] = "AXUnknown",
+};
+
+/// Get the role name of a known role identifier
+/// @param roleID Role identifier
+/// @return Static role name, or NULL if roleID is not a known role
+const char *roleNameForID(int roleID) {
+    if (roleID <= ElementRoleUnknown || roleID >= ElementRoleCount)
+        return NULL;
+    return kElementRoleNames[roleID];
+}
+
+/// Look up the identifier of a role name
+/// @param role Role name
+/// @return Known role identifier, or ElementRoleUnknown
+static int roleIDForString(CFStringRef role) {
+    static CFDictionaryRef roleIDs = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        CFMutableDictionaryRef ids =
+            CFDictionaryCreateMutable(NULL, ElementRoleCount, &kCFTypeDictionaryKeyCallBacks, NULL);
+        for (intptr_t roleID = ElementRoleUnknown + 1; roleID < ElementRoleCount; roleID++) {
+            CFStringRef name = CFStringCreateWithCString(NULL, kElementRoleNames[roleID], kCFStringEncodingUTF8);
+            CFDictionarySetValue(ids, name, (const void *)roleID);
+            CFRelease(name);
+        }
+        roleIDs = ids;
+    });
+
+    const void *roleID = NULL;
+    if (!role || !CFDictionaryGetValueIfPresent(roleIDs, role, &roleID))
+        return ElementRoleUnknown;
+    return (int)(intptr_t)roleID;
+}
+
 #pragma mark - Element Information Functions
 
 /// Get element information
@@ -248,6 +484,8 @@ ElementInfo *getElementInfo(void *element) {
         if (!info)
             return NULL;
 
+        applyApplicationTimeout(axElement);
+
         // Get position
         CFTypeRef positionValue = NULL;
         if (AXUIElementCopyAttributeValue(axElement, kAXPositionAttribute, &positionValue) == kAXErrorSuccess) {
@@ -268,51 +506,19 @@ ElementInfo *getElementInfo(void *element) {
             CFRelease(sizeValue);
         }
 
-        // Get title
-        CFTypeRef titleValue = NULL;
-        if (AXUIElementCopyAttributeValue(axElement, kAXTitleAttribute, &titleValue) == kAXErrorSuccess) {
-            if (CFGetTypeID(titleValue) == CFStringGetTypeID()) {
-                info->title = cfStringToCString((CFStringRef)titleValue);
-            }
-            CFRelease(titleValue);
-        }
-
         // Get role
         CFTypeRef roleValue = NULL;
         if (AXUIElementCopyAttributeValue(axElement, kAXRoleAttribute, &roleValue) == kAXErrorSuccess) {
             if (CFGetTypeID(roleValue) == CFStringGetTypeID()) {
-                info->role = cfStringToCString((CFStringRef)roleValue);
+                // Known roles travel as an ID only; Go maps it back to the shared name
+                info->roleID = roleIDForString((CFStringRef)roleValue);
+                if (info->roleID == ElementRoleUnknown) {
+                    info->role = cfStringToCString((CFStringRef)roleValue);
+                }
             }
             CFRelease(roleValue);
         }
 
-        // Get role description
-        CFTypeRef roleDescValue = NULL;
-        if (AXUIElementCopyAttributeValue(axElement, kAXRoleDescriptionAttribute, &roleDescValue) == kAXErrorSuccess) {
-            if (CFGetTypeID(roleDescValue) == CFStringGetTypeID()) {
-                info->roleDescription = cfStringToCString((CFStringRef)roleDescValue);
-            }
-            CFRelease(roleDescValue);
-        }
-
-        // Get enabled state
-        CFTypeRef enabledValue = NULL;
-        if (AXUIElementCopyAttributeValue(axElement, kAXEnabledAttribute, &enabledValue) == kAXErrorSuccess) {
-            if (CFGetTypeID(enabledValue) == CFBooleanGetTypeID()) {
-                info->isEnabled = CFBooleanGetValue((CFBooleanRef)enabledValue);
-            }
-            CFRelease(enabledValue);
-        }
-
-        // Get focused state
-        CFTypeRef focusedValue = NULL;
-        if (AXUIElementCopyAttributeValue(axElement, kAXFocusedAttribute, &focusedValue) == kAXErrorSuccess) {
-            if (CFGetTypeID(focusedValue) == CFBooleanGetTypeID()) {
-                info->isFocused = CFBooleanGetValue((CFBooleanRef)focusedValue);
-            }
-            CFRelease(focusedValue);
-        }
-
         // Get PID
         pid_t pid;
         if (AXUIElementGetPid(axElement, &pid) == kAXErrorSuccess) {
@@ -329,148 +535,452 @@ void freeElementInfo(ElementInfo *info) {
     if (!info)
         return;
 
-    if (info->title)
-        free(info->title);
     if (info->role)
         free(info->role);
-    if (info->roleDescription)
-        free(info->roleDescription);
     free(info);
 }
 
-#pragma mark - Position Functions
+/// Indices of the attributes fetched by copyElementInfoValues
+enum {
+    kElementInfoAttributePosition = 0,
+    kElementInfoAttributeSize,
+    kElementInfoAttributeRole,
+    kElementInfoAttributeCount
+};
+
+/// Indices of the attributes fetched by getElementAttributes
+enum {
+    kElementAttributeTitle = 0,
+    kElementAttributeRoleDescription,
+    kElementAttributeEnabled,
+    kElementAttributeFocused,
+    kElementAttributeCount
+};
+
+/// Get the attribute list used for multi-attribute element info fetches
+/// @return Attribute names ordered by the kElementInfoAttribute indices
+static CFArrayRef elementInfoAttributes(void) {
+    static CFArrayRef attributes = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        CFStringRef names[kElementInfoAttributeCount] = {kAXPositionAttribute, kAXSizeAttribute, kAXRoleAttribute};
+        attributes = CFArrayCreate(NULL, (const void **)names, kElementInfoAttributeCount, &kCFTypeArrayCallBacks);
+    });
+    return attributes;
+}
 
-/// Get element at screen position
-/// @param position Screen position
-/// @return Element reference
-void *getElementAtPosition(CGPoint position) {
-    AXUIElementRef systemWide = AXUIElementCreateSystemWide();
-    if (!systemWide)
+/// Get the attribute list used for descriptive attribute fetches
+/// @return Attribute names ordered by the kElementAttribute indices
+static CFArrayRef elementAttributesAttributes(void) {
+    static CFArrayRef attributes = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        CFStringRef names[kElementAttributeCount] = {kAXTitleAttribute, kAXRoleDescriptionAttribute,
+                                                     kAXEnabledAttribute, kAXFocusedAttribute};
+        attributes = CFArrayCreate(NULL, (const void **)names, kElementAttributeCount, &kCFTypeArrayCallBacks);
+    });
+    return attributes;
+}
+
+/// Get the value at an attribute index if it has the expected CoreFoundation type
+/// @param values Values returned by AXUIElementCopyMultipleAttributeValues
+/// @param index Attribute index
+/// @param typeID Expected type identifier
+/// @return Value reference, or NULL if missing or of another type
+static CFTypeRef attributeValueOfType(CFArrayRef values, CFIndex index, CFTypeID typeID) {
+    if (!values || index >= CFArrayGetCount(values))
         return NULL;
 
-    AXUIElementRef element = NULL;
-    AXError error = AXUIElementCopyElementAtPosition(systemWide, position.x, position.y, &element);
+    CFTypeRef value = CFArrayGetValueAtIndex(values, index);
+    if (!value || CFGetTypeID(value) != typeID)
+        return NULL;
 
-    CFRelease(systemWide);
+    return value;
+}
 
-    if (error != kAXErrorSuccess) {
-        return NULL;
-    }
+/// Get the buffer size needed to pack a string attribute value
+/// @param values Values returned by AXUIElementCopyMultipleAttributeValues
+/// @param index Attribute index
+/// @return Maximum UTF-8 size including the terminator, or 0 if the value is not a string
+static CFIndex packedStringSize(CFArrayRef values, CFIndex index) {
+    CFStringRef value = (CFStringRef)attributeValueOfType(values, index, CFStringGetTypeID());
+    if (!value)
+        return 0;
 
-    return (void *)element;
+    return CFStringGetMaximumSizeForEncoding(CFStringGetLength(value), kCFStringEncodingUTF8) + 1;
 }
 
-#pragma mark - Child Element Functions
+/// Copy a string attribute value into a shared buffer
+/// @param values Values returned by AXUIElementCopyMultipleAttributeValues
+/// @param index Attribute index
+/// @param buffer Shared string buffer
+/// @param capacity Total buffer capacity
+/// @param length In/out parameter for the number of bytes used in buffer
+/// @return Pointer to the packed string inside buffer, or NULL if the value is not a string
+static char *packStringValue(CFArrayRef values, CFIndex index, char *buffer, CFIndex capacity, CFIndex *length) {
+    CFStringRef value = (CFStringRef)attributeValueOfType(values, index, CFStringGetTypeID());
+    if (!value || !buffer)
+        return NULL;
 
-/// Get number of child elements
-/// @param element Element reference
-/// @return Number of children
-int getChildrenCount(void *element) {
-    if (!element)
-        return 0;
+    char *start = buffer + *length;
+    if (!CFStringGetCString(value, start, capacity - *length, kCFStringEncodingUTF8))
+        return NULL;
 
-    AXUIElementRef axElement = (AXUIElementRef)element;
-    CFTypeRef childrenValue = NULL;
+    *length += (CFIndex)strlen(start) + 1;
+    return start;
+}
 
-    if (AXUIElementCopyAttributeValue(axElement, kAXChildrenAttribute, &childrenValue) != kAXErrorSuccess) {
-        return 0;
+/// Fetch the element information attributes of several elements, one round-trip per element
+/// @param elements Array of element references
+/// @param count Number of element references
+/// @param outInfos Array of count entries; pid, roleID and axError are filled, the rest is left zeroed
+/// @param outCapacity Output parameter for the string buffer size decodeElementInfoValues needs
+/// @param outFilled Output parameter for the number of non-NULL element references
+/// @param timeout Messaging timeout in seconds to apply to every element, 0 to keep their own
+/// @param outTimedOut Output parameter set to true when a request timed out; the remaining elements are then not
+/// asked and get kAXErrorCannotComplete
+/// @return Array of count attribute value arrays (entries may be NULL) for decodeElementInfoValues
+static CFArrayRef *copyElementInfoValues(void **elements, int count, ElementInfo *outInfos, CFIndex *outCapacity,
+                                         int *outFilled, float timeout, bool *outTimedOut) {
+    *outCapacity = 0;
+    *outFilled = 0;
+
+    CFArrayRef attributes = elementInfoAttributes();
+    CFArrayRef *values = (CFArrayRef *)calloc((size_t)count, sizeof(CFArrayRef));
+    if (!attributes || !values) {
+        free(values);
+        return NULL;
     }
 
-    if (CFGetTypeID(childrenValue) != CFArrayGetTypeID()) {
-        CFRelease(childrenValue);
-        return 0;
-    }
+    bool stalled = false;
+    for (int i = 0; i < count; i++) {
+        AXUIElementRef axElement = (AXUIElementRef)elements[i];
+        if (!axElement)
+            continue;
+        (*outFilled)++;
 
-    CFIndex count = CFArrayGetCount((CFArrayRef)childrenValue);
-    CFRelease(childrenValue);
+        pid_t pid;
+        if (AXUIElementGetPid(axElement, &pid) == kAXErrorSuccess) {
+            outInfos[i].pid = pid;
+        }
 
-    return (int)count;
+        // Every further request to a stalled application would wait out its timeout as well
+        if (stalled) {
+            outInfos[i].axError = kAXErrorCannotComplete;
+            continue;
+        }
+
+        if (timeout > 0)
+            AXUIElementSetMessagingTimeout(axElement, timeout);
+
+        uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        AXError error = AXUIElementCopyMultipleAttributeValues(axElement, attributes, 0, &values[i]);
+        if (error != kAXErrorSuccess) {
+            if (requestTimedOut(error, start, timeout)) {
+                *outTimedOut = true;
+                stalled = true;
+            }
+            outInfos[i].axError = error;
+            values[i] = NULL;
+            continue;
+        }
+
+        outInfos[i].roleID = roleIDForString(
+            (CFStringRef)attributeValueOfType(values[i], kElementInfoAttributeRole, CFStringGetTypeID()));
+        if (outInfos[i].roleID == ElementRoleUnknown) {
+            *outCapacity += packedStringSize(values[i], kElementInfoAttributeRole);
+        }
+    }
+
+    return values;
 }
 
-/// Get child elements
-/// @param element Element reference
-/// @param count Output parameter for number of children
-/// @return Array of child element references
-void **getChildren(void *element, int *count) {
-    if (!element || !count)
-        return NULL;
+/// Decode attribute values into element information and release them
+/// @param values Array returned by copyElementInfoValues, freed by this function
+/// @param count Number of entries in values
+/// @param outInfos Array of count entries filled by copyElementInfoValues
+/// @param buffer String buffer of at least the capacity reported by copyElementInfoValues
+/// @param capacity Buffer capacity
+/// @return Number of bytes used in buffer
+static CFIndex decodeElementInfoValues(CFArrayRef *values, int count, ElementInfo *outInfos, char *buffer,
+                                       CFIndex capacity) {
+    CFIndex length = 0;
+    for (int i = 0; i < count; i++) {
+        if (!values[i])
+            continue;
+
+        ElementInfo *info = &outInfos[i];
+        AXValueRef positionValue =
+            (AXValueRef)attributeValueOfType(values[i], kElementInfoAttributePosition, AXValueGetTypeID());
+        if (positionValue) {
+            CGPoint point;
+            if (AXValueGetValue(positionValue, kAXValueCGPointType, &point)) {
+                info->position = point;
+            }
+        }
 
-    AXUIElementRef axElement = (AXUIElementRef)element;
+        AXValueRef sizeValue =
+            (AXValueRef)attributeValueOfType(values[i], kElementInfoAttributeSize, AXValueGetTypeID());
+        if (sizeValue) {
+            CGSize size;
+            if (AXValueGetValue(sizeValue, kAXValueCGSizeType, &size)) {
+                info->size = size;
+            }
+        }
+
+        if (info->roleID == ElementRoleUnknown) {
+            info->role = packStringValue(values[i], kElementInfoAttributeRole, buffer, capacity, &length);
+        }
+
+        CFRelease(values[i]);
+    }
+    free(values);
+
+    return length;
+}
+
+/// Copy the children of an element, preferring visible rows for list-like roles
+/// @param axElement Element reference
+/// @param roleID Known role identifier of the element
+/// @param timeout Messaging timeout applied to the element in seconds, 0 for the global timeout
+/// @param outTimedOut Output parameter set to true when a request timed out
+/// @return Array of children, or NULL
+static CFArrayRef copyChildrenForRole(AXUIElementRef axElement, int roleID, float timeout, bool *outTimedOut) {
     CFTypeRef childrenValue = NULL;
+    AXError error;
+    uint64_t start;
+    if (roleID == ElementRoleList || roleID == ElementRoleTable || roleID == ElementRoleOutline) {
+        start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+        error = AXUIElementCopyAttributeValue(axElement, kAXVisibleRowsAttribute, &childrenValue);
+        if (error == kAXErrorSuccess) {
+            if (CFGetTypeID(childrenValue) == CFArrayGetTypeID())
+                return (CFArrayRef)childrenValue;
+            CFRelease(childrenValue);
+            childrenValue = NULL;
+        } else if (requestTimedOut(error, start, timeout)) {
+            // A busy app would stall the children request just the same
+            *outTimedOut = true;
+            return NULL;
+        }
+    }
 
-    if (AXUIElementCopyAttributeValue(axElement, kAXChildrenAttribute, &childrenValue) != kAXErrorSuccess) {
-        *count = 0;
+    start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    error = AXUIElementCopyAttributeValue(axElement, kAXChildrenAttribute, &childrenValue);
+    if (error != kAXErrorSuccess) {
+        if (requestTimedOut(error, start, timeout))
+            *outTimedOut = true;
         return NULL;
     }
 
     if (CFGetTypeID(childrenValue) != CFArrayGetTypeID()) {
         CFRelease(childrenValue);
-        *count = 0;
         return NULL;
     }
 
-    CFArrayRef children = (CFArrayRef)childrenValue;
-    CFIndex childCount = CFArrayGetCount(children);
-    *count = (int)childCount;
+    return (CFArrayRef)childrenValue;
+}
 
-    void **result = (void **)malloc(childCount * sizeof(void *));
-    if (!result) {
-        CFRelease(childrenValue);
-        *count = 0;
+/// Get the children of an element together with their identities and information
+/// @param element Element reference
+/// @param roleID Known role identifier of the element; visible rows are returned for lists, tables and outlines
+/// @param outTimedOut Output parameter set to 1 when a request to the application timed out, 0 otherwise
+/// @return Packed children structure (free with freeElementChildren), or NULL if the element has no children
+ElementChildren *getChildrenWithInfo(void *element, int roleID, int *outTimedOut) {
+    if (outTimedOut)
+        *outTimedOut = 0;
+    if (!element)
         return NULL;
-    }
 
-    for (CFIndex i = 0; i < childCount; i++) {
-        AXUIElementRef child = (AXUIElementRef)CFArrayGetValueAtIndex(children, i);
-        CFRetain(child);
-        result[i] = (void *)child;
+    @autoreleasepool {
+        bool timedOut = false;
+        float timeout = applyApplicationTimeout((AXUIElementRef)element);
+        CFArrayRef children = copyChildrenForRole((AXUIElementRef)element, roleID, timeout, &timedOut);
+        if (outTimedOut)
+            *outTimedOut = timedOut ? 1 : 0;
+        if (!children)
+            return NULL;
+
+        int count = (int)CFArrayGetCount(children);
+        if (count == 0) {
+            CFRelease(children);
+            return NULL;
+        }
+
+        // Header, element references, identities and infos share one allocation; role strings
+        // of unknown roles are appended once their size is known
+        size_t fixedSize = sizeof(ElementChildren) + (size_t)count * (sizeof(void *) + sizeof(ElementIdentity));
+        fixedSize = (fixedSize + _Alignof(ElementInfo) - 1) & ~(_Alignof(ElementInfo) - 1);
+        fixedSize += (size_t)count * sizeof(ElementInfo);
+
+        ElementChildren *result = (ElementChildren *)calloc(1, fixedSize);
+        if (!result) {
+            CFRelease(children);
+            return NULL;
+        }
+        result->count = count;
+        result->elements = (void **)(result + 1);
+
+        for (int i = 0; i < count; i++) {
+            CFTypeRef child = CFArrayGetValueAtIndex(children, i);
+            CFRetain(child);
+            result->elements[i] = (void *)child;
+        }
+        CFRelease(children);
+
+        ElementInfo *infos = (ElementInfo *)((char *)result + fixedSize - (size_t)count * sizeof(ElementInfo));
+        CFIndex capacity = 0;
+        int filled = 0;
+        CFArrayRef *values =
+            copyElementInfoValues(result->elements, count, infos, &capacity, &filled, timeout, &timedOut);
+        if (outTimedOut)
+            *outTimedOut = timedOut ? 1 : 0;
+
+        if (capacity > 0) {
+            ElementChildren *grown = (ElementChildren *)realloc(result, fixedSize + (size_t)capacity);
+            if (!grown) {
+                // Keep the element references valid; roles outside the table stay unresolved
+                capacity = 0;
+            } else {
+                result = grown;
+            }
+        }
+
+        result->elements = (void **)(result + 1);
+        result->identities = (ElementIdentity *)(result->elements + count);
+        result->infos = (ElementInfo *)((char *)result + fixedSize - (size_t)count * sizeof(ElementInfo));
+
+        for (int i = 0; i < count; i++) {
+            result->identities[i].hash = (unsigned long)CFHash((CFTypeRef)result->elements[i]);
+            result->identities[i].pid = result->infos[i].pid;
+        }
+
+        if (values) {
+            decodeElementInfoValues(values, count, result->infos, capacity > 0 ? (char *)result + fixedSize : NULL,
+                                    capacity);
+        }
+
+        return result;
     }
+}
 
-    CFRelease(childrenValue);
-    return result;
+/// Free a packed children structure without releasing the element references it holds
+/// @param children Packed children structure
+void freeElementChildren(ElementChildren *children) {
+    if (children)
+        free(children);
 }
 
-/// Get visible rows of an element
+/// Get descriptive attributes of an element
 /// @param element Element reference
-/// @param count Output parameter for number of rows
-/// @return Array of row element references
-void **getVisibleRows(void *element, int *count) {
-    if (!element || !count)
+/// @return Element attributes structure (free with freeElementAttributes), or NULL on failure
+ElementAttributes *getElementAttributes(void *element) {
+    if (!element)
         return NULL;
 
-    AXUIElementRef axElement = (AXUIElementRef)element;
-    CFTypeRef rowsValue = NULL;
+    @autoreleasepool {
+        AXUIElementRef axElement = (AXUIElementRef)element;
+        applyApplicationTimeout(axElement);
 
-    if (AXUIElementCopyAttributeValue(axElement, kAXVisibleRowsAttribute, &rowsValue) != kAXErrorSuccess) {
-        *count = 0;
-        return NULL;
+        CFArrayRef values = NULL;
+        if (AXUIElementCopyMultipleAttributeValues(axElement, elementAttributesAttributes(), 0, &values) !=
+            kAXErrorSuccess)
+            return NULL;
+
+        ElementAttributes *attributes = (ElementAttributes *)calloc(1, sizeof(ElementAttributes));
+        if (!attributes) {
+            CFRelease(values);
+            return NULL;
+        }
+
+        CFStringRef titleValue =
+            (CFStringRef)attributeValueOfType(values, kElementAttributeTitle, CFStringGetTypeID());
+        if (titleValue) {
+            attributes->title = cfStringToCString(titleValue);
+        }
+
+        CFStringRef roleDescValue =
+            (CFStringRef)attributeValueOfType(values, kElementAttributeRoleDescription, CFStringGetTypeID());
+        if (roleDescValue) {
+            attributes->roleDescription = cfStringToCString(roleDescValue);
+        }
+
+        CFBooleanRef enabledValue =
+            (CFBooleanRef)attributeValueOfType(values, kElementAttributeEnabled, CFBooleanGetTypeID());
+        if (enabledValue) {
+            attributes->isEnabled = CFBooleanGetValue(enabledValue);
+        }
+
+        CFBooleanRef focusedValue =
+            (CFBooleanRef)attributeValueOfType(values, kElementAttributeFocused, CFBooleanGetTypeID());
+        if (focusedValue) {
+            attributes->isFocused = CFBooleanGetValue(focusedValue);
+        }
+
+        CFRelease(values);
+        return attributes;
     }
+}
+
+/// Free element attributes
+/// @param attributes Element attributes structure
+void freeElementAttributes(ElementAttributes *attributes) {
+    if (!attributes)
+        return;
 
-    if (CFGetTypeID(rowsValue) != CFArrayGetTypeID()) {
-        CFRelease(rowsValue);
-        *count = 0;
+    if (attributes->title)
+        free(attributes->title);
+    if (attributes->roleDescription)
+        free(attributes->roleDescription);
+    free(attributes);
+}
+
+#pragma mark - Position Functions
+
+/// Get element at screen position
+/// @param position Screen position
+/// @return Element reference
+void *getElementAtPosition(CGPoint position) {
+    AXUIElementRef systemWide = AXUIElementCreateSystemWide();
+    if (!systemWide)
         return NULL;
-    }
 
-    CFArrayRef rows = (CFArrayRef)rowsValue;
-    CFIndex rowCount = CFArrayGetCount(rows);
-    *count = (int)rowCount;
+    AXUIElementRef element = NULL;
+    AXError error = AXUIElementCopyElementAtPosition(systemWide, position.x, position.y, &element);
+
+    CFRelease(systemWide);
 
-    void **result = (void **)malloc(rowCount * sizeof(void *));
-    if (!result) {
-        CFRelease(rowsValue);
-        *count = 0;
+    if (error != kAXErrorSuccess) {
         return NULL;
     }
 
-    for (CFIndex i = 0; i < rowCount; i++) {
-        AXUIElementRef row = (AXUIElementRef)CFArrayGetValueAtIndex(rows, i);
-        CFRetain(row);
-        result[i] = (void *)row;
+    return (void *)element;
+}
+
+#pragma mark - Child Element Functions
+
+/// Get number of child elements
+/// @param element Element reference
+/// @return Number of children
+int getChildrenCount(void *element) {
+    if (!element)
+        return 0;
+
+    AXUIElementRef axElement = (AXUIElementRef)element;
+    CFTypeRef childrenValue = NULL;
+
+    if (AXUIElementCopyAttributeValue(axElement, kAXChildrenAttribute, &childrenValue) != kAXErrorSuccess) {
+        return 0;
+    }
+
+    if (CFGetTypeID(childrenValue) != CFArrayGetTypeID()) {
+        CFRelease(childrenValue);
+        return 0;
     }
 
-    CFRelease(rowsValue);
-    return result;
+    CFIndex count = CFArrayGetCount((CFArrayRef)childrenValue);
+    CFRelease(childrenValue);
+
+    return (int)count;
 }
 
 #pragma mark - Constants
@@ -486,10 +996,28 @@ static CFStringRef kAXVisibleAttribute = CFSTR("AXVisible");
 /// @param element Element reference
 /// @return 1 if element is clickable, 0 otherwise
 int hasClickAction(void *element) {
+    int action = getClickAction(element);
+    if (action != ClickActionIfVisible)
+        return action == ClickActionPresent ? 1 : 0;
+
+    // Without a window snapshot, hit test the element's center
+    CGPoint center;
+    pid_t pid;
+    if (getElementCenter(element, &center) && AXUIElementGetPid((AXUIElementRef)element, &pid) == kAXErrorSuccess) {
+        return isPointVisible(center, pid) ? 1 : 0;
+    }
+    return 0;
+}
+
+/// Classify how an element qualifies as clickable without testing its visibility
+/// @param element Element reference
+/// @return ClickAction value; callers resolve ClickActionIfVisible against a window snapshot
+int getClickAction(void *element) {
     if (!element)
-        return 0;
+        return ClickActionNone;
 
     AXUIElementRef axElement = (AXUIElementRef)element;
+    applyApplicationTimeout(axElement);
 
     // Ignore hidden or disabled elements early
     CFBooleanRef hidden = NULL;
@@ -497,7 +1025,7 @@ int hasClickAction(void *element) {
         hidden) {
         if (CFBooleanGetValue(hidden)) {
             CFRelease(hidden);
-            return 0;
+            return ClickActionNone;
         }
         CFRelease(hidden);
     }
@@ -510,7 +1038,7 @@ int hasClickAction(void *element) {
         CFRelease(enabled);
     }
     if (!isEnabled)
-        return 0;
+        return ClickActionNone;
 
     // Get role for role-specific fallbacks
     CFStringRef role = NULL;
@@ -532,7 +1060,7 @@ int hasClickAction(void *element) {
                 CFRelease(actions);
                 if (role)
                     CFRelease(role);
-                return 1;
+                return ClickActionPresent;
             }
         }
         CFRelease(actions);
@@ -544,7 +1072,7 @@ int hasClickAction(void *element) {
         CFRelease(pressDesc);
         if (role)
             CFRelease(role);
-        return 1;
+        return ClickActionPresent;
     }
 
     // Focusable and enabled controls are clickable
@@ -553,15 +1081,9 @@ int hasClickAction(void *element) {
         focusable) {
         if (CFBooleanGetValue(focusable)) {
             CFRelease(focusable);
-            CGPoint center;
-            pid_t pid;
-            bool visible = true;
-            if (getElementCenter((void *)axElement, &center) && AXUIElementGetPid(axElement, &pid) == kAXErrorSuccess) {
-                visible = isPointVisible(center, pid);
-            }
             if (role)
                 CFRelease(role);
-            return visible ? 1 : 0;
+            return ClickActionIfVisible;
         }
         CFRelease(focusable);
     }
@@ -572,7 +1094,7 @@ int hasClickAction(void *element) {
         if (AXUIElementCopyAttributeValue(axElement, kAXURLAttribute, &urlAttr) == kAXErrorSuccess && urlAttr) {
             CFRelease(urlAttr);
             CFRelease(role);
-            return 1;
+            return ClickActionPresent;
         }
     }
 
@@ -580,13 +1102,7 @@ int hasClickAction(void *element) {
         CFRelease(role);
 
     // Final check: visible bounding box and not occluded
-    CGPoint center;
-    pid_t pid;
-    if (getElementCenter((void *)axElement, &center) && AXUIElementGetPid(axElement, &pid) == kAXErrorSuccess) {
-        return isPointVisible(center, pid) ? 1 : 0;
-    }
-
-    return 0;
+    return ClickActionIfVisible;
 }
 
 /// Get the center point of an element
@@ -969,6 +1485,73 @@ void releaseElement(void *element) {
     }
 }
 
+/// Release multiple element references
+/// @param elements Array of element references; NULL entries are skipped
+/// @param count Number of element references
+void releaseElements(void **elements, int count) {
+    if (!elements || count <= 0)
+        return;
+
+    for (int i = 0; i < count; i++) {
+        if (elements[i]) {
+            CFRelease((AXUIElementRef)elements[i]);
+        }
+    }
+}
+
+/// Retain element reference
+/// @param element Element reference
+/// @return The same element reference with its retain count incremented
+void *retainElement(void *element) {
+    if (!element)
+        return NULL;
+
+    return (void *)CFRetain((AXUIElementRef)element);
+}
+
+/// Get identities of multiple elements without messaging their applications
+/// @param elements Array of element references
+/// @param count Number of element references
+/// @param outIdentities Caller-provided array of at least count entries, filled in element order
+void getElementIdentities(void **elements, int count, ElementIdentity *outIdentities) {
+    if (!elements || !outIdentities || count <= 0)
+        return;
+
+    for (int i = 0; i < count; i++) {
+        outIdentities[i].hash = 0;
+        outIdentities[i].pid = 0;
+
+        AXUIElementRef axElement = (AXUIElementRef)elements[i];
+        if (!axElement)
+            continue;
+
+        outIdentities[i].hash = (unsigned long)CFHash(axElement);
+
+        pid_t pid;
+        if (AXUIElementGetPid(axElement, &pid) == kAXErrorSuccess) {
+            outIdentities[i].pid = pid;
+        }
+    }
+}
+
+/// Compare element references pairwise for identity
+/// @param first Array of element references
+/// @param second Array of element references compared against first
+/// @param count Number of pairs
+/// @param outEqual Caller-provided array of at least count entries, true where the pair denotes the same element
+void elementsEqualBatch(void **first, void **second, int count, bool *outEqual) {
+    if (!first || !second || !outEqual || count <= 0)
+        return;
+
+    for (int i = 0; i < count; i++) {
+        if (!first[i] || !second[i]) {
+            outEqual[i] = false;
+            continue;
+        }
+        outEqual[i] = first[i] == second[i] || CFEqual((CFTypeRef)first[i], (CFTypeRef)second[i]);
+    }
+}
+
 #pragma mark - Window Functions
 
 /// Get all windows of focused application
@@ -1042,6 +1625,8 @@ void *getFrontmostWindow(void) {
             shouldReleaseAppRef = true;
         }
 
+        applyApplicationTimeout(appRef);
+
         AXUIElementRef window = NULL;
         AXError error = AXUIElementCopyAttributeValue(appRef, kAXFocusedWindowAttribute, (CFTypeRef *)&window);
 
@@ -1194,6 +1779,221 @@ int scrollAtCursor(int deltaX, int deltaY) {
     return 0;
 }
 
+#pragma mark - Observer Functions
+
+typedef struct {
+    AXObserverRef observer;           ///< Accessibility observer
+    AXUIElementRef application;       ///< Observed application element
+    CFRunLoopSourceRef runLoopSource; ///< Run loop source of the observer
+    ElementObserverCallback callback; ///< Callback function
+    void *userData;                   ///< User data pointer
+} ElementObserverContext;
+
+/// Notifications registered on the application element, in the order they are added
+static CFStringRef const kObservedNotifications[] = {
+    kAXUIElementCreatedNotification, kAXUIElementDestroyedNotification, kAXMovedNotification,
+    kAXWindowMovedNotification,      kAXResizedNotification,            kAXWindowResizedNotification,
+    kAXValueChangedNotification,     kAXFocusedWindowChangedNotification,
+};
+
+/// Map a notification name to the event kind reported to the callback
+/// @param notification Notification name
+/// @return Event kind, or -1 for notifications that are not forwarded
+static int elementEventKindForNotification(CFStringRef notification) {
+    if (CFEqual(notification, kAXUIElementCreatedNotification))
+        return ElementEventCreated;
+    if (CFEqual(notification, kAXUIElementDestroyedNotification))
+        return ElementEventDestroyed;
+    if (CFEqual(notification, kAXMovedNotification) || CFEqual(notification, kAXWindowMovedNotification))
+        return ElementEventMoved;
+    if (CFEqual(notification, kAXResizedNotification) || CFEqual(notification, kAXWindowResizedNotification))
+        return ElementEventResized;
+    if (CFEqual(notification, kAXValueChangedNotification))
+        return ElementEventValueChanged;
+    if (CFEqual(notification, kAXFocusedWindowChangedNotification))
+        return ElementEventFocusedWindowChanged;
+    return -1;
+}
+
+#define kMaxPendingParentLookups 64
+
+/// Parent lookups queued on the element event queue and not yet answered
+static atomic_int pendingParentLookups = 0;
+
+/// Serial queue delivering observer notifications off the main run loop, in arrival order
+/// @return Element event queue
+static dispatch_queue_t elementEventQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.neru.element-events", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+/// Build the identity of an element without retaining it
+/// @param element Element reference
+/// @return Element identity, zeroed if element is NULL
+static ElementIdentity identityOfElement(AXUIElementRef element) {
+    ElementIdentity identity = {0, 0};
+    if (!element)
+        return identity;
+
+    identity.hash = (unsigned long)CFHash(element);
+    pid_t pid;
+    if (AXUIElementGetPid(element, &pid) == kAXErrorSuccess) {
+        identity.pid = pid;
+    }
+    return identity;
+}
+
+/// Accessibility observer callback
+/// @param observer Observer reference
+/// @param element Element the notification refers to
+/// @param notification Notification name
+/// @param refcon Observer context
+static void elementObserverCallback(AXObserverRef observer, AXUIElementRef element, CFStringRef notification,
+                                    void *refcon) {
+    ElementObserverContext *context = (ElementObserverContext *)refcon;
+    if (!context || !context->callback)
+        return;
+
+    int kind = elementEventKindForNotification(notification);
+    if (kind < 0)
+        return;
+
+    // The block outlives the context if the observer is destroyed while events are queued
+    ElementObserverCallback callback = context->callback;
+    void *userData = context->userData;
+    ElementIdentity identity = identityOfElement(element);
+    ElementIdentity parent = {0, 0};
+
+    if (kind != ElementEventCreated) {
+        dispatch_async(elementEventQueue(), ^{
+            callback(kind, identity, parent, userData);
+        });
+        return;
+    }
+
+    // The created element is not part of any recorded tree yet; its parent is. Looking the
+    // parent up is an IPC round-trip, so it runs on the event queue rather than the main run
+    // loop. During a creation storm the parent is left unknown, which invalidates the
+    // application's trees once instead of queueing a lookup per element.
+    if (atomic_fetch_add(&pendingParentLookups, 1) >= kMaxPendingParentLookups) {
+        atomic_fetch_sub(&pendingParentLookups, 1);
+        dispatch_async(elementEventQueue(), ^{
+            callback(kind, identity, parent, userData);
+        });
+        return;
+    }
+
+    CFRetain(element);
+    dispatch_async(elementEventQueue(), ^{
+        ElementIdentity createdParent = {0, 0};
+        CFTypeRef parentRef = NULL;
+        if (AXUIElementCopyAttributeValue(element, kAXParentAttribute, &parentRef) == kAXErrorSuccess && parentRef) {
+            createdParent = identityOfElement((AXUIElementRef)parentRef);
+            CFRelease(parentRef);
+        }
+        CFRelease(element);
+        atomic_fetch_sub(&pendingParentLookups, 1);
+
+        callback(kind, identity, createdParent, userData);
+    });
+}
+
+/// Create an observer delivering the tree-affecting notifications of an application
+/// @param pid Process identifier of the application
+/// @param callback Callback function
+/// @param userData User data pointer
+/// @return Observer handle, or NULL if the application cannot be observed
+ElementObserver createElementObserver(int pid, ElementObserverCallback callback, void *userData) {
+    if (pid <= 0 || !callback)
+        return NULL;
+
+    ElementObserverContext *context = (ElementObserverContext *)calloc(1, sizeof(ElementObserverContext));
+    if (!context)
+        return NULL;
+
+    context->callback = callback;
+    context->userData = userData;
+
+    if (AXObserverCreate(pid, elementObserverCallback, &context->observer) != kAXErrorSuccess) {
+        free(context);
+        return NULL;
+    }
+
+    context->application = AXUIElementCreateApplication(pid);
+    if (!context->application) {
+        CFRelease(context->observer);
+        free(context);
+        return NULL;
+    }
+
+    int registered = 0;
+    size_t notificationCount = sizeof(kObservedNotifications) / sizeof(kObservedNotifications[0]);
+    for (size_t i = 0; i < notificationCount; i++) {
+        AXError error =
+            AXObserverAddNotification(context->observer, context->application, kObservedNotifications[i], context);
+        if (error == kAXErrorSuccess || error == kAXErrorNotificationAlreadyRegistered) {
+            registered++;
+        }
+    }
+
+    // Without notifications the caller cannot trust incremental state
+    if (registered == 0) {
+        CFRelease(context->application);
+        CFRelease(context->observer);
+        free(context);
+        return NULL;
+    }
+
+    context->runLoopSource = AXObserverGetRunLoopSource(context->observer);
+    CFRetain(context->runLoopSource);
+
+    if ([NSThread isMainThread]) {
+        CFRunLoopAddSource(CFRunLoopGetMain(), context->runLoopSource, kCFRunLoopCommonModes);
+    } else {
+        CFRunLoopSourceRef source = context->runLoopSource;
+        CFRetain(source);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            CFRunLoopAddSource(CFRunLoopGetMain(), source, kCFRunLoopCommonModes);
+            CFRelease(source);
+        });
+    }
+
+    return (ElementObserver)context;
+}
+
+/// Destroy an element observer
+/// @param observer Observer handle
+void destroyElementObserver(ElementObserver observer) {
+    if (!observer)
+        return;
+
+    ElementObserverContext *context = (ElementObserverContext *)observer;
+
+    size_t notificationCount = sizeof(kObservedNotifications) / sizeof(kObservedNotifications[0]);
+    for (size_t i = 0; i < notificationCount; i++) {
+        AXObserverRemoveNotification(context->observer, context->application, kObservedNotifications[i]);
+    }
+
+    // Tear down on the main run loop so no callback can observe a freed context
+    void (^teardown)(void) = ^{
+        CFRunLoopRemoveSource(CFRunLoopGetMain(), context->runLoopSource, kCFRunLoopCommonModes);
+        CFRelease(context->runLoopSource);
+        CFRelease(context->application);
+        CFRelease(context->observer);
+        free(context);
+    };
+
+    if ([NSThread isMainThread]) {
+        teardown();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), teardown);
+    }
+}
+
 #pragma mark - Screen Functions
 
 /// Try to detect if Mission Control is active
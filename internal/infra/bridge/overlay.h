@@ -98,6 +98,12 @@ void NeruClearOverlay(OverlayWindow window);
 /// @param style Hint style
 void NeruDrawHints(OverlayWindow window, HintData *hints, int count, HintStyle style);
 
+/// Update the match state of drawn hints in place
+/// @param window Overlay window handle
+/// @param hints Array of hint data; a negative matched prefix length hides the hint
+/// @param count Number of hints
+void NeruUpdateHintMatches(OverlayWindow window, HintData *hints, int count);
+
 /// Draw scroll highlight
 /// @param window Overlay window handle
 /// @param bounds Highlight bounds
@@ -12,6 +12,7 @@
 
 @interface OverlayView : NSView
 @property(nonatomic, strong) NSMutableArray *hints;                                   ///< Hints array
+@property(nonatomic, strong) NSMutableDictionary *hintIndexes;                        ///< Hint index by label
 @property(nonatomic, strong) NSFont *hintFont;                                        ///< Hint font
 @property(nonatomic, strong) NSColor *hintTextColor;                                  ///< Hint text color
 @property(nonatomic, strong) NSColor *hintMatchedTextColor;                           ///< Hint matched text color
@@ -44,6 +45,7 @@
 @property(nonatomic, assign) CGFloat gridTextOpacity;                                 ///< Grid text opacity
 @property(nonatomic, assign) BOOL hideUnmatched;                                      ///< Hide unmatched cells
 - (void)applyStyle:(HintStyle)style;                                                  ///< Apply hint style
+- (void)indexHints;                                                                   ///< Index hints by label
 - (NSColor *)colorFromHex:(NSString *)hexString defaultColor:(NSColor *)defaultColor; ///< Color from hex string
 @end
 
@@ -58,6 +60,7 @@
     self = [super initWithFrame:frame];
     if (self) {
         _hints = [NSMutableArray arrayWithCapacity:100];     // Pre-size for typical hint count
+        _hintIndexes = [[NSMutableDictionary alloc] initWithCapacity:100];
         _gridCells = [NSMutableArray arrayWithCapacity:100]; // Pre-size for typical grid size
         _gridLines = [NSMutableArray arrayWithCapacity:50];  // Pre-size for typical line count
         _showScrollHighlight = NO;
@@ -283,11 +286,19 @@
     return path;
 }
 
+/// Index hints by label, so match updates find them without a search
+- (void)indexHints {
+    [self.hintIndexes removeAllObjects];
+    [self.hints enumerateObjectsUsingBlock:^(NSDictionary *hint, NSUInteger index, BOOL *stop) {
+        self.hintIndexes[hint[@"label"]] = @(index);
+    }];
+}
+
 /// Draw hints
 - (void)drawHints {
     for (NSDictionary *hint in self.hints) {
         NSString *label = hint[@"label"];
-        if (!label || [label length] == 0)
+        if (!label || [label length] == 0 || [hint[@"hidden"] boolValue])
             continue;
 
         NSPoint position = [hint[@"position"] pointValue];
@@ -713,6 +724,7 @@ void NeruClearOverlay(OverlayWindow window) {
 
     if ([NSThread isMainThread]) {
         [controller.overlayView.hints removeAllObjects];
+        [controller.overlayView.hintIndexes removeAllObjects];
         [controller.overlayView.gridCells removeAllObjects];
         [controller.overlayView.gridLines removeAllObjects];
         controller.overlayView.showScrollHighlight = NO;
@@ -721,6 +733,7 @@ void NeruClearOverlay(OverlayWindow window) {
     } else {
         dispatch_async(dispatch_get_main_queue(), ^{
             [controller.overlayView.hints removeAllObjects];
+            [controller.overlayView.hintIndexes removeAllObjects];
             [controller.overlayView.gridCells removeAllObjects];
             [controller.overlayView.gridLines removeAllObjects];
             controller.overlayView.showScrollHighlight = NO;
@@ -883,6 +896,7 @@ void NeruDrawHints(OverlayWindow window, HintData *hints, int count, HintStyle s
             };
             [controller.overlayView.hints addObject:hintDict];
         }
+        [controller.overlayView indexHints];
 
         [controller.overlayView setNeedsDisplay:YES];
     } else {
@@ -915,6 +929,7 @@ void NeruDrawHints(OverlayWindow window, HintData *hints, int count, HintStyle s
             [controller.overlayView.hints removeAllObjects];
             [controller.overlayView applyStyle:styleCopy];
             [controller.overlayView.hints addObjectsFromArray:hintDicts];
+            [controller.overlayView indexHints];
             [controller.overlayView setNeedsDisplay:YES];
 
             free_hint_style_strings(&styleCopy);
@@ -922,6 +937,48 @@ void NeruDrawHints(OverlayWindow window, HintData *hints, int count, HintStyle s
     }
 }
 
+/// Update the match state of drawn hints in place
+/// @param window Overlay window handle
+/// @param hints Array of hint data; a negative matched prefix length hides the hint
+/// @param count Number of hints
+void NeruUpdateHintMatches(OverlayWindow window, HintData *hints, int count) {
+    if (!window || !hints)
+        return;
+
+    OverlayWindowController *controller = (OverlayWindowController *)window;
+
+    // Labels are copied, the caller frees them once this returns
+    NSMutableArray *labels = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray *lengths = [NSMutableArray arrayWithCapacity:count];
+    for (int i = 0; i < count; i++) {
+        [labels addObject:@(hints[i].label)];
+        [lengths addObject:@(hints[i].matchedPrefixLength)];
+    }
+
+    void (^update)(void) = ^{
+        OverlayView *view = controller.overlayView;
+        for (NSUInteger i = 0; i < [labels count]; i++) {
+            NSNumber *index = view.hintIndexes[labels[i]];
+            if (!index)
+                continue;
+
+            NSMutableDictionary *hint = [[view.hints[[index unsignedIntegerValue]] mutableCopy] autorelease];
+            int length = [lengths[i] intValue];
+            hint[@"hidden"] = @(length < 0);
+            if (length >= 0)
+                hint[@"matchedPrefixLength"] = @(length);
+            view.hints[[index unsignedIntegerValue]] = hint;
+        }
+        [view setNeedsDisplay:YES];
+    };
+
+    if ([NSThread isMainThread]) {
+        update();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), update);
+    }
+}
+
 /// Draw scroll highlight
 /// @param window Overlay window handle
 /// @param bounds Highlight bounds
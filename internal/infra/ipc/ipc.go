@@ -24,6 +24,10 @@ const (
 
 	// ConnectionTimeout is the timeout for establishing a connection.
 	ConnectionTimeout = 2 * time.Second
+
+	// HintsRefreshArg asks the hints command to rescan the whole frontmost window,
+	// ignoring learned subtree pruning and tracked trees.
+	HintsRefreshArg = "--refresh"
 )
 
 // Standard response codes used to indicate the result of IPC operations.
@@ -54,9 +58,42 @@ type Response struct {
 
 // StatusData represents the payload structure for status query responses.
 type StatusData struct {
-	Enabled bool   `json:"enabled"`
-	Mode    string `json:"mode"`
-	Config  string `json:"config"`
+	Enabled   bool             `json:"enabled"`
+	Mode      string           `json:"mode"`
+	Config    string           `json:"config"`
+	InfoCache *InfoCacheStatus `json:"info_cache,omitempty"`
+	Apps      []AppStatus      `json:"apps,omitempty"`
+}
+
+// InfoCacheStatus reports the effectiveness of the element info cache.
+type InfoCacheStatus struct {
+	Hits    uint64  `json:"hits"`
+	Misses  uint64  `json:"misses"`
+	HitRate float64 `json:"hit_rate"`
+	Entries int     `json:"entries"`
+}
+
+// AppStatus reports the measured accessibility latency of one application and the traversal
+// settings chosen from it. Latencies are in microseconds; a max depth of 0 means unlimited.
+// A non-zero quarantine is the time, in seconds, the app is still scanned shallowly; capped
+// walks stopped at the max depth, so elements below it got no hints.
+type AppStatus struct {
+	PID         int    `json:"pid"`
+	BundleID    string `json:"bundle_id,omitempty"`
+	Calls       uint64 `json:"calls"`
+	EWMAUs      int64  `json:"ewma_us"`
+	P50Us       int64  `json:"p50_us"`
+	P90Us       int64  `json:"p90_us"`
+	P99Us       int64  `json:"p99_us"`
+	LastNodes   int64  `json:"last_nodes"`
+	LastDepth   int    `json:"last_depth"`
+	Workers     int    `json:"workers"`
+	InFlight    int    `json:"in_flight"`
+	MaxDepth    int    `json:"max_depth"`
+	TimeoutMs   int64  `json:"timeout_ms"`
+	Timeouts    uint64 `json:"timeouts"`
+	QuarantineS int64  `json:"quarantine_s,omitempty"`
+	CappedWalks uint64 `json:"capped_walks,omitempty"`
 }
 
 // Server handles incoming IPC connections and routes commands to handlers.
@@ -0,0 +1,42 @@
+package persist
+
+import (
+	"cmp"
+	"slices"
+)
+
+// Expire drops the entries whose stamp, the Unix time they were last used, is at or before
+// cutoff.
+func Expire[K comparable, V any](entries map[K]V, cutoff int64, stamp func(V) int64) {
+	for key, value := range entries {
+		if stamp(value) <= cutoff {
+			delete(entries, key)
+		}
+	}
+}
+
+// Trim drops the least recently used entries until at most limit remain. Entries used at
+// the same time as the newest dropped one are dropped in no particular order, so exactly
+// limit remain.
+func Trim[K comparable, V any](entries map[K]V, limit int, stamp func(V) int64) {
+	excess := len(entries) - max(limit, 0)
+	if excess <= 0 {
+		return
+	}
+
+	type stamped struct {
+		key   K
+		stamp int64
+	}
+	order := make([]stamped, 0, len(entries))
+	for key, value := range entries {
+		order = append(order, stamped{key: key, stamp: stamp(value)})
+	}
+	slices.SortFunc(order, func(first, second stamped) int {
+		return cmp.Compare(first.stamp, second.stamp)
+	})
+
+	for _, oldest := range order[:excess] {
+		delete(entries, oldest.key)
+	}
+}
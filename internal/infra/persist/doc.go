@@ -0,0 +1,11 @@
+// Package persist holds the small building blocks shared by the stores that remember what
+// Neru learned about applications between restarts.
+//
+// Key Features:
+//   - Atomic Files: JSON files are written next to their destination and renamed over it, so
+//     a crash never leaves a partial file behind
+//   - Bounded Maps: Entries stamped with the time they were last used expire after a while
+//     and are trimmed to a fixed number, least recently used first
+//
+// The package has no platform dependencies.
+package persist
@@ -0,0 +1,72 @@
+package persist
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+)
+
+// ReadJSON decodes the file at path into value. It reports false, leaving value untouched,
+// when the file does not exist.
+func ReadJSON(path string, value any) (bool, error) {
+	// #nosec G304 -- Path is controlled by the application
+	data, err := os.ReadFile(path)
+	if errors.Is(err, os.ErrNotExist) {
+		return false, nil
+	}
+	if err != nil {
+		return false, fmt.Errorf("failed to read file: %w", err)
+	}
+
+	err = json.Unmarshal(data, value)
+	if err != nil {
+		return false, fmt.Errorf("failed to parse file: %w", err)
+	}
+	return true, nil
+}
+
+// WriteJSON encodes value and replaces the file at path with it atomically.
+func WriteJSON(path string, value any) error {
+	data, err := json.Marshal(value)
+	if err != nil {
+		return fmt.Errorf("failed to encode file: %w", err)
+	}
+	return WriteFile(path, data)
+}
+
+// WriteFile replaces the file at path with data atomically, creating its directory. Readers
+// see either the previous file or the new one. Each write goes through a temporary file of
+// its own, so concurrent writers never interleave; the last rename wins.
+func WriteFile(path string, data []byte) error {
+	dir := filepath.Dir(path)
+	err := os.MkdirAll(dir, 0o750)
+	if err != nil {
+		return fmt.Errorf("failed to create directory: %w", err)
+	}
+
+	temporary, err := os.CreateTemp(dir, filepath.Base(path)+".*.tmp")
+	if err != nil {
+		return fmt.Errorf("failed to create temporary file: %w", err)
+	}
+	defer func() {
+		// Gone after a successful rename; only a failed write leaves it behind
+		_ = os.Remove(temporary.Name())
+	}()
+
+	_, err = temporary.Write(data)
+	closeErr := temporary.Close()
+	if err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		return fmt.Errorf("failed to write file: %w", err)
+	}
+
+	err = os.Rename(temporary.Name(), path)
+	if err != nil {
+		return fmt.Errorf("failed to replace file: %w", err)
+	}
+	return nil
+}
@@ -0,0 +1,126 @@
+package persist_test
+
+import (
+	"maps"
+	"os"
+	"path/filepath"
+	"sync"
+	"testing"
+
+	"github.com/y3owk1n/neru/internal/infra/persist"
+)
+
+// seen returns the stamp of a test entry.
+func seen(value int64) int64 { return value }
+
+func TestTrimKeepsExactlyTheLimit(t *testing.T) {
+	tests := []struct {
+		name    string
+		entries map[string]int64
+		limit   int
+		want    []string
+	}{
+		{
+			name:    "under the limit",
+			entries: map[string]int64{"a": 1, "b": 2},
+			limit:   3,
+			want:    []string{"a", "b"},
+		},
+		{
+			name:    "oldest dropped first",
+			entries: map[string]int64{"a": 3, "b": 1, "c": 2},
+			limit:   2,
+			want:    []string{"a", "c"},
+		},
+		{
+			name:    "ties at the cutoff",
+			entries: map[string]int64{"a": 5, "b": 5, "c": 5, "d": 5, "e": 9},
+			limit:   2,
+			want:    []string{"e"},
+		},
+		{
+			name:    "all tied",
+			entries: map[string]int64{"a": 1, "b": 1, "c": 1},
+			limit:   1,
+		},
+	}
+
+	for _, test := range tests {
+		t.Run(test.name, func(t *testing.T) {
+			entries := maps.Clone(test.entries)
+			persist.Trim(entries, test.limit, seen)
+
+			if want := min(len(test.entries), test.limit); len(entries) != want {
+				t.Fatalf("Trim() left %d entries, want %d", len(entries), want)
+			}
+			for _, key := range test.want {
+				if _, ok := entries[key]; !ok {
+					t.Errorf("Trim() dropped %q, one of the most recent", key)
+				}
+			}
+		})
+	}
+}
+
+func TestExpire(t *testing.T) {
+	entries := map[string]int64{"old": 10, "cutoff": 20, "new": 30}
+	persist.Expire(entries, 20, seen)
+
+	if !maps.Equal(entries, map[string]int64{"new": 30}) {
+		t.Errorf("Expire() left %v, want only new", entries)
+	}
+}
+
+func TestJSONRoundTrip(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "nested", "store.json")
+
+	var missing map[string]int
+	found, err := persist.ReadJSON(path, &missing)
+	if err != nil || found {
+		t.Fatalf("ReadJSON(missing) = %v, %v; want false, nil", found, err)
+	}
+
+	written := map[string]int{"a": 1, "b": 2}
+	err = persist.WriteJSON(path, written)
+	if err != nil {
+		t.Fatalf("WriteJSON() error = %v", err)
+	}
+
+	var read map[string]int
+	found, err = persist.ReadJSON(path, &read)
+	if err != nil || !found || !maps.Equal(read, written) {
+		t.Errorf("ReadJSON() = %v, %v, %v; want %v", read, found, err, written)
+	}
+}
+
+func TestConcurrentWritesStayWhole(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "store.json")
+
+	var wg sync.WaitGroup
+	for writer := range 8 {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for round := range 20 {
+				err := persist.WriteJSON(path, map[string]int{"writer": writer, "round": round})
+				if err != nil {
+					t.Errorf("WriteJSON() error = %v", err)
+					return
+				}
+			}
+		}()
+	}
+	wg.Wait()
+
+	var read map[string]int
+	found, err := persist.ReadJSON(path, &read)
+	if err != nil || !found || len(read) != 2 {
+		t.Errorf("ReadJSON() = %v, %v, %v; want one writer's whole file", read, found, err)
+	}
+
+	entries, err := os.ReadDir(dir)
+	if err != nil || len(entries) != 1 {
+		t.Errorf("directory holds %d entries (%v), want only the file", len(entries), err)
+	}
+}